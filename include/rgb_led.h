@@ -74,8 +74,9 @@
  * @param[out] r Red component (0-255)
  * @param[out] g Green component (0-255)
  * @param[out] b Blue component (0-255)
+ * @note Kept for ad-hoc colors; patterns in lib/led use precomputed tables
  */
-void hsv_to_rgb(uint16_t h, uint8_t s, uint8_t v, uint8_t *r, uint8_t *g, uint8_t *b) {
+static inline void hsv_to_rgb(uint16_t h, uint8_t s, uint8_t v, uint8_t *r, uint8_t *g, uint8_t *b) {
   uint8_t region, remainder, p, q, t;
 
   region = h / 60;                  // 0 to 5
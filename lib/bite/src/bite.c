@@ -0,0 +1,89 @@
+/**
+ * @file bite.c
+ * @brief B.I.T.E. power-on self-test runner implementation
+ * @author Nate Hunter
+ * @date 2025-08-01
+ * @version v1.0.0
+ */
+
+#include "bite.h"
+#include "time.h"
+#include "fmt.h"
+#include <avr/pgmspace.h>
+#include <string.h>
+
+static const char biteResult0[] PROGMEM = "PASS";
+static const char biteResult1[] PROGMEM = "FAIL";
+static const char biteResult2[] PROGMEM = "SLOW";
+static const char biteResult3[] PROGMEM = "SKIP";
+
+static const char *const biteResultNames[] PROGMEM = {
+  biteResult0, biteResult1, biteResult2, biteResult3
+};
+
+uint8_t BITE_Expired(uint32_t deadlineUs)
+{
+  return (int32_t)(TIM_GetMicros() - deadlineUs) >= 0;
+}
+
+uint8_t BITE_Run(const BITE_Test *tests, uint8_t count, BITE_Report *report)
+{
+  BITE_Test t;
+  uint32_t postStart = TIM_GetMicros();
+
+  memset(report, 0, sizeof(*report));
+  if (count > BITE_MAX_TESTS)
+    count = BITE_MAX_TESTS;
+
+  for (uint8_t i = 0; i < count; i++) {
+    memcpy_P(&t, &tests[i], sizeof(t));
+
+    uint32_t start = TIM_GetMicros();
+    uint8_t res = t.fn(start + (uint32_t)t.budgetMs * 1000UL);
+    uint32_t ms = (TIM_GetMicros() - start) / 1000UL;
+
+    if (res == BITE_PASS && ms > t.budgetMs)
+      res = BITE_SLOW;
+    report->result[i] = res;
+    report->durationMs[i] = ms > 0xFFFF ? 0xFFFF : (uint16_t)ms;
+
+    if (res == BITE_FAIL || res == BITE_SLOW) {
+      // A fatal failure outranks any earlier non-fatal one
+      if (!report->code || (t.fatal && res == BITE_FAIL && !report->fatal))
+        report->code = t.code;
+      if (t.fatal && res == BITE_FAIL)
+        report->fatal = 1;
+    }
+  }
+
+  report->count = count;
+  report->totalMs = (uint16_t)((TIM_GetMicros() - postStart) / 1000UL);
+  return report->code;
+}
+
+uint8_t BITE_FormatTest(const BITE_Test *tests, const BITE_Report *report, uint8_t i, char *buf)
+{
+  const char *name = (const char *)pgm_read_word(&tests[i].name);
+  uint8_t res = report->result[i] & 0x03;
+
+  char *p = FMT_StrP(buf, PSTR("POST:\t"));
+  p = FMT_StrP(p, name);
+  *p++ = '\t';
+  p = FMT_StrP(p, (const char *)pgm_read_word(&biteResultNames[res]));
+  *p++ = '\t';
+  p = FMT_UInt(p, report->durationMs[i]);
+  p = FMT_StrP(p, PSTR("ms"));
+  return (uint8_t)(FMT_End(p) - buf);
+}
+
+uint8_t BITE_FormatSummary(const BITE_Report *report, char *buf)
+{
+  char *p = FMT_StrP(buf, PSTR("POST:\tcode\t"));
+  p = FMT_UInt(p, report->code);
+  if (report->fatal)
+    p = FMT_StrP(p, PSTR("\tFATAL"));
+  *p++ = '\t';
+  p = FMT_UInt(p, report->totalMs);
+  p = FMT_StrP(p, PSTR("ms"));
+  return (uint8_t)(FMT_End(p) - buf);
+}
@@ -0,0 +1,95 @@
+/**
+ * @file bite.h
+ * @brief B.I.T.E. power-on self-test runner with per-test time budgets
+ * @author Nate Hunter
+ * @date 2025-08-01
+ * @version v1.0.0
+ *
+ * The application supplies a PROGMEM table of tests. Each test gets an
+ * absolute deadline derived from its budget and should give up when it
+ * passes it; a test that returns PASS but overran its budget is reported
+ * as SLOW. The first failing test defines the POST code shown on the LED
+ * and buzzer (see README).
+ */
+
+#ifndef BITE_H
+#define BITE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef BITE_MAX_TESTS
+#define BITE_MAX_TESTS  8    ///< Size of the result arrays in BITE_Report
+#endif
+
+/** @brief Test outcome */
+typedef enum {
+  BITE_PASS = 0,   ///< Test passed within budget
+  BITE_FAIL,       ///< Test failed
+  BITE_SLOW,       ///< Passed, but took longer than its budget
+  BITE_SKIP        ///< Not applicable (hardware absent, dependency failed)
+} BITE_Result;
+
+/**
+ * @brief Test body
+ * @param deadlineUs Absolute TIM_GetMicros() deadline
+ * @return BITE_Result
+ */
+typedef uint8_t (*BITE_TestFn)(uint32_t deadlineUs);
+
+/**
+ * @brief Test table entry (stored in PROGMEM)
+ */
+typedef struct {
+  BITE_TestFn fn;      /**< Test body */
+  const char *name;    /**< PROGMEM name for the log */
+  uint16_t budgetMs;   /**< Time budget (ms) */
+  uint8_t code;        /**< POST code reported on failure (1-15) */
+  uint8_t fatal;       /**< 1 = flight is not possible on failure */
+} BITE_Test;
+
+/**
+ * @brief POST outcome (also the binary log record, 29 bytes)
+ */
+typedef struct {
+  uint8_t code;                       /**< 0 = OK, else code of the first failure */
+  uint8_t fatal;                      /**< 1 if a fatal test failed */
+  uint8_t count;                      /**< Tests run */
+  uint16_t totalMs;                   /**< Whole POST duration (ms) */
+  uint8_t result[BITE_MAX_TESTS];     /**< BITE_Result per test */
+  uint16_t durationMs[BITE_MAX_TESTS];/**< Duration per test (ms) */
+} BITE_Report;
+
+/**
+ * @brief Run every test in order
+ * @param tests PROGMEM test table
+ * @param count Number of tests (<= BITE_MAX_TESTS)
+ * @param report Filled with the results
+ * @return report->code
+ */
+uint8_t BITE_Run(const BITE_Test *tests, uint8_t count, BITE_Report *report);
+
+/** @brief 1 if the deadline has passed */
+uint8_t BITE_Expired(uint32_t deadlineUs);
+
+/**
+ * @brief Format one test result as a text line
+ *        "POST:\t<name>\t<PASS|FAIL|SLOW|SKIP>\t<ms>ms"
+ * @return Line length
+ */
+uint8_t BITE_FormatTest(const BITE_Test *tests, const BITE_Report *report, uint8_t i, char *buf);
+
+/**
+ * @brief Format the summary line "POST:\tcode\t<code>\t<total>ms"
+ * @return Line length
+ */
+uint8_t BITE_FormatSummary(const BITE_Report *report, char *buf);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BITE_H */
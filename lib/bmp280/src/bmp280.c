@@ -1,9 +1,10 @@
 #include "bmp280.h"
 #include "twi.h"
+#include "prof.h"
 #include <math.h>
 
 /** Private function prototypes */
-inline void BMP280_ReadCalib(BMP280_HandleTypeDef *bmp);
+inline BMP280_Status BMP280_ReadCalib(BMP280_HandleTypeDef *bmp);
 inline void BMP280_Compensate(BMP280_HandleTypeDef *bmp, int32_t adc_T, int32_t adc_P);
 
 /**
@@ -18,39 +19,77 @@ BMP280_Status BMP280_Init(BMP280_HandleTypeDef *bmp) {
     return BMP280_ERROR;
 
   // Read manufacturer calibration data
-  BMP280_ReadCalib(bmp);
+  if (BMP280_ReadCalib(bmp) != BMP280_OK)
+    return BMP280_ERROR;
 
   // Configure the sensor using stored configuration
+  return BMP280_SetConfig(bmp, &bmp->config);
+}
+
+/**
+ * @brief Applies a new mode/oversampling/filter configuration.
+ * @param bmp Pointer to BMP280 structure.
+ * @param config New configuration (copied into the handle).
+ * @return BMP280_Status
+ */
+BMP280_Status BMP280_SetConfig(BMP280_HandleTypeDef *bmp, const BMP280_Config *config) {
+  bmp->config = *config;
+
   uint8_t ctrl_meas = (bmp->config.mode << 5) | (bmp->config.oversampling << 2) | 0x03;
-  uint8_t config = (bmp->config.filter << 2) | 0x00;
+  uint8_t cfg = (bmp->config.filter << 2) | 0x00;
 
-  IIC_WriteByte(bmp->i2c.adr, BMP280_REG_CTRL_MEAS, ctrl_meas);
-  IIC_WriteByte(bmp->i2c.adr, BMP280_REG_CONFIG, config);
+  if (IIC_WriteByte(bmp->i2c.adr, BMP280_REG_CTRL_MEAS, ctrl_meas) != IIC_SUCCESS ||
+      IIC_WriteByte(bmp->i2c.adr, BMP280_REG_CONFIG, cfg) != IIC_SUCCESS)
+    return BMP280_ERROR;
 
   return BMP280_OK;
 }
 
 /**
- * @brief Reads and compensates the pressure and temperature data.
+ * @brief Reads and compensates pressure and temperature without the altitude
+ *        conversion (no pow()), e.g. while waiting for the IIR filter to settle.
  * @param bmp Pointer to BMP280 structure.
+ * @return BMP280_Status; pressure/temperature are unchanged on error
  */
-void BMP280_ReadData(BMP280_HandleTypeDef *bmp) {
+BMP280_Status BMP280_ReadPressure(BMP280_HandleTypeDef *bmp) {
   uint8_t rx[6];
-  IIC_ReadBytes(bmp->i2c.adr, BMP280_REG_PRESS_MSB, rx, 6);
+  if (IIC_ReadBytes(bmp->i2c.adr, BMP280_REG_PRESS_MSB, rx, 6) != IIC_SUCCESS)
+    return BMP280_ERROR;
   int32_t adc_P = (int32_t)rx[0] << 12 | (int32_t)rx[1] << 4 | (int32_t)rx[2] >> 4;
   int32_t adc_T = (int32_t)rx[3] << 12 | (int32_t)rx[4] << 4 | (int32_t)rx[5] >> 4;
 
+  PROF_BEGIN(PROF_BMP_COMPENSATE);
   BMP280_Compensate(bmp, adc_T, adc_P);
+  PROF_END(PROF_BMP_COMPENSATE);
+  return BMP280_OK;
+}
+
+/**
+ * @brief Reads and compensates the pressure and temperature data.
+ * @param bmp Pointer to BMP280 structure.
+ * @return BMP280_Status; all readings are unchanged on error
+ */
+BMP280_Status BMP280_ReadData(BMP280_HandleTypeDef *bmp) {
+  if (BMP280_ReadPressure(bmp) != BMP280_OK)
+    return BMP280_ERROR;
+  if (!bmp->zeroLvlPress) {
+    bmp->altitude = 0;   // No reference yet
+    return BMP280_OK;
+  }
   bmp->altitude = (int32_t)(4433000 * (1.0f - pow((float)bmp->pressure / bmp->zeroLvlPress, 0.1903f)) + 
                     ((float)bmp->temperature / 100.0f) * 0.0065f);
+  return BMP280_OK;
 }
 
 /**
  * @brief Reads calibration data from BMP280.
  * @param bmp Pointer to BMP280 structure.
+ * @return BMP280_Status
  */
-void BMP280_ReadCalib(BMP280_HandleTypeDef *bmp) {
-  IIC_ReadBytes(bmp->i2c.adr, BMP280_REG_CALIB, (uint8_t *)&(bmp->calib), 24);
+BMP280_Status BMP280_ReadCalib(BMP280_HandleTypeDef *bmp) {
+  if (IIC_ReadBytes(bmp->i2c.adr, BMP280_REG_CALIB, (uint8_t *)&(bmp->calib), 24) != IIC_SUCCESS)
+    return BMP280_ERROR;
+  return BMP280_OK;
 }
 
 /**
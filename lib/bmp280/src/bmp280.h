@@ -107,7 +107,9 @@ extern "C" {
 
   /** Function prototypes */
   BMP280_Status BMP280_Init(BMP280_HandleTypeDef *bmp);
-  void BMP280_ReadData(BMP280_HandleTypeDef *bmp);
+  BMP280_Status BMP280_ReadData(BMP280_HandleTypeDef *bmp);
+  BMP280_Status BMP280_ReadPressure(BMP280_HandleTypeDef *bmp);
+  BMP280_Status BMP280_SetConfig(BMP280_HandleTypeDef *bmp, const BMP280_Config *config);
 
 #ifdef __cplusplus
 }
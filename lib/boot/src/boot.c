@@ -0,0 +1,71 @@
+/**
+ * @file boot.c
+ * @brief Overlapped boot pipeline implementation
+ * @author Nate Hunter
+ * @date 2025-08-03
+ * @version v1.0.0
+ */
+
+#include "boot.h"
+#include "time.h"
+#include "fmt.h"
+#include <avr/pgmspace.h>
+#include <string.h>
+
+void BOOT_Run(const BOOT_Step *steps, uint8_t count, BOOT_Report *report)
+{
+  uint32_t start = TIM_GetMillis();
+  uint8_t pending;
+
+  memset(report, 0, sizeof(*report));
+  if (count > BOOT_MAX_STEPS)
+    count = BOOT_MAX_STEPS;
+  pending = (uint8_t)((1 << count) - 1);
+
+  while (pending) {
+    for (uint8_t i = 0; i < count; i++) {
+      uint8_t bit = (uint8_t)(1 << i);
+      if (!(pending & bit))
+        continue;
+
+      BOOT_StepFn fn = (BOOT_StepFn)pgm_read_word(&steps[i].fn);
+      uint16_t timeoutMs = pgm_read_word(&steps[i].timeoutMs);
+      uint16_t elapsed = (uint16_t)(TIM_GetMillis() - start);
+
+      if (fn(elapsed) == BOOT_DONE) {
+        pending &= ~bit;
+      } else if (elapsed >= timeoutMs) {
+        pending &= ~bit;
+        report->timedOut |= bit;
+      } else {
+        continue;
+      }
+      report->doneMs[i] = (uint16_t)(TIM_GetMillis() - start);
+    }
+  }
+
+  report->count = count;
+  report->totalMs = (uint16_t)(TIM_GetMillis() - start);
+}
+
+uint8_t BOOT_FormatStep(const BOOT_Step *steps, const BOOT_Report *report, uint8_t i, char *buf)
+{
+  char *p = FMT_StrP(buf, PSTR("BOOT:\t"));
+  p = FMT_StrP(p, (const char *)pgm_read_word(&steps[i].name));
+  *p++ = '\t';
+  p = FMT_UInt(p, report->doneMs[i]);
+  p = FMT_StrP(p, PSTR("ms"));
+  if (report->timedOut & (1 << i))
+    p = FMT_StrP(p, PSTR("\tTIMEOUT"));
+  return (uint8_t)(FMT_End(p) - buf);
+}
+
+uint8_t BOOT_FormatSummary(const BOOT_Report *report, char *buf)
+{
+  char *p = FMT_StrP(buf, PSTR("BOOT:\ttotal\t"));
+  p = FMT_UInt(p, report->totalMs);
+  p = FMT_StrP(p, PSTR("ms\tfirst_sample\t"));
+  p = FMT_UInt(p, report->firstSampleMs);
+  p = FMT_StrP(p, PSTR("ms"));
+  return (uint8_t)(FMT_End(p) - buf);
+}
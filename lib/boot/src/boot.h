@@ -0,0 +1,85 @@
+/**
+ * @file boot.h
+ * @brief Overlapped boot pipeline: independent start-up steps polled round-robin
+ * @author Nate Hunter
+ * @date 2025-08-03
+ * @version v1.0.0
+ *
+ * Start-up work that mostly waits on hardware (baro IIR filter settling,
+ * IMU turn-on, radio configuration) is written as non-blocking steps.
+ * BOOT_Run polls every unfinished step in turn until all are done, so the
+ * waits overlap instead of adding up. A step that exceeds its timeout is
+ * dropped and flagged in the report.
+ */
+
+#ifndef BOOT_H
+#define BOOT_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef BOOT_MAX_STEPS
+#define BOOT_MAX_STEPS  4    ///< Size of the result array in BOOT_Report
+#endif
+
+/** @brief Step poll result */
+typedef enum {
+  BOOT_BUSY = 0,   ///< Poll again later
+  BOOT_DONE        ///< Step finished
+} BOOT_State;
+
+/**
+ * @brief Step body, must return quickly
+ * @param elapsedMs Time since BOOT_Run started (ms)
+ * @return BOOT_State
+ */
+typedef uint8_t (*BOOT_StepFn)(uint16_t elapsedMs);
+
+/**
+ * @brief Step table entry (stored in PROGMEM)
+ */
+typedef struct {
+  BOOT_StepFn fn;      /**< Step body */
+  const char *name;    /**< PROGMEM name for the log */
+  uint16_t timeoutMs;  /**< Give up after this long (ms since BOOT_Run start) */
+} BOOT_Step;
+
+/**
+ * @brief Boot pipeline outcome (also the binary log record, 14 bytes)
+ */
+typedef struct {
+  uint8_t count;                      /**< Steps run */
+  uint8_t timedOut;                   /**< Bit i set if step i timed out */
+  uint16_t totalMs;                   /**< Pipeline duration (ms) */
+  uint16_t firstSampleMs;             /**< Time from timer start to first logged sample (ms) */
+  uint16_t doneMs[BOOT_MAX_STEPS];    /**< Completion time of each step (ms) */
+} BOOT_Report;
+
+/**
+ * @brief Poll all steps until each is done or timed out
+ * @param steps PROGMEM step table
+ * @param count Number of steps (<= BOOT_MAX_STEPS)
+ * @param report Filled with the results; firstSampleMs is left to the caller
+ */
+void BOOT_Run(const BOOT_Step *steps, uint8_t count, BOOT_Report *report);
+
+/**
+ * @brief Format one step as "BOOT:\t<name>\t<ms>ms[\tTIMEOUT]"
+ * @return Line length
+ */
+uint8_t BOOT_FormatStep(const BOOT_Step *steps, const BOOT_Report *report, uint8_t i, char *buf);
+
+/**
+ * @brief Format the summary line "BOOT:\ttotal\t<ms>ms\tfirst_sample\t<ms>ms"
+ * @return Line length
+ */
+uint8_t BOOT_FormatSummary(const BOOT_Report *report, char *buf);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BOOT_H */
@@ -0,0 +1,86 @@
+/**
+ * @file bustrace.c
+ * @brief TWI / SPI transaction trace ring implementation
+ * @author Nate Hunter
+ * @date 2025-07-30
+ * @version v1.0.0
+ */
+
+#include "bustrace.h"
+
+#if BUSTRACE_ENABLE
+
+#include "fmt.h"
+#include <avr/pgmspace.h>
+
+static BUSTRACE_Entry traceRing[BUSTRACE_DEPTH];
+static uint8_t traceHead;
+static uint8_t traceCount;
+static uint8_t traceFrozen;
+
+void BUSTRACE_Record(uint8_t dev, uint8_t reg, uint8_t len, uint8_t status, uint32_t start)
+{
+  if (traceFrozen)
+    return;
+
+  uint32_t d = TIM_GetTicks() - start;
+  BUSTRACE_Entry *e = &traceRing[traceHead];
+  e->start = start;
+  e->duration = d > 0xFFFF ? 0xFFFF : (uint16_t)d;
+  e->dev = dev;
+  e->reg = reg;
+  e->len = len;
+  e->status = status;
+
+  if (++traceHead >= BUSTRACE_DEPTH)
+    traceHead = 0;
+  if (traceCount < BUSTRACE_DEPTH)
+    traceCount++;
+  if (status)
+    traceFrozen = 1;
+}
+
+uint8_t BUSTRACE_IsFrozen(void)
+{
+  return traceFrozen;
+}
+
+void BUSTRACE_Unfreeze(void)
+{
+  traceHead = 0;
+  traceCount = 0;
+  traceFrozen = 0;
+}
+
+uint8_t BUSTRACE_Count(void)
+{
+  return traceCount;
+}
+
+uint8_t BUSTRACE_Get(uint8_t i, BUSTRACE_Entry *e)
+{
+  if (i >= traceCount)
+    return 0;
+  uint8_t idx = (traceHead + BUSTRACE_DEPTH - traceCount + i) % BUSTRACE_DEPTH;
+  *e = traceRing[idx];
+  return 1;
+}
+
+uint8_t BUSTRACE_Format(const BUSTRACE_Entry *e, char *buf)
+{
+  char *p = FMT_StrP(buf, PSTR("BUS:\t"));
+  p = FMT_UInt(p, e->start * TIM_TICK_US);
+  p = FMT_StrP(p, PSTR("us\t"));
+  p = FMT_UInt(p, (uint32_t)e->duration * TIM_TICK_US);
+  p = FMT_StrP(p, (e->dev & BUSTRACE_SPI) ? PSTR("us\tSPI\t") : PSTR("us\tTWI\t"));
+  p = FMT_Hex8(p, e->dev & 0x7F);
+  *p++ = '\t';
+  p = FMT_Hex8(p, e->reg);
+  *p++ = '\t';
+  p = FMT_UInt(p, e->len);
+  *p++ = '\t';
+  p = FMT_UInt(p, e->status);
+  return (uint8_t)(FMT_End(p) - buf);
+}
+
+#endif /* BUSTRACE_ENABLE */
@@ -0,0 +1,104 @@
+/**
+ * @file bustrace.h
+ * @brief Optional RAM trace of TWI and SPI transactions, frozen on error
+ * @author Nate Hunter
+ * @date 2025-07-30
+ * @version v1.0.0
+ *
+ * Drivers wrap each transaction in BUSTRACE_BEGIN() / BUSTRACE_END().
+ * The ring keeps the last BUSTRACE_DEPTH transactions; the first one
+ * that ends with a non-zero status freezes it, so the history leading
+ * up to a stall or timeout survives until BUSTRACE_Unfreeze().
+ * With BUSTRACE_ENABLE=0 (default) the markers expand to nothing.
+ */
+
+#ifndef BUSTRACE_H
+#define BUSTRACE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup BUSTRACE_Config Trace configuration
+ * @{
+ */
+#ifndef BUSTRACE_ENABLE
+#define BUSTRACE_ENABLE  0     ///< 1 = record bus transactions
+#endif
+#ifndef BUSTRACE_DEPTH
+#define BUSTRACE_DEPTH   16    ///< Entries kept (10 bytes each)
+#endif
+/** @} */
+
+/** @defgroup BUSTRACE_Dev Device byte encoding
+ * @{
+ */
+#define BUSTRACE_TWI     0x00  ///< Low 7 bits: I2C address
+#define BUSTRACE_SPI     0x80  ///< Low 7 bits: chip-select pin
+/** @} */
+
+/**
+ * @brief One bus transaction (10 bytes)
+ */
+typedef struct {
+  uint32_t start;      /**< Start (Timer1 ticks, 4 us) */
+  uint16_t duration;   /**< Duration (ticks, saturates at 65535) */
+  uint8_t dev;         /**< BUSTRACE_TWI / BUSTRACE_SPI | address or CS pin */
+  uint8_t reg;         /**< Register (SPI: address byte without R/W bit) */
+  uint8_t len;         /**< Data bytes */
+  uint8_t status;      /**< Driver status, 0 = success */
+} BUSTRACE_Entry;
+
+#if BUSTRACE_ENABLE
+
+#include "time.h"
+
+/** @brief Append a transaction; freezes the ring on a non-zero status */
+void BUSTRACE_Record(uint8_t dev, uint8_t reg, uint8_t len, uint8_t status, uint32_t start);
+
+/** @brief 1 if an error froze the ring */
+uint8_t BUSTRACE_IsFrozen(void);
+
+/** @brief Clear the ring and resume recording */
+void BUSTRACE_Unfreeze(void);
+
+/** @brief Number of valid entries */
+uint8_t BUSTRACE_Count(void);
+
+/**
+ * @brief Copy an entry, oldest first
+ * @param i Index (0 .. BUSTRACE_Count() - 1)
+ * @param e Destination
+ * @return 1 if valid
+ */
+uint8_t BUSTRACE_Get(uint8_t i, BUSTRACE_Entry *e);
+
+/**
+ * @brief Format an entry as a text line
+ *
+ * "BUS:\t<start>us\t<duration>us\tTWI|SPI\t<dev>\t<reg>\t<len>\t<status>"
+ * (dev and reg in hex)
+ *
+ * @param e Entry
+ * @param buf Output buffer (>= 64 bytes)
+ * @return Line length
+ */
+uint8_t BUSTRACE_Format(const BUSTRACE_Entry *e, char *buf);
+
+#define BUSTRACE_BEGIN()                  uint32_t bustrace_start = TIM_GetTicks()
+#define BUSTRACE_END(dev, reg, len, st)   BUSTRACE_Record((dev), (reg), (len), (st), bustrace_start)
+
+#else
+
+#define BUSTRACE_BEGIN()                  ((void)0)
+#define BUSTRACE_END(dev, reg, len, st)   ((void)0)
+
+#endif /* BUSTRACE_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BUSTRACE_H */
@@ -0,0 +1,156 @@
+/**
+ * @file calib.c
+ * @brief Sensor calibration measurement and EEPROM persistence
+ * @author Nate Hunter
+ * @date 2025-07-22
+ * @version v1.0.0
+ */
+
+#include "calib.h"
+#include "crc16.h"
+#include <avr/eeprom.h>
+#include <stddef.h>
+#include <util/delay.h>
+
+/** Stored calibration record */
+static CALIB_Data EEMEM calibEeprom;
+
+/** Six-position captures: [axis][0 = down, 1 = up], 0 = not captured */
+static int16_t calibFaces[3][2];
+
+/**
+ * @brief Reset a record to identity correction
+ */
+static void CALIB_SetIdentity(CALIB_Data *cal)
+{
+  for (uint8_t i = 0; i < 3; i++) {
+    cal->gyroBias[i] = 0;
+    cal->accelOffset[i] = 0;
+    cal->accelGain[i] = 16384;
+  }
+  cal->baroRef = 0;
+}
+
+/**
+ * @brief Average CALIB_SAMPLES uncorrected IMU samples
+ * @note Temporarily removes the driver correction
+ */
+static CALIB_Status CALIB_Average(LSM6DS3_Handle *imu, int16_t accel[3], int16_t gyro[3])
+{
+  int32_t sumA[3] = { 0 }, sumG[3] = { 0 };
+  int16_t a[3], g[3];
+  int16_t bias[3], offset[3], gain[3];
+
+  for (uint8_t i = 0; i < 3; i++) {
+    bias[i] = imu->gyroBias[i];
+    offset[i] = imu->accelOffset[i];
+    gain[i] = imu->accelGain[i];
+  }
+  LSM6DS3_SetCalibration(imu, 0, 0, 0);
+
+  CALIB_Status status = CALIB_OK;
+  for (uint16_t n = 0; n < CALIB_SAMPLES; n++) {
+    if (!LSM6DS3_ReadRaw(imu, a, g)) {
+      status = CALIB_READ_ERROR;
+      break;
+    }
+    for (uint8_t i = 0; i < 3; i++) {
+      sumA[i] += a[i];
+      sumG[i] += g[i];
+    }
+    _delay_ms(2);
+  }
+
+  for (uint8_t i = 0; i < 3; i++) {
+    accel[i] = (int16_t)(sumA[i] / CALIB_SAMPLES);
+    gyro[i] = (int16_t)(sumG[i] / CALIB_SAMPLES);
+  }
+
+  LSM6DS3_SetCalibration(imu, bias, offset, gain);
+  return status;
+}
+
+CALIB_Status CALIB_Load(CALIB_Data *cal)
+{
+  eeprom_read_block(cal, &calibEeprom, sizeof(CALIB_Data));
+
+  if (cal->version != CALIB_VERSION) {
+    CALIB_SetIdentity(cal);
+    return CALIB_EMPTY;
+  }
+  if (CRC16_Compute(cal, offsetof(CALIB_Data, crc)) != cal->crc) {
+    CALIB_SetIdentity(cal);
+    return CALIB_CRC_ERROR;
+  }
+  return CALIB_OK;
+}
+
+void CALIB_Save(CALIB_Data *cal)
+{
+  cal->version = CALIB_VERSION;
+  cal->crc = CRC16_Compute(cal, offsetof(CALIB_Data, crc));
+  eeprom_update_block(cal, &calibEeprom, sizeof(CALIB_Data));
+}
+
+void CALIB_Apply(const CALIB_Data *cal, LSM6DS3_Handle *imu, BMP280_HandleTypeDef *bmp)
+{
+  LSM6DS3_SetCalibration(imu, cal->gyroBias, cal->accelOffset, cal->accelGain);
+  if (cal->baroRef && !bmp->zeroLvlPress)
+    bmp->zeroLvlPress = cal->baroRef;
+}
+
+CALIB_Status CALIB_CheckBaro(const CALIB_Data *cal, uint32_t pressure)
+{
+  if (!cal->baroRef)
+    return CALIB_EMPTY;
+  uint32_t delta = pressure > cal->baroRef ? pressure - cal->baroRef : cal->baroRef - pressure;
+  return delta > CALIB_BARO_TOL_PA ? CALIB_RANGE_ERROR : CALIB_OK;
+}
+
+CALIB_Status CALIB_MeasureLevel(CALIB_Data *cal, LSM6DS3_Handle *imu, BMP280_HandleTypeDef *bmp)
+{
+  int16_t a[3], g[3];
+  CALIB_Status status = CALIB_Average(imu, a, g);
+  if (status != CALIB_OK)
+    return status;
+
+  // +1 g on Z expressed in uncorrected LSB for the current gain
+  int32_t oneG = (int32_t)(1.0f / imu->accelScale + 0.5f);
+  for (uint8_t i = 0; i < 3; i++)
+    cal->gyroBias[i] = g[i];
+  cal->accelOffset[0] = a[0];
+  cal->accelOffset[1] = a[1];
+  cal->accelOffset[2] = (int16_t)(a[2] - (oneG * 16384) / cal->accelGain[2]);
+
+  uint32_t sum = 0;
+  for (uint8_t n = 0; n < 16; n++) {
+    if (BMP280_ReadPressure(bmp) != BMP280_OK)
+      return CALIB_READ_ERROR;
+    sum += bmp->pressure;
+    _delay_ms(10);
+  }
+  cal->baroRef = sum / 16;
+
+  return CALIB_OK;
+}
+
+CALIB_Status CALIB_MeasureAxis(CALIB_Data *cal, LSM6DS3_Handle *imu, uint8_t axis, uint8_t positive)
+{
+  int16_t a[3], g[3];
+  if (axis > 2)
+    return CALIB_READ_ERROR;
+
+  CALIB_Status status = CALIB_Average(imu, a, g);
+  if (status != CALIB_OK)
+    return status;
+
+  calibFaces[axis][positive ? 1 : 0] = a[axis];
+
+  int16_t up = calibFaces[axis][1], down = calibFaces[axis][0];
+  if (up > 0 && down < 0) {
+    int32_t oneG = (int32_t)(1.0f / imu->accelScale + 0.5f);
+    cal->accelOffset[axis] = (int16_t)(((int32_t)up + down) / 2);
+    cal->accelGain[axis] = (int16_t)((2 * oneG * 16384) / ((int32_t)up - down));
+  }
+  return CALIB_OK;
+}
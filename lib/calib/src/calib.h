@@ -0,0 +1,112 @@
+/**
+ * @file calib.h
+ * @brief Sensor calibration measurement and EEPROM persistence
+ * @author Nate Hunter
+ * @date 2025-07-22
+ * @version v1.0.0
+ */
+
+#ifndef CALIB_H
+#define CALIB_H
+
+#include <stdint.h>
+#include "lsm6ds3.h"
+#include "bmp280.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CALIB_VERSION        1     ///< Bump when CALIB_Data layout changes
+#ifndef CALIB_SAMPLES
+#define CALIB_SAMPLES        128   ///< Samples averaged per measurement
+#endif
+#ifndef CALIB_BARO_TOL_PA
+#define CALIB_BARO_TOL_PA    3000  ///< Live pad pressure this far from the stored one is implausible (Pa)
+#endif
+
+/** @brief Calibration status codes */
+typedef enum {
+  CALIB_OK = 0,
+  CALIB_EMPTY,        ///< EEPROM blank or written by another version
+  CALIB_CRC_ERROR,    ///< Stored record corrupted
+  CALIB_READ_ERROR,   ///< Sensor read failed during measurement
+  CALIB_RANGE_ERROR   ///< Live value implausible against the stored one
+} CALIB_Status;
+
+/**
+ * @brief Calibration record, stored as-is in EEPROM
+ */
+typedef struct {
+  uint8_t version;          /**< CALIB_VERSION */
+  int16_t gyroBias[3];      /**< Gyroscope zero-rate bias (LSB) */
+  int16_t accelOffset[3];   /**< Accelerometer offset (LSB) */
+  int16_t accelGain[3];     /**< Accelerometer gain, Q14 */
+  uint32_t baroRef;         /**< Reference (zero-level) pressure (Pa) */
+  uint16_t crc;             /**< CRC-16 over all preceding bytes */
+} CALIB_Data;
+
+/**
+ * @brief Load and validate the stored record
+ * @param[out] cal Record; identity values on failure
+ * @return CALIB_Status
+ */
+CALIB_Status CALIB_Load(CALIB_Data *cal);
+
+/**
+ * @brief Store the record with a fresh version and CRC
+ * @param cal Record to store
+ */
+void CALIB_Save(CALIB_Data *cal);
+
+/**
+ * @brief Apply a record to the driver read paths
+ * @param cal Record
+ * @param imu LSM6DS3 handle
+ * @param bmp BMP280 handle
+ * @note The stored reference pressure only becomes the altitude zero when
+ *       @p bmp has none yet: the live pad pressure always takes precedence.
+ */
+void CALIB_Apply(const CALIB_Data *cal, LSM6DS3_Handle *imu, BMP280_HandleTypeDef *bmp);
+
+/**
+ * @brief Check a live pad pressure against the stored reference
+ * @param cal Record
+ * @param pressure Live pressure (Pa)
+ * @return CALIB_OK, CALIB_EMPTY without a stored reference, CALIB_RANGE_ERROR
+ *         when the two differ by more than CALIB_BARO_TOL_PA
+ */
+CALIB_Status CALIB_CheckBaro(const CALIB_Data *cal, uint32_t pressure);
+
+/**
+ * @brief Measure gyro bias, level accel offsets and baro reference
+ *
+ * The board must be at rest with +Z pointing up. Accelerometer gains
+ * already in @p cal are kept.
+ *
+ * @param cal Record to update
+ * @param imu LSM6DS3 handle
+ * @param bmp BMP280 handle
+ * @return CALIB_Status
+ */
+CALIB_Status CALIB_MeasureLevel(CALIB_Data *cal, LSM6DS3_Handle *imu, BMP280_HandleTypeDef *bmp);
+
+/**
+ * @brief Capture one face of a six-position accelerometer calibration
+ *
+ * Once both faces of an axis are captured, offset and gain of that
+ * axis are recomputed in @p cal.
+ *
+ * @param cal Record to update
+ * @param imu LSM6DS3 handle
+ * @param axis 0 = X, 1 = Y, 2 = Z
+ * @param positive 1 if the axis points up, 0 if down
+ * @return CALIB_Status
+ */
+CALIB_Status CALIB_MeasureAxis(CALIB_Data *cal, LSM6DS3_Handle *imu, uint8_t axis, uint8_t positive);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CALIB_H */
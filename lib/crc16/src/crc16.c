@@ -0,0 +1,26 @@
+/**
+ * @file crc16.c
+ * @brief CRC-16/CCITT-FALSE implementation
+ * @author Nate Hunter
+ * @date 2025-07-22
+ * @version v1.0.0
+ */
+
+#include "crc16.h"
+
+uint16_t CRC16_Update(uint16_t crc, uint8_t data)
+{
+  // Table-free bytewise form, saves 512 bytes of flash
+  data ^= (uint8_t)(crc >> 8);
+  data ^= data >> 4;
+  return (crc << 8) ^ ((uint16_t)data << 12) ^ ((uint16_t)data << 5) ^ data;
+}
+
+uint16_t CRC16_Compute(const void *data, uint16_t len)
+{
+  const uint8_t *p = (const uint8_t *)data;
+  uint16_t crc = CRC16_INIT;
+  while (len--)
+    crc = CRC16_Update(crc, *p++);
+  return crc;
+}
@@ -0,0 +1,40 @@
+/**
+ * @file crc16.h
+ * @brief CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF) helpers
+ * @author Nate Hunter
+ * @date 2025-07-22
+ * @version v1.0.0
+ */
+
+#ifndef CRC16_H
+#define CRC16_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CRC16_INIT 0xFFFF   ///< Initial CRC value
+
+/**
+ * @brief Feed one byte into a running CRC
+ * @param crc Current CRC value
+ * @param data Byte to add
+ * @return Updated CRC
+ */
+uint16_t CRC16_Update(uint16_t crc, uint8_t data);
+
+/**
+ * @brief Compute the CRC of a buffer
+ * @param data Pointer to data
+ * @param len Number of bytes
+ * @return CRC of the buffer starting from CRC16_INIT
+ */
+uint16_t CRC16_Compute(const void *data, uint16_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CRC16_H */
@@ -0,0 +1,265 @@
+/**
+ * @file fat32.c
+ * @brief Minimal FAT32 support implementation
+ * @author Nate Hunter
+ * @date 2025-08-08
+ * @version v1.0.0
+ */
+
+#include "fat32.h"
+#include <string.h>
+
+#define FAT32_EOC         0x0FFFFFFFUL   ///< End of cluster chain
+#define FAT32_MASK        0x0FFFFFFFUL   ///< Low 28 bits hold the entry
+#define FAT32_PER_SECTOR  (SD_BLOCK_SIZE / 4)
+#define FAT32_DIR_ENTRIES (SD_BLOCK_SIZE / 32)
+#define FAT32_ATTR_ARCHIVE 0x20
+#define FAT32_ATTR_LFN     0x0F
+#define FAT32_DATE        ((45 << 9) | (1 << 5) | 1)   ///< 2025-01-01, no RTC
+
+/* Private helpers */
+
+static uint16_t FAT32_Get16(const uint8_t *p)
+{
+  return p[0] | ((uint16_t)p[1] << 8);
+}
+
+static uint32_t FAT32_Get32(const uint8_t *p)
+{
+  return p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void FAT32_Put16(uint8_t *p, uint16_t v)
+{
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+}
+
+static void FAT32_Put32(uint8_t *p, uint32_t v)
+{
+  FAT32_Put16(p, (uint16_t)v);
+  FAT32_Put16(p + 2, (uint16_t)(v >> 16));
+}
+
+static uint32_t FAT32_ClusterLba(const FAT32_Volume *vol, uint32_t cluster)
+{
+  return vol->dataLba + (cluster - 2) * vol->sectorsPerCluster;
+}
+
+/**
+ * @brief Parse a FAT32 boot sector
+ * @return 1 if @p buf holds a usable FAT32 BPB
+ */
+static uint8_t FAT32_ParseBpb(FAT32_Volume *vol, const uint8_t *buf, uint32_t partLba)
+{
+  if (FAT32_Get16(buf + 11) != SD_BLOCK_SIZE || !buf[13] || !buf[16] ||
+      FAT32_Get16(buf + 17) != 0 || FAT32_Get16(buf + 22) != 0)
+    return 0;
+
+  uint16_t reserved = FAT32_Get16(buf + 14);
+  vol->partLba = partLba;
+  vol->sectorsPerCluster = buf[13];
+  vol->numFats = buf[16];
+  vol->fatSectors = FAT32_Get32(buf + 36);
+  vol->rootCluster = FAT32_Get32(buf + 44);
+  vol->fsInfoSector = FAT32_Get16(buf + 48);
+  vol->fatLba = partLba + reserved;
+  vol->dataLba = vol->fatLba + vol->numFats * vol->fatSectors;
+  vol->clusterCount = (FAT32_Get32(buf + 32) - reserved - vol->numFats * vol->fatSectors) /
+                      vol->sectorsPerCluster;
+  return vol->fatSectors != 0;
+}
+
+/**
+ * @brief Read one FAT entry
+ * @return Entry, or 0xFFFFFFFF on a read error
+ */
+static uint32_t FAT32_GetEntry(const FAT32_Volume *vol, SD_Handle *sd, uint8_t *buf, uint32_t cluster)
+{
+  if (SD_ReadBlock(sd, vol->fatLba + cluster / FAT32_PER_SECTOR, buf) != SD_OK)
+    return 0xFFFFFFFFUL;
+  return FAT32_Get32(buf + (cluster % FAT32_PER_SECTOR) * 4) & FAT32_MASK;
+}
+
+/* Public functions */
+
+FAT32_Status FAT32_Mount(FAT32_Volume *vol, SD_Handle *sd, uint8_t *buf)
+{
+  if (SD_ReadBlock(sd, 0, buf) != SD_OK)
+    return FAT32_IO_ERROR;
+  if (buf[510] != 0x55 || buf[511] != 0xAA)
+    return FAT32_NOT_FAT32;
+
+  // Superfloppy: the volume starts at block 0
+  if ((buf[0] == 0xEB || buf[0] == 0xE9) && FAT32_ParseBpb(vol, buf, 0))
+    return FAT32_OK;
+
+  // First MBR partition, type 0x0B / 0x0C
+  uint8_t type = buf[446 + 4];
+  if (type != 0x0B && type != 0x0C)
+    return FAT32_NOT_FAT32;
+  uint32_t partLba = FAT32_Get32(buf + 446 + 8);
+  if (SD_ReadBlock(sd, partLba, buf) != SD_OK)
+    return FAT32_IO_ERROR;
+  return FAT32_ParseBpb(vol, buf, partLba) ? FAT32_OK : FAT32_NOT_FAT32;
+}
+
+FAT32_Status FAT32_CreateBegin(FAT32_Create *op, const FAT32_Volume *vol, SD_Handle *sd,
+                               uint8_t *buf, const char *name, uint32_t bytes,
+                               FAT32_File *file)
+{
+  int32_t highest = -1;
+
+  // Root directory: first free entry and the highest number in use
+  op->slotLba = 0;
+  uint32_t cluster = vol->rootCluster;
+  uint8_t end = 0;
+  while (!end && cluster >= 2 && cluster < 0x0FFFFFF8UL) {
+    uint32_t lba = FAT32_ClusterLba(vol, cluster);
+    for (uint8_t s = 0; s < vol->sectorsPerCluster && !end; s++) {
+      if (SD_ReadBlock(sd, lba + s, buf) != SD_OK)
+        return FAT32_IO_ERROR;
+      for (uint8_t e = 0; e < FAT32_DIR_ENTRIES; e++) {
+        const uint8_t *ent = buf + e * 32;
+        if (ent[0] == 0x00 || ent[0] == 0xE5) {
+          if (!op->slotLba) {
+            op->slotLba = lba + s;
+            op->slot = e;
+          }
+          if (ent[0] == 0x00) {      // Nothing in use after this entry
+            end = 1;
+            break;
+          }
+          continue;
+        }
+        if (ent[11] == FAT32_ATTR_LFN || memcmp(ent, name, 3) || memcmp(ent + 8, name + 8, 3))
+          continue;
+        int32_t n = 0;
+        for (uint8_t i = 3; i < 8; i++) {
+          if (ent[i] < '0' || ent[i] > '9') {
+            n = -1;
+            break;
+          }
+          n = n * 10 + (ent[i] - '0');
+        }
+        if (n > highest)
+          highest = n;
+      }
+    }
+    if (!end)
+      cluster = FAT32_GetEntry(vol, sd, buf, cluster);
+  }
+  if (!op->slotLba)
+    return FAT32_DIR_FULL;
+
+  memcpy(file->name, name, 11);
+  uint32_t number = (uint32_t)(highest + 1);
+  for (int8_t i = 7; i >= 3; i--) {
+    file->name[i] = '0' + number % 10;
+    number /= 10;
+  }
+
+  // Length in whole clusters; the run search starts at the first FAT sector
+  uint32_t clusterBytes = (uint32_t)vol->sectorsPerCluster * SD_BLOCK_SIZE;
+  file->sectors = (bytes + clusterBytes - 1) / clusterBytes * vol->sectorsPerCluster;
+  file->firstLba = 0;
+  op->sector = 0;
+  op->runStart = 0;
+  op->run = 0;
+  return FAT32_OK;
+}
+
+FAT32_Status FAT32_CreateStep(FAT32_Create *op, const FAT32_Volume *vol, SD_Handle *sd,
+                              uint8_t *buf, FAT32_File *file)
+{
+  uint32_t need = file->sectors / vol->sectorsPerCluster;
+  uint32_t last = vol->clusterCount + 2;     // One past the last cluster
+
+  // One FAT sector of the search for a long enough run of free clusters
+  if (op->run < need) {
+    if (op->sector >= vol->fatSectors)
+      return FAT32_NO_SPACE;
+    if (SD_ReadBlock(sd, vol->fatLba + op->sector, buf) != SD_OK)
+      return FAT32_IO_ERROR;
+    for (uint8_t i = 0; i < FAT32_PER_SECTOR && op->run < need; i++) {
+      uint32_t c = op->sector * FAT32_PER_SECTOR + i;
+      if (c < 2)
+        continue;
+      if (c >= last)
+        return FAT32_NO_SPACE;
+      if (FAT32_Get32(buf + i * 4) & FAT32_MASK) {
+        op->run = 0;
+      } else if (op->run++ == 0) {
+        op->runStart = c;
+      }
+    }
+    op->sector++;
+    if (op->run < need)
+      return FAT32_BUSY;
+
+    // FSInfo free count is now unknown; hosts recount it. Done before the
+    // chain so an abandoned creation never overstates the free space
+    uint32_t fsInfo = vol->partLba + vol->fsInfoSector;
+    if (vol->fsInfoSector && SD_ReadBlock(sd, fsInfo, buf) == SD_OK &&
+        FAT32_Get32(buf) == 0x41615252UL) {
+      FAT32_Put32(buf + 488, 0xFFFFFFFFUL);
+      FAT32_Put32(buf + 492, op->runStart + need);
+      SD_WriteBlock(sd, fsInfo, buf);
+    }
+    op->sector = op->runStart / FAT32_PER_SECTOR;
+    return FAT32_BUSY;
+  }
+
+  // Chain the run in every FAT copy, one FAT sector per call
+  uint32_t runStart = op->runStart;
+  uint32_t runEnd = runStart + need - 1;
+  if (op->sector <= runEnd / FAT32_PER_SECTOR) {
+    uint32_t sec = op->sector;
+    if (SD_ReadBlock(sd, vol->fatLba + sec, buf) != SD_OK)
+      return FAT32_IO_ERROR;
+    for (uint8_t i = 0; i < FAT32_PER_SECTOR; i++) {
+      uint32_t c = sec * FAT32_PER_SECTOR + i;
+      if (c < runStart || c > runEnd)
+        continue;
+      uint8_t *p = buf + i * 4;
+      uint32_t next = c == runEnd ? FAT32_EOC : c + 1;
+      FAT32_Put32(p, (FAT32_Get32(p) & ~FAT32_MASK) | next);
+    }
+    for (uint8_t f = 0; f < vol->numFats; f++) {
+      if (SD_WriteBlock(sd, vol->fatLba + f * vol->fatSectors + sec, buf) != SD_OK)
+        return FAT32_IO_ERROR;
+    }
+    op->sector++;
+    return FAT32_BUSY;
+  }
+
+  // Directory entry with the final size
+  if (SD_ReadBlock(sd, op->slotLba, buf) != SD_OK)
+    return FAT32_IO_ERROR;
+  uint8_t *ent = buf + op->slot * 32;
+  memset(ent, 0, 32);
+  memcpy(ent, file->name, 11);
+  ent[11] = FAT32_ATTR_ARCHIVE;
+  FAT32_Put16(ent + 16, FAT32_DATE);         // Created
+  FAT32_Put16(ent + 18, FAT32_DATE);         // Accessed
+  FAT32_Put16(ent + 20, (uint16_t)(runStart >> 16));
+  FAT32_Put16(ent + 24, FAT32_DATE);         // Modified
+  FAT32_Put16(ent + 26, (uint16_t)runStart);
+  FAT32_Put32(ent + 28, file->sectors * SD_BLOCK_SIZE);
+  if (SD_WriteBlock(sd, op->slotLba, buf) != SD_OK)
+    return FAT32_IO_ERROR;
+  file->firstLba = FAT32_ClusterLba(vol, runStart);
+  return FAT32_OK;
+}
+
+FAT32_Status FAT32_CreateContiguous(const FAT32_Volume *vol, SD_Handle *sd, uint8_t *buf,
+                                    const char *name, uint32_t bytes, FAT32_File *file)
+{
+  FAT32_Create op;
+  FAT32_Status status = FAT32_CreateBegin(&op, vol, sd, buf, name, bytes, file);
+  if (status != FAT32_OK)
+    return status;
+  while ((status = FAT32_CreateStep(&op, vol, sd, buf, file)) == FAT32_BUSY)
+    ;
+  return status;
+}
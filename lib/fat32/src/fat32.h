@@ -0,0 +1,147 @@
+/**
+ * @file fat32.h
+ * @brief Minimal FAT32 support: mount and create one contiguous, preallocated file
+ * @author Nate Hunter
+ * @date 2025-08-08
+ * @version v1.0.0
+ *
+ * Only what a raw-block logger needs: the file is created at boot with its
+ * full cluster chain and final size, so in flight the data is written as
+ * plain sequential blocks (SD_Stream*) with no FAT or directory updates.
+ * A host sees a normal file; bytes past the last written block are stale.
+ *
+ * The caller lends one 512-byte buffer for the duration of each call; it
+ * is not kept between calls. Creating a file can be split into bounded
+ * steps (FAT32_CreateBegin / FAT32_CreateStep) so a non-blocking boot can
+ * run other work and enforce a time budget while the FAT is searched.
+ */
+
+#ifndef FAT32_H
+#define FAT32_H
+
+#include <stdint.h>
+#include "sd.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Status codes */
+typedef enum {
+  FAT32_OK = 0,
+  FAT32_IO_ERROR,      ///< Card read / write failed
+  FAT32_NOT_FAT32,     ///< No FAT32 volume in partition 1 or sector 0
+  FAT32_NO_SPACE,      ///< No free run of clusters long enough
+  FAT32_DIR_FULL,      ///< No free entry in the root directory
+  FAT32_BUSY           ///< FAT32_CreateStep: call again
+} FAT32_Status;
+
+/**
+ * @brief Mounted volume geometry
+ */
+typedef struct {
+  uint32_t partLba;            /**< Volume start */
+  uint32_t fatLba;             /**< First FAT */
+  uint32_t fatSectors;         /**< Sectors per FAT */
+  uint32_t dataLba;            /**< Cluster 2 */
+  uint32_t clusterCount;       /**< Data clusters */
+  uint32_t rootCluster;        /**< Root directory start */
+  uint16_t fsInfoSector;       /**< FSInfo, relative to partLba */
+  uint8_t numFats;             /**< FAT copies */
+  uint8_t sectorsPerCluster;   /**< Cluster size (blocks) */
+} FAT32_Volume;
+
+/**
+ * @brief Contiguous file created by FAT32_CreateContiguous
+ */
+typedef struct {
+  char name[11];               /**< 8.3 name as stored in the directory */
+  uint32_t firstLba;           /**< First data block */
+  uint32_t sectors;            /**< Allocated blocks */
+} FAT32_File;
+
+/**
+ * @brief Resumable file creation state (FAT32_CreateBegin / FAT32_CreateStep)
+ */
+typedef struct {
+  uint32_t slotLba;            /**< Directory block of the free entry */
+  uint8_t slot;                /**< Entry index in slotLba */
+  uint32_t sector;             /**< FAT sector to scan, then to chain, next */
+  uint32_t runStart;           /**< First cluster of the free run */
+  uint32_t run;                /**< Free run length so far (clusters) */
+} FAT32_Create;
+
+/**
+ * @brief Find and parse the FAT32 volume (MBR partition 1 or superfloppy)
+ * @param vol Filled on success
+ * @param sd Initialized card
+ * @param buf 512-byte scratch buffer
+ * @return FAT32_Status
+ */
+FAT32_Status FAT32_Mount(FAT32_Volume *vol, SD_Handle *sd, uint8_t *buf);
+
+/**
+ * @brief Start creating a root-directory file of at least @p bytes in one
+ *        cluster run: scan the root directory for a free entry and the name
+ * @param op Creation state
+ * @param vol Mounted volume
+ * @param sd Card
+ * @param buf 512-byte scratch buffer
+ * @param name 8.3 name without the dot ("FDR00000BIN"); characters 3-7 are
+ *        replaced by one more than the highest number already used with
+ *        the same prefix and extension
+ * @param bytes Requested size (rounded up to whole clusters)
+ * @param[out] file Name and length of the new file; firstLba is set by
+ *        the FAT32_CreateStep() call that returns FAT32_OK
+ * @return FAT32_OK to continue with FAT32_CreateStep(), or an error
+ */
+FAT32_Status FAT32_CreateBegin(FAT32_Create *op, const FAT32_Volume *vol, SD_Handle *sd,
+                               uint8_t *buf, const char *name, uint32_t bytes,
+                               FAT32_File *file);
+
+/**
+ * @brief Continue a file creation by one bounded step
+ *
+ * Each call does one of, in this order:
+ * - scan one FAT sector for the free run (1 block read; the call that
+ *   completes the run also invalidates the FSInfo free count, +1 read
+ *   and 1 write)
+ * - chain one FAT sector of the run in every FAT copy (1 read and
+ *   numFats writes, one call per 128 clusters)
+ * - write the directory entry (1 read, 1 write) and return FAT32_OK
+ *
+ * An abandoned creation leaves no directory entry; clusters already
+ * chained are lost until a host check reclaims them.
+ *
+ * @param op State from FAT32_CreateBegin()
+ * @param vol Mounted volume
+ * @param sd Card
+ * @param buf 512-byte scratch buffer
+ * @param file File from FAT32_CreateBegin()
+ * @return FAT32_BUSY, FAT32_OK when the file exists, or an error
+ */
+FAT32_Status FAT32_CreateStep(FAT32_Create *op, const FAT32_Volume *vol, SD_Handle *sd,
+                              uint8_t *buf, FAT32_File *file);
+
+/**
+ * @brief Create a root-directory file of at least @p bytes in one cluster run
+ * @param vol Mounted volume
+ * @param sd Card
+ * @param buf 512-byte scratch buffer
+ * @param name 8.3 name without the dot ("FDR00000BIN"); characters 3-7 are
+ *        replaced by one more than the highest number already used with
+ *        the same prefix and extension
+ * @param bytes Requested size (rounded up to whole clusters)
+ * @param[out] file Name, first block and length of the new file
+ * @return FAT32_Status
+ * @note Blocking; FAT32_CreateBegin() followed by FAT32_CreateStep() until
+ *       it stops returning FAT32_BUSY.
+ */
+FAT32_Status FAT32_CreateContiguous(const FAT32_Volume *vol, SD_Handle *sd, uint8_t *buf,
+                                    const char *name, uint32_t bytes, FAT32_File *file);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FAT32_H */
@@ -0,0 +1,142 @@
+/**
+ * @file fft.c
+ * @brief In-place fixed-point radix-2 FFT implementation
+ * @author Nate Hunter
+ * @date 2025-07-24
+ * @version v1.0.0
+ */
+
+#include "fft.h"
+#include <avr/pgmspace.h>
+
+#define FFT_TABLE_SIZE 128   ///< Circle resolution of the sine table
+
+/** Quarter-wave sine, Q15, sin(2*pi*i/128) for i = 0..32 */
+static const int16_t fftSine[FFT_TABLE_SIZE / 4 + 1] PROGMEM = {
+  0, 1608, 3212, 4808, 6393, 7962, 9512, 11039, 12540, 14010, 15447,
+  16846, 18205, 19520, 20788, 22006, 23170, 24279, 25330, 26320, 27246,
+  28106, 28899, 29622, 30274, 30853, 31357, 31786, 32138, 32413, 32610,
+  32729, 32767
+};
+
+/**
+ * @brief sin(2*pi*i/FFT_SIZE) in Q15 from the quarter-wave table
+ */
+static int16_t FFT_Sin(uint8_t i)
+{
+  uint8_t k = (uint8_t)((i * (FFT_TABLE_SIZE / FFT_SIZE)) & (FFT_TABLE_SIZE - 1));
+  uint8_t q = FFT_TABLE_SIZE / 4;
+
+  if (k <= q) return (int16_t)pgm_read_word(&fftSine[k]);
+  if (k <= 2 * q) return (int16_t)pgm_read_word(&fftSine[2 * q - k]);
+  if (k <= 3 * q) return -(int16_t)pgm_read_word(&fftSine[k - 2 * q]);
+  return -(int16_t)pgm_read_word(&fftSine[4 * q - k]);
+}
+
+/**
+ * @brief cos(2*pi*i/FFT_SIZE) in Q15
+ */
+static inline int16_t FFT_Cos(uint8_t i)
+{
+  return FFT_Sin((uint8_t)(i + FFT_SIZE / 4));
+}
+
+/**
+ * @brief 1/8-octave logarithm: 8 * log2(x), 0 for x < 1
+ */
+static uint8_t FFT_Log2Q3(uint32_t x)
+{
+  uint8_t e = 0;
+  if (!x) return 0;
+  while (x >= 16) {
+    x >>= 1;
+    e++;
+  }
+  // x now 1..15: integer part from the remaining bits, 3 fraction bits from the mantissa
+  while (x < 8) {
+    x <<= 1;
+    e--;
+  }
+  return (uint8_t)(((e + 3) << 3) | (x & 0x07));
+}
+
+void FFT_Reset(FFT_Handle *fft)
+{
+  fft->count = 0;
+}
+
+uint8_t FFT_Push(FFT_Handle *fft, int16_t sample)
+{
+  if (fft->count < FFT_SIZE)
+    fft->re[fft->count++] = sample;
+  return fft->count >= FFT_SIZE;
+}
+
+void FFT_Process(FFT_Handle *fft, FFT_Summary *summary)
+{
+  int16_t *re = fft->re, *im = fft->im;
+  uint8_t i, j;
+
+  // Remove DC (gravity), then Hann window
+  int32_t mean = 0;
+  for (i = 0; i < FFT_SIZE; i++)
+    mean += re[i];
+  mean /= FFT_SIZE;
+  for (i = 0; i < FFT_SIZE; i++) {
+    int32_t v = re[i] - mean;
+    if (v > INT16_MAX) v = INT16_MAX;
+    if (v < INT16_MIN) v = INT16_MIN;
+    int16_t w = (int16_t)(16384 - (FFT_Cos(i) >> 1));   // 0.5 - 0.5 cos, Q15
+    re[i] = (int16_t)((v * w) >> 15);
+    im[i] = 0;
+  }
+
+  // Bit-reversal permutation
+  for (i = 1, j = 0; i < FFT_SIZE; i++) {
+    uint8_t bit = FFT_SIZE >> 1;
+    for (; j & bit; bit >>= 1)
+      j ^= bit;
+    j ^= bit;
+    if (i < j) {
+      int16_t t = re[i]; re[i] = re[j]; re[j] = t;
+    }
+  }
+
+  // Decimation-in-time butterflies, scaled by 1/2 per stage
+  for (uint8_t m = 2; m <= FFT_SIZE && m; m <<= 1) {
+    uint8_t half = m >> 1;
+    uint8_t step = FFT_SIZE / m;
+    for (uint8_t k = 0; k < half; k++) {
+      int16_t wr = FFT_Cos(k * step);
+      int16_t wi = -FFT_Sin(k * step);
+      for (i = k; i < FFT_SIZE; i += m) {
+        uint8_t n = i + half;
+        int16_t tr = (int16_t)(((int32_t)wr * re[n] - (int32_t)wi * im[n]) >> 15);
+        int16_t ti = (int16_t)(((int32_t)wr * im[n] + (int32_t)wi * re[n]) >> 15);
+        re[n] = (int16_t)((re[i] - tr) >> 1);
+        im[n] = (int16_t)((im[i] - ti) >> 1);
+        re[i] = (int16_t)((re[i] + tr) >> 1);
+        im[i] = (int16_t)((im[i] + ti) >> 1);
+      }
+    }
+  }
+
+  // Band powers over bins 1 .. N/2-1 (bin 0 is DC, removed above)
+  uint8_t perBand = (FFT_SIZE / 2) / FFT_BANDS;
+  uint32_t peak = 0;
+  summary->peakBin = 0;
+  for (uint8_t b = 0; b < FFT_BANDS; b++) {
+    uint32_t sum = 0;
+    for (uint8_t k = 0; k < perBand; k++) {
+      uint8_t bin = b * perBand + k;
+      if (!bin) continue;
+      uint32_t p = (uint32_t)((int32_t)re[bin] * re[bin]) + (uint32_t)((int32_t)im[bin] * im[bin]);
+      if (p > peak) {
+        peak = p;
+        summary->peakBin = bin;
+      }
+      sum += p >> 3;
+    }
+    summary->band[b] = FFT_Log2Q3(sum);
+  }
+}
@@ -0,0 +1,80 @@
+/**
+ * @file fft.h
+ * @brief In-place fixed-point radix-2 FFT with band-power summary
+ * @author Nate Hunter
+ * @date 2025-07-24
+ * @version v1.0.0
+ */
+
+#ifndef FFT_H
+#define FFT_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup FFT_Config Window sizing
+ * @{
+ */
+#ifndef FFT_SIZE
+#define FFT_SIZE    64    ///< Points per window: 32, 64 or 128 (4 bytes RAM each)
+#endif
+#ifndef FFT_BANDS
+#define FFT_BANDS   8     ///< Equal-width bands in the summary (must divide FFT_SIZE / 2)
+#endif
+/** @} */
+
+#if FFT_SIZE != 32 && FFT_SIZE != 64 && FFT_SIZE != 128
+#error "FFT_SIZE must be 32, 64 or 128"
+#endif
+
+/**
+ * @brief Compact per-window spectrum summary
+ */
+typedef struct {
+  uint8_t band[FFT_BANDS];  /**< Band power, 1/8 octave steps (~0.38 dB) above 1 LSB^2 */
+  uint8_t peakBin;          /**< Strongest bin, frequency = peakBin * sampleRate / FFT_SIZE */
+  uint16_t sampleRate;      /**< Sample rate of the window (Hz) */
+  uint16_t processUs;       /**< Measured FFT_Process() time (us), filled by the caller */
+} FFT_Summary;
+
+/**
+ * @brief FFT working buffers (Q15, in place)
+ */
+typedef struct {
+  int16_t re[FFT_SIZE];     /**< Real part; input samples */
+  int16_t im[FFT_SIZE];     /**< Imaginary part */
+  uint8_t count;            /**< Samples collected in the current window */
+} FFT_Handle;
+
+/**
+ * @brief Start a new window
+ * @param fft Pointer to FFT handle
+ */
+void FFT_Reset(FFT_Handle *fft);
+
+/**
+ * @brief Append a sample to the current window
+ * @param fft Pointer to FFT handle
+ * @param sample Raw sample
+ * @return 1 when the window is full, 0 otherwise
+ */
+uint8_t FFT_Push(FFT_Handle *fft, int16_t sample);
+
+/**
+ * @brief Remove DC, apply a Hann window, transform and summarize a full window
+ *
+ * Every butterfly stage scales by 1/2, so the transform cannot overflow.
+ *
+ * @param fft Pointer to FFT handle (buffers are overwritten)
+ * @param[out] summary Band powers and peak bin
+ */
+void FFT_Process(FFT_Handle *fft, FFT_Summary *summary);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FFT_H */
@@ -0,0 +1,162 @@
+/**
+ * @file flight.c
+ * @brief Flight-phase state machine implementation
+ * @author Nate Hunter
+ * @date 2025-07-20
+ * @version v1.0.0
+ */
+
+#include "flight.h"
+#include "lsm6ds3.h"
+#include "bmp280.h"
+#include <avr/pgmspace.h>
+
+/**
+ * @brief Per-phase acquisition profiles
+ * @note Pad and ground phases run slow to save log space and power,
+ *       boost through apogee run at the highest rate the loop sustains.
+ */
+static const FLIGHT_Profile flightProfiles[FLIGHT_PHASE_COUNT] PROGMEM = {
+  /* imuODR              baroOversampling          log   lora  SF */
+  { LSM6DS3_ODR_208HZ,  BMP280_OVERSAMPLING_X16,  200,  2000, 9 }, // IDLE
+  { LSM6DS3_ODR_1660HZ, BMP280_OVERSAMPLING_X2,   20,   250,  7 }, // BOOST
+  { LSM6DS3_ODR_833HZ,  BMP280_OVERSAMPLING_X4,   20,   250,  7 }, // COAST
+  { LSM6DS3_ODR_833HZ,  BMP280_OVERSAMPLING_X4,   20,   250,  7 }, // APOGEE
+  { LSM6DS3_ODR_208HZ,  BMP280_OVERSAMPLING_X8,   50,   500,  8 }, // DESCENT
+  { LSM6DS3_ODR_26HZ,   BMP280_OVERSAMPLING_X16,  1000, 5000, 9 }  // LANDED
+};
+
+static const char flightNameIdle[] PROGMEM = "IDLE";
+static const char flightNameBoost[] PROGMEM = "BOOST";
+static const char flightNameCoast[] PROGMEM = "COAST";
+static const char flightNameApogee[] PROGMEM = "APOGEE";
+static const char flightNameDescent[] PROGMEM = "DESCENT";
+static const char flightNameLanded[] PROGMEM = "LANDED";
+static const char flightNameUnknown[] PROGMEM = "?";
+
+static const char *const flightPhaseNames[FLIGHT_PHASE_COUNT] PROGMEM = {
+  flightNameIdle, flightNameBoost, flightNameCoast,
+  flightNameApogee, flightNameDescent, flightNameLanded
+};
+
+/**
+ * @brief Switch to a new phase and reset per-phase bookkeeping
+ */
+static uint8_t FLIGHT_Enter(FLIGHT_Handle *fl, FLIGHT_Phase phase, uint32_t nowMs)
+{
+  fl->phase = phase;
+  fl->phaseStartMs = nowMs;
+  fl->confirm = 0;
+  return 1;
+}
+
+void FLIGHT_Init(FLIGHT_Handle *fl, uint32_t nowMs)
+{
+  fl->maxAltitude = 0;
+  fl->stableAltitude = 0;
+  fl->stableSinceMs = nowMs;
+  FLIGHT_Enter(fl, FLIGHT_IDLE, nowMs);
+}
+
+uint8_t FLIGHT_Rearm(FLIGHT_Handle *fl, uint32_t nowMs)
+{
+  if (fl->phase != FLIGHT_LANDED)
+    return 0;
+  FLIGHT_Init(fl, nowMs);
+  return 1;
+}
+
+uint8_t FLIGHT_Update(FLIGHT_Handle *fl, uint32_t nowMs, int32_t altitude,
+                      int32_t velocity, float accelMagSq, uint8_t events)
+{
+  if (altitude > fl->maxAltitude)
+    fl->maxAltitude = altitude;
+
+  switch (fl->phase) {
+    case FLIGHT_IDLE:
+      // Wake-up event or sustained thrust, confirmed over several samples
+      if ((events & FLIGHT_EVT_WAKEUP) ||
+          accelMagSq > FLIGHT_LAUNCH_ACCEL_G * FLIGHT_LAUNCH_ACCEL_G) {
+        if (++fl->confirm >= FLIGHT_LAUNCH_CONFIRM) {
+          fl->maxAltitude = altitude;
+          return FLIGHT_Enter(fl, FLIGHT_BOOST, nowMs);
+        }
+      } else {
+        fl->confirm = 0;
+      }
+      // Baro backup in case the IMU misses the launch
+      if (altitude > FLIGHT_LAUNCH_ALT_CM)
+        return FLIGHT_Enter(fl, FLIGHT_BOOST, nowMs);
+      break;
+
+    case FLIGHT_BOOST:
+      // Burnout: free-fall flag or thrust dropping below 1 g
+      if ((events & FLIGHT_EVT_FREEFALL) ||
+          accelMagSq < FLIGHT_BURNOUT_ACCEL_G * FLIGHT_BURNOUT_ACCEL_G ||
+          nowMs - fl->phaseStartMs >= FLIGHT_BOOST_MAX_MS)
+        return FLIGHT_Enter(fl, FLIGHT_COAST, nowMs);
+      break;
+
+    case FLIGHT_COAST:
+      // Apogee: velocity crossing zero or altitude below peak for several samples
+      if (velocity <= FLIGHT_APOGEE_VEL_CMS ||
+          altitude < fl->maxAltitude - FLIGHT_APOGEE_DROP_CM) {
+        if (++fl->confirm >= FLIGHT_APOGEE_CONFIRM)
+          return FLIGHT_Enter(fl, FLIGHT_APOGEE, nowMs);
+      } else {
+        fl->confirm = 0;
+      }
+      break;
+
+    case FLIGHT_APOGEE:
+      if (nowMs - fl->phaseStartMs >= FLIGHT_APOGEE_HOLD_MS) {
+        fl->stableAltitude = altitude;
+        fl->stableSinceMs = nowMs;
+        return FLIGHT_Enter(fl, FLIGHT_DESCENT, nowMs);
+      }
+      break;
+
+    case FLIGHT_DESCENT:
+      // Landed: altitude stays within a band long enough
+      if (altitude > fl->stableAltitude + FLIGHT_LANDED_BAND_CM ||
+          altitude < fl->stableAltitude - FLIGHT_LANDED_BAND_CM) {
+        fl->stableAltitude = altitude;
+        fl->stableSinceMs = nowMs;
+      } else if (nowMs - fl->stableSinceMs >= FLIGHT_LANDED_MS) {
+        fl->stableSinceMs = nowMs;
+        return FLIGHT_Enter(fl, FLIGHT_LANDED, nowMs);
+      }
+      break;
+
+    case FLIGHT_LANDED:
+      // Re-arm once left at rest; being carried (wake-up) restarts the wait
+      if ((events & FLIGHT_EVT_WAKEUP) ||
+          altitude > fl->stableAltitude + FLIGHT_LANDED_BAND_CM ||
+          altitude < fl->stableAltitude - FLIGHT_LANDED_BAND_CM) {
+        fl->stableAltitude = altitude;
+        fl->stableSinceMs = nowMs;
+      } else if (FLIGHT_REARM_MS && nowMs - fl->stableSinceMs >= FLIGHT_REARM_MS) {
+        return FLIGHT_Rearm(fl, nowMs);
+      }
+      break;
+
+    default:
+      break;
+  }
+
+  return 0;
+}
+
+void FLIGHT_GetProfile(FLIGHT_Phase phase, FLIGHT_Profile *profile)
+{
+  if (phase >= FLIGHT_PHASE_COUNT)
+    phase = FLIGHT_IDLE;
+  memcpy_P(profile, &flightProfiles[phase], sizeof(FLIGHT_Profile));
+}
+
+const char *FLIGHT_PhaseName(FLIGHT_Phase phase)
+{
+  if (phase >= FLIGHT_PHASE_COUNT)
+    return flightNameUnknown;
+  return (const char *)pgm_read_word(&flightPhaseNames[phase]);
+}
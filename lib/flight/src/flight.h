@@ -0,0 +1,144 @@
+/**
+ * @file flight.h
+ * @brief Flight-phase state machine with per-phase acquisition profiles
+ * @author Nate Hunter
+ * @date 2025-07-20
+ * @version v1.0.0
+ */
+
+#ifndef FLIGHT_H
+#define FLIGHT_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup FLIGHT_Config Detection thresholds
+ * @{
+ */
+#ifndef FLIGHT_LAUNCH_ACCEL_G
+#define FLIGHT_LAUNCH_ACCEL_G     2.5f   ///< Acceleration magnitude that arms launch detection (g)
+#endif
+#ifndef FLIGHT_LAUNCH_ALT_CM
+#define FLIGHT_LAUNCH_ALT_CM      1000   ///< Baro-only launch backup: altitude above pad (cm)
+#endif
+#ifndef FLIGHT_LAUNCH_CONFIRM
+#define FLIGHT_LAUNCH_CONFIRM     3      ///< Consecutive samples required to confirm launch
+#endif
+#ifndef FLIGHT_BURNOUT_ACCEL_G
+#define FLIGHT_BURNOUT_ACCEL_G    1.0f   ///< Acceleration magnitude below which motor is considered burnt out (g)
+#endif
+#ifndef FLIGHT_BOOST_MAX_MS
+#define FLIGHT_BOOST_MAX_MS       10000  ///< Forced boost -> coast transition (ms)
+#endif
+#ifndef FLIGHT_APOGEE_DROP_CM
+#define FLIGHT_APOGEE_DROP_CM     150    ///< Altitude loss below peak that confirms apogee (cm)
+#endif
+#ifndef FLIGHT_APOGEE_CONFIRM
+#define FLIGHT_APOGEE_CONFIRM     3      ///< Consecutive descending samples required for apogee
+#endif
+#ifndef FLIGHT_APOGEE_VEL_CMS
+#define FLIGHT_APOGEE_VEL_CMS     0      ///< Vertical velocity at or below which apogee is reached (cm/s)
+#endif
+#ifndef FLIGHT_APOGEE_HOLD_MS
+#define FLIGHT_APOGEE_HOLD_MS     1000   ///< Time spent in APOGEE before switching to DESCENT (ms)
+#endif
+#ifndef FLIGHT_LANDED_BAND_CM
+#define FLIGHT_LANDED_BAND_CM     200    ///< Altitude band considered stationary (cm)
+#endif
+#ifndef FLIGHT_LANDED_MS
+#define FLIGHT_LANDED_MS          5000   ///< Time altitude must stay in band to declare landing (ms)
+#endif
+#ifndef FLIGHT_REARM_MS
+#define FLIGHT_REARM_MS           300000UL ///< Time at rest after landing before re-arming on the pad (ms), 0 = command only
+#endif
+/** @} */
+
+/** @brief IMU embedded-function event flags passed to FLIGHT_Update() */
+#define FLIGHT_EVT_WAKEUP    (1 << 0)   ///< LSM6DS3 wake-up (acceleration slope) event
+#define FLIGHT_EVT_FREEFALL  (1 << 1)   ///< LSM6DS3 free-fall event
+
+/** @brief Flight phases */
+typedef enum {
+  FLIGHT_IDLE = 0,
+  FLIGHT_BOOST,
+  FLIGHT_COAST,
+  FLIGHT_APOGEE,
+  FLIGHT_DESCENT,
+  FLIGHT_LANDED,
+  FLIGHT_PHASE_COUNT
+} FLIGHT_Phase;
+
+/**
+ * @brief Acquisition profile applied while a phase is active
+ */
+typedef struct {
+  uint8_t imuODR;           /**< LSM6DS3_ODR for accelerometer and gyroscope */
+  uint8_t baroOversampling; /**< BMP280_Oversampling for pressure */
+  uint16_t logPeriodMs;     /**< Sensor read / log period (ms) */
+  uint16_t loraPeriodMs;    /**< LoRa telemetry period (ms) */
+  uint8_t loraSF;           /**< LoRa spreading factor */
+} FLIGHT_Profile;
+
+/**
+ * @brief Flight state machine handle
+ */
+typedef struct {
+  FLIGHT_Phase phase;       /**< Current phase */
+  uint32_t phaseStartMs;    /**< Timestamp of last transition (ms) */
+  int32_t maxAltitude;      /**< Highest altitude seen since launch (cm) */
+  int32_t stableAltitude;   /**< Reference altitude for landing detection (cm) */
+  uint32_t stableSinceMs;   /**< Time altitude entered the stationary band (ms) */
+  uint8_t confirm;          /**< Consecutive-sample counter for the pending transition */
+} FLIGHT_Handle;
+
+/**
+ * @brief Reset the state machine to IDLE
+ * @param fl Pointer to flight handle
+ * @param nowMs Current time (ms)
+ */
+void FLIGHT_Init(FLIGHT_Handle *fl, uint32_t nowMs);
+
+/**
+ * @brief Re-arm a landed recorder: back to IDLE with a fresh peak altitude
+ * @param fl Pointer to flight handle
+ * @param nowMs Current time (ms)
+ * @return 1 if the phase changed (was LANDED), 0 otherwise
+ * @note The caller re-zeroes the altitude, the landing site is the new pad.
+ */
+uint8_t FLIGHT_Rearm(FLIGHT_Handle *fl, uint32_t nowMs);
+
+/**
+ * @brief Feed one sample into the state machine
+ * @param fl Pointer to flight handle
+ * @param nowMs Sample timestamp (ms)
+ * @param altitude Altitude above pad (cm)
+ * @param velocity Vertical velocity estimate (cm/s)
+ * @param accelMagSq Squared acceleration magnitude (g^2)
+ * @param events FLIGHT_EVT_* flags latched by the IMU since the last call
+ * @return 1 if the phase changed, 0 otherwise
+ */
+uint8_t FLIGHT_Update(FLIGHT_Handle *fl, uint32_t nowMs, int32_t altitude,
+                      int32_t velocity, float accelMagSq, uint8_t events);
+
+/**
+ * @brief Get the acquisition profile of a phase
+ * @param phase Flight phase
+ * @param[out] profile Profile copied from flash
+ */
+void FLIGHT_GetProfile(FLIGHT_Phase phase, FLIGHT_Profile *profile);
+
+/**
+ * @brief Get a short printable name of a phase
+ * @param phase Flight phase
+ * @return Pointer to a string in flash
+ */
+const char *FLIGHT_PhaseName(FLIGHT_Phase phase);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FLIGHT_H */
@@ -0,0 +1,159 @@
+/**
+ * @file fmt.c
+ * @brief Lightweight integer / fixed-point to ASCII formatting
+ * @author Nate Hunter
+ * @date 2025-07-27
+ * @version v1.0.0
+ */
+
+#include "fmt.h"
+#include <avr/pgmspace.h>
+#include <string.h>
+
+static const uint32_t fmtPow10[10] PROGMEM = {
+  1UL, 10UL, 100UL, 1000UL, 10000UL, 100000UL, 1000000UL, 10000000UL, 100000000UL, 1000000000UL
+};
+
+char *FMT_Str(char *p, const char *s)
+{
+  while (*s)
+    *p++ = *s++;
+  return p;
+}
+
+char *FMT_StrP(char *p, const char *s)
+{
+  char c;
+  while ((c = (char)pgm_read_byte(s++)))
+    *p++ = c;
+  return p;
+}
+
+char *FMT_UInt(char *p, uint32_t v)
+{
+  char tmp[10];
+  uint8_t n = 0;
+
+  // 32-bit division only while the value needs it, 16-bit for the low digits
+  while (v > 0xFFFF) {
+    tmp[n++] = (char)('0' + v % 10);
+    v /= 10;
+  }
+  uint16_t w = (uint16_t)v;
+  do {
+    tmp[n++] = (char)('0' + w % 10);
+    w /= 10;
+  } while (w);
+
+  while (n)
+    *p++ = tmp[--n];
+  return p;
+}
+
+char *FMT_Int(char *p, int32_t v)
+{
+  if (v < 0) {
+    *p++ = '-';
+    return FMT_UInt(p, (uint32_t)0 - (uint32_t)v);
+  }
+  return FMT_UInt(p, (uint32_t)v);
+}
+
+char *FMT_Fixed(char *p, int32_t v, uint8_t decimals)
+{
+  if (!decimals)
+    return FMT_Int(p, v);
+
+  uint32_t u = v < 0 ? (uint32_t)0 - (uint32_t)v : (uint32_t)v;
+  uint32_t div = pgm_read_dword(&fmtPow10[decimals]);
+  uint32_t frac = u % div;
+
+  if (v < 0)
+    *p++ = '-';
+  p = FMT_UInt(p, u / div);
+  *p++ = '.';
+
+  // Zero-padded fraction
+  for (uint8_t d = decimals; d; d--) {
+    uint32_t pw = pgm_read_dword(&fmtPow10[d - 1]);
+    uint8_t digit = 0;
+    while (frac >= pw) {
+      frac -= pw;
+      digit++;
+    }
+    *p++ = (char)('0' + digit);
+  }
+  return p;
+}
+
+char *FMT_Hex8(char *p, uint8_t v)
+{
+  static const char hex[] PROGMEM = "0123456789ABCDEF";
+  *p++ = (char)pgm_read_byte(&hex[v >> 4]);
+  *p++ = (char)pgm_read_byte(&hex[v & 0x0F]);
+  return p;
+}
+
+char *FMT_End(char *p)
+{
+  *p++ = '\n';
+  *p = '\0';
+  return p;
+}
+
+uint8_t FMT_Record(char *buf, const char *prefix, const void *rec,
+                   const FMT_Field *fields, uint8_t count, const uint32_t *scales)
+{
+  const uint8_t *base = (const uint8_t *)rec;
+  char *p = buf;
+  FMT_Field f;
+
+  if (prefix)
+    p = FMT_StrP(p, prefix);
+
+  for (uint8_t i = 0; i < count; i++) {
+    memcpy_P(&f, &fields[i], sizeof(FMT_Field));
+    const void *val = base + f.offset;
+    int32_t v;
+    uint32_t u;
+
+    p = FMT_Str(p, f.label);
+    *p++ = '\t';
+
+    switch (f.type) {
+      case FMT_U32:
+        if (f.decimals) {
+          p = FMT_Fixed(p, (int32_t)*(const uint32_t *)val, f.decimals);
+        } else {
+          p = FMT_UInt(p, *(const uint32_t *)val);
+        }
+        break;
+      case FMT_I32:
+        p = FMT_Fixed(p, *(const int32_t *)val, f.decimals);
+        break;
+      case FMT_I16:
+        p = FMT_Fixed(p, *(const int16_t *)val, f.decimals);
+        break;
+      case FMT_U8:
+        p = FMT_UInt(p, *(const uint8_t *)val);
+        break;
+      case FMT_I16_SCALED:
+        // |raw| * (micro-units / LSB) / 10^4 = hundredths; unsigned, since
+        // 32768 * 70000 udps/LSB (2000 dps) does not fit an int32_t
+        v = *(const int16_t *)val;
+        u = (uint32_t)(v < 0 ? -v : v) * (scales ? scales[f.decimals] : 1UL) / 10000UL;
+        p = FMT_Fixed(p, v < 0 ? -(int32_t)u : (int32_t)u, 2);
+        break;
+      default:
+        break;
+    }
+
+    p = FMT_Str(p, f.unit);
+    *p++ = '\t';
+  }
+
+  // Replace the trailing tab by the line end
+  if (p > buf && p[-1] == '\t')
+    p--;
+  return (uint8_t)(FMT_End(p) - buf);
+}
@@ -0,0 +1,89 @@
+/**
+ * @file fmt.h
+ * @brief Lightweight integer / fixed-point to ASCII formatting (printf-free)
+ * @author Nate Hunter
+ * @date 2025-07-27
+ * @version v1.0.0
+ *
+ * All routines write into a caller buffer and return a pointer past the
+ * last character written; nothing is NUL-terminated except by FMT_End().
+ */
+
+#ifndef FMT_H
+#define FMT_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Field value types for FMT_Record() */
+typedef enum {
+  FMT_U32 = 0,     ///< uint32_t
+  FMT_I32,         ///< int32_t
+  FMT_I16,         ///< int16_t
+  FMT_U8,          ///< uint8_t
+  FMT_I16_SCALED   ///< int16_t in LSB, times scales[decimals] micro-units per LSB
+} FMT_Type;
+
+/**
+ * @brief Field descriptor (stored in PROGMEM)
+ *
+ * A field is printed as "<label>\t<value><unit>\t". Integer fields with
+ * decimals > 0 are treated as fixed point (2345 with 2 decimals -> 23.45).
+ * FMT_I16_SCALED fields hold raw LSB and a scale in micro-units per LSB;
+ * they are printed with two decimals.
+ */
+typedef struct {
+  char label[6];     /**< Label, e.g. "Ax:" */
+  char unit[5];      /**< Unit suffix, e.g. "Pa" */
+  uint8_t offset;    /**< Byte offset of the value in the record */
+  uint8_t type;      /**< FMT_Type */
+  uint8_t decimals;  /**< Fixed-point decimals, or scale index for FMT_I16_SCALED */
+} FMT_Field;
+
+/** @brief Write a NUL-terminated RAM string */
+char *FMT_Str(char *p, const char *s);
+
+/** @brief Write a NUL-terminated PROGMEM string */
+char *FMT_StrP(char *p, const char *s);
+
+/** @brief Write an unsigned decimal */
+char *FMT_UInt(char *p, uint32_t v);
+
+/** @brief Write a signed decimal */
+char *FMT_Int(char *p, int32_t v);
+
+/**
+ * @brief Write a fixed-point value
+ * @param p Output pointer
+ * @param v Value scaled by 10^decimals
+ * @param decimals Digits after the point (0-9)
+ */
+char *FMT_Fixed(char *p, int32_t v, uint8_t decimals);
+
+/** @brief Write two hex digits */
+char *FMT_Hex8(char *p, uint8_t v);
+
+/** @brief Write a newline and NUL terminator, return pointer to the NUL */
+char *FMT_End(char *p);
+
+/**
+ * @brief Format a record through a descriptor table into one text line
+ * @param buf Output buffer (must hold the longest line)
+ * @param prefix PROGMEM prefix written first (may be NULL)
+ * @param rec Pointer to the record
+ * @param fields PROGMEM descriptor table
+ * @param count Number of descriptors
+ * @param scales Micro-units per LSB for FMT_I16_SCALED fields (may be NULL)
+ * @return Line length excluding the NUL
+ */
+uint8_t FMT_Record(char *buf, const char *prefix, const void *rec,
+                   const FMT_Field *fields, uint8_t count, const uint32_t *scales);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FMT_H */
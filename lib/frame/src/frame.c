@@ -0,0 +1,87 @@
+/**
+ * @file frame.c
+ * @brief COBS-framed binary records implementation
+ * @author Nate Hunter
+ * @date 2025-07-26
+ * @version v1.0.0
+ */
+
+#include "frame.h"
+#include "crc16.h"
+#include "uart.h"
+#include <string.h>
+
+/* Private variables */
+static uint16_t frameSeq;        ///< Sequence number of the next frame
+static FRAME_StoreFn frameStore; ///< Storage sink, NULL if none
+
+/* Private functions */
+
+static uint8_t FRAME_Encode(uint8_t type, const void *payload, uint8_t len,
+                            FRAME_StoreFn store, uint8_t toUart)
+{
+  // buf[0] is the first COBS code, the frame follows from buf[1]
+  uint8_t buf[FRAME_MAX_PAYLOAD + 7];
+
+  if (len > FRAME_MAX_PAYLOAD)
+    return 0;
+
+  uint8_t n = 1;
+  buf[n++] = type;
+  buf[n++] = (uint8_t)frameSeq;
+  buf[n++] = (uint8_t)(frameSeq >> 8);
+  memcpy(&buf[n], payload, len);
+  n += len;
+  uint16_t crc = CRC16_Compute(&buf[1], n - 1);
+  buf[n++] = (uint8_t)crc;
+  buf[n++] = (uint8_t)(crc >> 8);
+  frameSeq++;
+
+  // COBS in place: each zero is replaced by the distance to the next one,
+  // the slot in front of the frame takes the first distance; frames are
+  // short, so no block reaches 254
+  uint8_t code = 0;
+  for (uint8_t i = 1; i < n; i++) {
+    if (!buf[i]) {
+      buf[code] = i - code;
+      code = i;
+    }
+  }
+  buf[code] = n - code;
+  buf[n++] = 0x00;
+
+  if (store)
+    store(type, buf, n);
+  if (toUart) {
+    for (uint8_t i = 0; i < n; i++)
+      UART_Transmit(buf[i]);
+  }
+  return 1;
+}
+
+/* Public functions */
+
+uint8_t FRAME_Send(uint8_t type, const void *payload, uint8_t len)
+{
+  return FRAME_Encode(type, payload, len, 0, 1);
+}
+
+uint8_t FRAME_Log(uint8_t type, const void *payload, uint8_t len, uint8_t toUart)
+{
+  return FRAME_Encode(type, payload, len, frameStore, toUart);
+}
+
+void FRAME_SetStore(FRAME_StoreFn fn)
+{
+  frameStore = fn;
+}
+
+uint16_t FRAME_GetSequence(void)
+{
+  return frameSeq;
+}
+
+void FRAME_SetSequence(uint16_t seq)
+{
+  frameSeq = seq;
+}
@@ -0,0 +1,96 @@
+/**
+ * @file frame.h
+ * @brief COBS-framed binary records with sequence number and CRC-16 over UART
+ * @author Nate Hunter
+ * @date 2025-07-26
+ * @version v1.0.0
+ *
+ * Frame before encoding: type (1) | seq (2, LE) | payload (n) | crc16 (2, LE)
+ * The CRC (CRC-16/CCITT-FALSE) covers type, seq and payload. The frame is
+ * COBS-encoded and terminated by a single 0x00, so a host can resync on
+ * any zero byte and detect lost frames from gaps in seq.
+ *
+ * FRAME_Log() additionally hands the encoded bytes to a storage sink
+ * (FRAME_SetStore), so the same self-delimiting stream is recorded on the
+ * flight log whether or not the UART is in binary mode.
+ */
+
+#ifndef FRAME_H
+#define FRAME_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FRAME_MAX_PAYLOAD  64    ///< Largest payload accepted by FRAME_Send()
+
+/** @brief Record types */
+typedef enum {
+  FRAME_TYPE_INFO    = 0x01,  ///< Scale factors and boot information
+  FRAME_TYPE_SAMPLE  = 0x02,  ///< Live sensor sample
+  FRAME_TYPE_PRETRIG = 0x03,  ///< Pre-trigger sample flushed at launch
+  FRAME_TYPE_EVENT   = 0x04,  ///< Flight-phase transition
+  FRAME_TYPE_VIB     = 0x05,  ///< Vibration spectrum summary
+  FRAME_TYPE_TRACE   = 0x06,  ///< Bus transaction trace entry
+  FRAME_TYPE_POST    = 0x07,  ///< Power-on self-test report
+  FRAME_TYPE_BOOT    = 0x08,  ///< Boot pipeline timing
+  FRAME_TYPE_GAP     = 0x09,  ///< Warm restart: data lost before this record
+  FRAME_TYPE_STORAGE = 0x0A,  ///< SD log file and write benchmark
+  FRAME_TYPE_DROP    = 0x0B,  ///< Log queue overrun counters
+  FRAME_TYPE_SAMPLE_DELTA = 0x0C, ///< Live sample coded against the previous one
+  FRAME_TYPE_POWER   = 0x0D,  ///< Battery voltage, current, charge and endurance
+  FRAME_TYPE_HEALTH  = 0x0E   ///< Sensor health states and error counts
+} FRAME_Type;
+
+/**
+ * @brief Storage sink, called once per frame
+ * @param type Record type, e.g. to pick a drop priority
+ * @param data Encoded frame including the trailing 0x00
+ * @param len Encoded length (payload + 7)
+ */
+typedef void (*FRAME_StoreFn)(uint8_t type, const uint8_t *data, uint8_t len);
+
+/**
+ * @brief Encode and queue one frame on the UART
+ * @param type Record type
+ * @param payload Pointer to payload
+ * @param len Payload length (<= FRAME_MAX_PAYLOAD)
+ * @return 1 if queued, 0 if the payload is too long
+ */
+uint8_t FRAME_Send(uint8_t type, const void *payload, uint8_t len);
+
+/**
+ * @brief Encode one frame to the storage sink and optionally the UART
+ * @param type Record type
+ * @param payload Pointer to payload
+ * @param len Payload length (<= FRAME_MAX_PAYLOAD)
+ * @param toUart Also queue the frame on the UART
+ * @return 1 if encoded, 0 if the payload is too long
+ */
+uint8_t FRAME_Log(uint8_t type, const void *payload, uint8_t len, uint8_t toUart);
+
+/**
+ * @brief Set the storage sink used by FRAME_Log()
+ * @param fn Sink, or NULL for none
+ */
+void FRAME_SetStore(FRAME_StoreFn fn);
+
+/**
+ * @brief Get the sequence number the next frame will carry
+ * @return Sequence number
+ */
+uint16_t FRAME_GetSequence(void);
+
+/**
+ * @brief Continue numbering from @p seq (warm restart)
+ * @param seq Sequence number of the next frame
+ */
+void FRAME_SetSequence(uint16_t seq);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FRAME_H */
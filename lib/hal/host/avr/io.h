@@ -0,0 +1,99 @@
+/**
+ * @file io.h
+ * @brief Host stand-in for <avr/io.h>: ATmega328P registers used by the
+ *        drivers, at their data-space addresses in a RAM register file
+ * @author Nate Hunter
+ * @date 2025-08-20
+ * @version v1.0.0
+ */
+
+#ifndef HAL_HOST_AVR_IO_H
+#define HAL_HOST_AVR_IO_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HAL_REG_SPACE 0x100   ///< I/O and extended I/O space
+
+extern volatile uint8_t HAL_Regs[HAL_REG_SPACE];
+
+#define _SFR_MEM8(addr) (HAL_Regs[(addr)])
+#define _SFR_IO8(addr)  _SFR_MEM8((addr) + 0x20)
+
+/* GPIO */
+#define PINB    _SFR_IO8(0x03)
+#define DDRB    _SFR_IO8(0x04)
+#define PORTB   _SFR_IO8(0x05)
+#define PINC    _SFR_IO8(0x06)
+#define DDRC    _SFR_IO8(0x07)
+#define PORTC   _SFR_IO8(0x08)
+#define PIND    _SFR_IO8(0x09)
+#define DDRD    _SFR_IO8(0x0A)
+#define PORTD   _SFR_IO8(0x0B)
+
+#define PB0 0
+#define PB1 1
+#define PB2 2
+#define PB3 3
+#define PB4 4
+#define PB5 5
+#define PB6 6
+#define PB7 7
+#define PC0 0
+#define PC1 1
+#define PC2 2
+#define PC3 3
+#define PC4 4
+#define PC5 5
+#define PD0 0
+#define PD1 1
+#define PD2 2
+#define PD3 3
+#define PD4 4
+#define PD5 5
+#define PD6 6
+#define PD7 7
+
+/* SPI */
+#define SPCR    _SFR_IO8(0x2C)
+#define SPSR    _SFR_IO8(0x2D)
+#define SPDR    _SFR_IO8(0x2E)
+
+#define SPR0  0
+#define SPR1  1
+#define CPHA  2
+#define CPOL  3
+#define MSTR  4
+#define DORD  5
+#define SPE   6
+#define SPIE  7
+#define SPI2X 0
+#define WCOL  6
+#define SPIF  7
+
+/* Status register */
+#define SREG    _SFR_IO8(0x3F)
+
+/* TWI */
+#define TWBR    _SFR_MEM8(0xB8)
+#define TWSR    _SFR_MEM8(0xB9)
+#define TWAR    _SFR_MEM8(0xBA)
+#define TWDR    _SFR_MEM8(0xBB)
+#define TWCR    _SFR_MEM8(0xBC)
+
+#define TWIE  0
+#define TWEN  2
+#define TWWC  3
+#define TWSTO 4
+#define TWSTA 5
+#define TWEA  6
+#define TWINT 7
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_HOST_AVR_IO_H */
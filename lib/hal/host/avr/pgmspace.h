@@ -0,0 +1,32 @@
+/**
+ * @file pgmspace.h
+ * @brief Host stand-in for <avr/pgmspace.h>: flash data is ordinary const
+ *        data, so the accessors are plain reads
+ * @author Nate Hunter
+ * @date 2025-08-20
+ * @version v1.0.0
+ *
+ * pgm_read_word() dereferences with the element type, so the tables of
+ * pointers read with it on AVR (16-bit) also work with 64-bit pointers.
+ */
+
+#ifndef HAL_HOST_AVR_PGMSPACE_H
+#define HAL_HOST_AVR_PGMSPACE_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PGM_P               const char *
+#define PSTR(s)             (s)
+
+#define pgm_read_byte(addr)   ((uint8_t)*(addr))
+#define pgm_read_word(addr)   (*(addr))
+#define pgm_read_dword(addr)  ((uint32_t)*(addr))
+
+#define memcpy_P   memcpy
+#define strcpy_P   strcpy
+#define strlen_P   strlen
+#define strcmp_P   strcmp
+
+#endif /* HAL_HOST_AVR_PGMSPACE_H */
@@ -0,0 +1,86 @@
+/**
+ * @file hal.h
+ * @brief Register access layer: AVR registers on target, a simulated
+ *        register file with bus models on the host
+ * @author Nate Hunter
+ * @date 2025-08-20
+ * @version v1.0.0
+ *
+ * Drivers keep using the ATmega328P register names. Registers whose access
+ * has a side effect in hardware (starting a TWI or SPI transfer, flags
+ * cleared by a read) go through HAL_READ / HAL_WRITE; plain configuration
+ * and GPIO registers are used directly.
+ *
+ * On AVR both macros are the bare register access, so the generated code
+ * is unchanged. The host backend (env:native, -I lib/hal/host) maps the
+ * register names onto HAL_Regs at their data-space addresses and routes
+ * HAL_READ / HAL_WRITE through HAL_HostRead / HAL_HostWrite, where TWI and
+ * SPI transfers complete at once against attached device models.
+ */
+
+#ifndef HAL_H
+#define HAL_H
+
+#include <stdint.h>
+#include <avr/io.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(__AVR__)
+
+#define HAL_READ(reg)       (reg)
+#define HAL_WRITE(reg, v)   ((reg) = (v))
+
+#else
+
+#define HAL_READ(reg)       HAL_HostRead(&(reg))
+#define HAL_WRITE(reg, v)   HAL_HostWrite(&(reg), (uint8_t)(v))
+
+/**
+ * @brief Simulated I2C target
+ */
+typedef struct {
+  uint8_t addr;                          /**< 7-bit address */
+  uint8_t (*write)(void *ctx, uint8_t data, uint8_t first); /**< Byte from the master; first = right after the address. Returns 1 for ACK */
+  uint8_t (*read)(void *ctx);            /**< Next byte for the master */
+  void *ctx;                             /**< Passed to the callbacks */
+} HAL_TwiDevice;
+
+/**
+ * @brief Simulated SPI bus: exchanges one byte. The selected device is
+ *        the one whose chip-select pin is low in HAL_Regs.
+ */
+typedef uint8_t (*HAL_SpiExchange)(void *ctx, uint8_t mosi);
+
+/**
+ * @brief Clear the register file, the bus models and the fault switches
+ */
+void HAL_HostReset(void);
+
+/**
+ * @brief Attach I2C targets (the array must outlive the bus)
+ */
+void HAL_HostTwiAttach(const HAL_TwiDevice *devices, uint8_t count);
+
+/**
+ * @brief Hold SCL low: TWINT never sets, so the driver runs into its timeout
+ */
+void HAL_HostTwiStall(uint8_t stall);
+
+/**
+ * @brief Attach the SPI bus model; without one MISO reads 0xFF
+ */
+void HAL_HostSpiAttach(HAL_SpiExchange exchange, void *ctx);
+
+uint8_t HAL_HostRead(volatile uint8_t *reg);
+void HAL_HostWrite(volatile uint8_t *reg, uint8_t value);
+
+#endif /* __AVR__ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_H */
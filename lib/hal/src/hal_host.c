@@ -0,0 +1,161 @@
+/**
+ * @file hal_host.c
+ * @brief Host backend: register file and instant TWI / SPI bus models
+ * @author Nate Hunter
+ * @date 2025-08-20
+ * @version v1.0.0
+ */
+
+#include "hal.h"
+
+#if !defined(__AVR__)
+
+#include <string.h>
+
+#define HAL_TWI_START        0x08   ///< TWSR status codes (util/twi.h)
+#define HAL_TWI_REP_START    0x10
+#define HAL_TWI_MT_SLA_ACK   0x18
+#define HAL_TWI_MT_SLA_NACK  0x20
+#define HAL_TWI_MT_DATA_ACK  0x28
+#define HAL_TWI_MT_DATA_NACK 0x30
+#define HAL_TWI_MR_SLA_ACK   0x40
+#define HAL_TWI_MR_SLA_NACK  0x48
+#define HAL_TWI_MR_DATA_ACK  0x50
+#define HAL_TWI_MR_DATA_NACK 0x58
+
+/** @brief TWI master state between two TWCR writes */
+typedef enum {
+  HAL_TWI_IDLE = 0,
+  HAL_TWI_STARTED,     ///< START sent, address byte next
+  HAL_TWI_WRITING,     ///< Addressed for write
+  HAL_TWI_READING,     ///< Addressed for read
+  HAL_TWI_IGNORED      ///< No target answered the address
+} HAL_TwiState;
+
+volatile uint8_t HAL_Regs[HAL_REG_SPACE];
+
+static const HAL_TwiDevice *halTwiDevices;
+static uint8_t halTwiCount;
+static const HAL_TwiDevice *halTwiTarget;
+static uint8_t halTwiState;
+static uint8_t halTwiFirst;
+static uint8_t halTwiStall;
+
+static HAL_SpiExchange halSpiExchange;
+static void *halSpiCtx;
+
+/* Private helpers */
+
+static const HAL_TwiDevice *HAL_TwiFind(uint8_t addr)
+{
+  for (uint8_t i = 0; i < halTwiCount; i++)
+    if (halTwiDevices[i].addr == addr)
+      return &halTwiDevices[i];
+  return NULL;
+}
+
+/**
+ * @brief One TWI step, started by writing TWCR with TWINT set
+ * @return New TWSR status
+ */
+static uint8_t HAL_TwiStep(uint8_t cr)
+{
+  if (cr & (1 << TWSTA)) {
+    uint8_t repeated = halTwiState != HAL_TWI_IDLE;
+    halTwiState = HAL_TWI_STARTED;
+    return repeated ? HAL_TWI_REP_START : HAL_TWI_START;
+  }
+
+  uint8_t data = TWDR;
+  switch (halTwiState) {
+    case HAL_TWI_STARTED:
+      halTwiTarget = HAL_TwiFind(data >> 1);
+      halTwiFirst = 1;
+      if (!halTwiTarget) {
+        halTwiState = HAL_TWI_IGNORED;
+        return data & 1 ? HAL_TWI_MR_SLA_NACK : HAL_TWI_MT_SLA_NACK;
+      }
+      halTwiState = data & 1 ? HAL_TWI_READING : HAL_TWI_WRITING;
+      return data & 1 ? HAL_TWI_MR_SLA_ACK : HAL_TWI_MT_SLA_ACK;
+
+    case HAL_TWI_WRITING: {
+      uint8_t ack = !halTwiTarget->write || halTwiTarget->write(halTwiTarget->ctx, data, halTwiFirst);
+      halTwiFirst = 0;
+      return ack ? HAL_TWI_MT_DATA_ACK : HAL_TWI_MT_DATA_NACK;
+    }
+
+    case HAL_TWI_READING:
+      TWDR = halTwiTarget->read ? halTwiTarget->read(halTwiTarget->ctx) : 0xFF;
+      return cr & (1 << TWEA) ? HAL_TWI_MR_DATA_ACK : HAL_TWI_MR_DATA_NACK;
+
+    default:
+      // Nobody drives SDA: reads see the pull-ups
+      TWDR = 0xFF;
+      return HAL_TWI_MT_DATA_NACK;
+  }
+}
+
+/* Public functions */
+
+void HAL_HostReset(void)
+{
+  memset((void *)HAL_Regs, 0, sizeof(HAL_Regs));
+  halTwiDevices = NULL;
+  halTwiCount = 0;
+  halTwiTarget = NULL;
+  halTwiState = HAL_TWI_IDLE;
+  halTwiStall = 0;
+  halSpiExchange = NULL;
+  halSpiCtx = NULL;
+}
+
+void HAL_HostTwiAttach(const HAL_TwiDevice *devices, uint8_t count)
+{
+  halTwiDevices = devices;
+  halTwiCount = count;
+}
+
+void HAL_HostTwiStall(uint8_t stall)
+{
+  halTwiStall = stall;
+}
+
+void HAL_HostSpiAttach(HAL_SpiExchange exchange, void *ctx)
+{
+  halSpiExchange = exchange;
+  halSpiCtx = ctx;
+}
+
+uint8_t HAL_HostRead(volatile uint8_t *reg)
+{
+  uint8_t value = *reg;
+  // SPIF clears on the SPDR access that follows the SPSR read
+  if (reg == &SPDR)
+    SPSR &= (uint8_t)~(1 << SPIF);
+  return value;
+}
+
+void HAL_HostWrite(volatile uint8_t *reg, uint8_t value)
+{
+  if (reg == &TWCR) {
+    // TWSTO is cleared by the hardware once the STOP is on the bus
+    if (value & (1 << TWSTO)) {
+      halTwiState = HAL_TWI_IDLE;
+      TWCR = value & (uint8_t)~((1 << TWSTO) | (1 << TWINT));
+      return;
+    }
+    // Writing TWINT = 1 clears the flag and starts the next step
+    TWCR = value & (uint8_t)~(1 << TWINT);
+    if ((value & (1 << TWINT)) && (value & (1 << TWEN)) && !halTwiStall) {
+      TWSR = (uint8_t)((TWSR & 0x03) | HAL_TwiStep(value));
+      TWCR |= 1 << TWINT;
+    }
+  } else if (reg == &SPDR) {
+    SPDR = halSpiExchange ? halSpiExchange(halSpiCtx, value) : 0xFF;
+    SPSR |= 1 << SPIF;
+  } else {
+    *reg = value;
+  }
+}
+
+#endif /* !__AVR__ */
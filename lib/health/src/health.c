@@ -0,0 +1,92 @@
+/**
+ * @file health.c
+ * @brief Per-device health state implementation
+ * @author Nate Hunter
+ * @date 2025-08-19
+ * @version v1.0.0
+ */
+
+#include "health.h"
+#include <avr/pgmspace.h>
+
+static const char healthNameOk[] PROGMEM = "ok";
+static const char healthNameDegraded[] PROGMEM = "degraded";
+static const char healthNameFailed[] PROGMEM = "failed";
+
+/* Private helpers */
+
+static void HEALTH_Fail(HEALTH_Device *dev, uint32_t nowMs)
+{
+  dev->state = HEALTH_FAILED;
+  dev->probeMs = HEALTH_PROBE_MIN_MS;
+  dev->nextMs = nowMs + HEALTH_PROBE_MIN_MS;
+}
+
+/* Public functions */
+
+void HEALTH_Init(HEALTH_Device *dev, uint8_t found, uint32_t nowMs)
+{
+  dev->state = HEALTH_OK;
+  dev->fails = 0;
+  dev->good = 0;
+  dev->errors = 0;
+  if (!found)
+    HEALTH_Fail(dev, nowMs);
+}
+
+uint8_t HEALTH_Due(const HEALTH_Device *dev, uint32_t nowMs)
+{
+  return dev->state != HEALTH_FAILED || (int32_t)(nowMs - dev->nextMs) >= 0;
+}
+
+uint8_t HEALTH_Report(HEALTH_Device *dev, uint8_t ok, uint32_t nowMs)
+{
+  uint8_t old = dev->state;
+
+  if (ok) {
+    dev->fails = 0;
+  } else {
+    if (dev->fails < 0xFF)
+      dev->fails++;
+    if (dev->errors < 0xFFFF)
+      dev->errors++;
+  }
+
+  switch (dev->state) {
+    case HEALTH_OK:
+      if (!ok) {
+        dev->state = HEALTH_DEGRADED;
+        dev->good = 0;
+      }
+      break;
+
+    case HEALTH_DEGRADED:
+      if (!ok) {
+        dev->good = 0;
+        if (dev->fails >= HEALTH_FAIL_ERRORS)
+          HEALTH_Fail(dev, nowMs);
+      } else if (++dev->good >= HEALTH_RECOVER_READS) {
+        dev->state = HEALTH_OK;
+      }
+      break;
+
+    default:
+      // Re-probe result: on probation, or wait twice as long
+      if (ok) {
+        dev->state = HEALTH_DEGRADED;
+        dev->good = 0;
+      } else {
+        dev->probeMs = dev->probeMs < HEALTH_PROBE_MAX_MS / 2 ? dev->probeMs << 1 : HEALTH_PROBE_MAX_MS;
+        dev->nextMs = nowMs + dev->probeMs;
+      }
+      break;
+  }
+  return dev->state != old;
+}
+
+const char *HEALTH_StateName(uint8_t state)
+{
+  if (state == HEALTH_OK)
+    return healthNameOk;
+  return state == HEALTH_DEGRADED ? healthNameDegraded : healthNameFailed;
+}
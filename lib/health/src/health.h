@@ -0,0 +1,96 @@
+/**
+ * @file health.h
+ * @brief Per-device health state with exponential-backoff re-probing
+ * @author Nate Hunter
+ * @date 2025-08-19
+ * @version v1.0.0
+ *
+ * The application reports the outcome of every access to a device. A
+ * failed access makes it DEGRADED; HEALTH_FAIL_ERRORS in a row make it
+ * FAILED, after which the device is left alone (no bus timeouts in the
+ * acquisition loop) except for a re-probe, first after
+ * HEALTH_PROBE_MIN_MS and then at doubling intervals up to
+ * HEALTH_PROBE_MAX_MS. A successful probe puts the device back on
+ * probation as DEGRADED; HEALTH_RECOVER_READS good accesses make it OK.
+ */
+
+#ifndef HEALTH_H
+#define HEALTH_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup HEALTH_Config Thresholds
+ * @{
+ */
+#ifndef HEALTH_FAIL_ERRORS
+#define HEALTH_FAIL_ERRORS    4      ///< Consecutive errors that fail a device
+#endif
+#ifndef HEALTH_RECOVER_READS
+#define HEALTH_RECOVER_READS  32     ///< Consecutive good accesses back to OK
+#endif
+#ifndef HEALTH_PROBE_MIN_MS
+#define HEALTH_PROBE_MIN_MS   100    ///< First re-probe after a failure (ms)
+#endif
+#ifndef HEALTH_PROBE_MAX_MS
+#define HEALTH_PROBE_MAX_MS   10000  ///< Longest re-probe interval (ms)
+#endif
+/** @} */
+
+/** @brief Device states */
+typedef enum {
+  HEALTH_OK = 0,
+  HEALTH_DEGRADED,     ///< Recent errors, data still used
+  HEALTH_FAILED        ///< Not accessed except for re-probes
+} HEALTH_State;
+
+/**
+ * @brief Health of one device
+ */
+typedef struct {
+  uint8_t state;       /**< HEALTH_State */
+  uint8_t fails;       /**< Consecutive errors */
+  uint8_t good;        /**< Consecutive good accesses while DEGRADED */
+  uint16_t errors;     /**< Errors and failed probes since boot */
+  uint16_t probeMs;    /**< Current re-probe interval (ms) */
+  uint32_t nextMs;     /**< Time of the next re-probe */
+} HEALTH_Device;
+
+/**
+ * @brief Start tracking a device
+ * @param dev Device
+ * @param found Result of the initial probe; 0 schedules re-probing
+ * @param nowMs Current time (ms)
+ */
+void HEALTH_Init(HEALTH_Device *dev, uint8_t found, uint32_t nowMs);
+
+/**
+ * @brief Whether to access the device now: not FAILED, or FAILED with a
+ *        re-probe due (then the caller probes and reports the result)
+ * @param dev Device
+ * @param nowMs Current time (ms)
+ */
+uint8_t HEALTH_Due(const HEALTH_Device *dev, uint32_t nowMs);
+
+/**
+ * @brief Record the outcome of an access or, while FAILED, of a re-probe
+ * @param dev Device
+ * @param ok 1 if it succeeded
+ * @param nowMs Current time (ms)
+ * @return 1 if the state changed
+ */
+uint8_t HEALTH_Report(HEALTH_Device *dev, uint8_t ok, uint32_t nowMs);
+
+/**
+ * @brief Short state name from flash ("ok", "degraded", "failed")
+ */
+const char *HEALTH_StateName(uint8_t state);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HEALTH_H */
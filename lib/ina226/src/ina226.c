@@ -0,0 +1,108 @@
+/**
+ * @file ina226.c
+ * @brief INA226 power monitor driver implementation
+ * @author Nate Hunter
+ * @date 2025-08-18
+ * @version v1.0.0
+ */
+
+#include "ina226.h"
+#include "twi.h"
+
+#define INA226_MODE_CONT_BOTH 0x07   ///< Shunt and bus, continuous
+
+/* Private helpers */
+
+static uint8_t INA226_Write(const INA226_Handle *ina, uint8_t reg, uint16_t value)
+{
+  uint8_t tx[2] = { (uint8_t)(value >> 8), (uint8_t)value };
+  return IIC_WriteBytes(ina->addr, reg, tx, 2) == IIC_SUCCESS;
+}
+
+static uint8_t INA226_Get(const INA226_Handle *ina, uint8_t reg, uint16_t *value)
+{
+  uint8_t rx[2];
+  if (IIC_ReadBytes(ina->addr, reg, rx, 2) != IIC_SUCCESS)
+    return 0;
+  *value = (uint16_t)rx[0] << 8 | rx[1];
+  return 1;
+}
+
+/* Public functions */
+
+INA226_Status INA226_Init(INA226_Handle *ina)
+{
+  uint16_t id;
+  if (!INA226_Get(ina, INA226_REG_MFG_ID, &id) || id != INA226_MFG_ID)
+    return INA226_ERROR;
+
+  uint32_t cal = 5120000UL / ((uint32_t)ina->currentLsbUa * ina->shuntMilliOhm);
+  if (!cal || cal > 0x7FFF || !INA226_Write(ina, INA226_REG_CALIB, (uint16_t)cal))
+    return INA226_ERROR;
+
+  return INA226_SetTiming(ina, (INA226_Averaging)ina->averaging,
+                          (INA226_ConvTime)ina->busCT, (INA226_ConvTime)ina->shuntCT);
+}
+
+INA226_Status INA226_SetTiming(INA226_Handle *ina, INA226_Averaging averaging,
+                               INA226_ConvTime busCT, INA226_ConvTime shuntCT)
+{
+  ina->averaging = averaging;
+  ina->busCT = busCT;
+  ina->shuntCT = shuntCT;
+
+  uint16_t cfg = (uint16_t)(averaging & 7) << 9 | (uint16_t)(busCT & 7) << 6 |
+                 (uint16_t)(shuntCT & 7) << 3 | INA226_MODE_CONT_BOTH;
+  return INA226_Write(ina, INA226_REG_CONFIG, cfg) ? INA226_OK : INA226_ERROR;
+}
+
+INA226_Status INA226_Read(INA226_Handle *ina)
+{
+  uint16_t bus, current, power;
+  if (!INA226_Get(ina, INA226_REG_BUS, &bus) ||
+      !INA226_Get(ina, INA226_REG_CURRENT, &current) ||
+      !INA226_Get(ina, INA226_REG_POWER, &power))
+    return INA226_ERROR;
+
+  ina->busMv = (uint16_t)(((uint32_t)bus * 5) >> 2);
+  ina->currentMa = (int16_t)((int32_t)(int16_t)current * ina->currentLsbUa / 1000);
+  uint32_t mw = (uint32_t)power * 25 * ina->currentLsbUa / 1000;
+  ina->powerMw = mw > 0xFFFF ? 0xFFFF : (uint16_t)mw;
+  return INA226_OK;
+}
+
+INA226_Status INA226_SetAlert(INA226_Handle *ina, INA226_Alert source, uint16_t limit, uint8_t latch)
+{
+  uint32_t raw;
+  switch (source) {
+    case INA226_ALERT_BUS_UNDER:
+    case INA226_ALERT_BUS_OVER:
+      raw = ((uint32_t)limit * 4 + 2) / 5;                          // 1.25 mV/LSB
+      break;
+    case INA226_ALERT_SHUNT_UNDER:
+    case INA226_ALERT_SHUNT_OVER:
+      raw = (uint32_t)limit * ina->shuntMilliOhm * 2 / 5;           // 2.5 uV/LSB
+      break;
+    case INA226_ALERT_POWER_OVER:
+      raw = (uint32_t)limit * 1000 / (25UL * ina->currentLsbUa);
+      break;
+    default:
+      raw = 0;
+      break;
+  }
+  if (raw > 0x7FFF)
+    raw = 0x7FFF;
+
+  if (!INA226_Write(ina, INA226_REG_LIMIT, (uint16_t)raw) ||
+      !INA226_Write(ina, INA226_REG_MASK, (uint16_t)source | (latch ? INA226_MASK_LEN : 0)))
+    return INA226_ERROR;
+  return INA226_OK;
+}
+
+uint8_t INA226_ReadAlert(INA226_Handle *ina)
+{
+  uint16_t mask;
+  if (!INA226_Get(ina, INA226_REG_MASK, &mask))
+    return 0;
+  return (mask & INA226_MASK_AFF) != 0;
+}
@@ -0,0 +1,153 @@
+/**
+ * @file ina226.h
+ * @brief INA226 bus voltage / current / power monitor I2C driver
+ * @author Nate Hunter
+ * @date 2025-08-18
+ * @version v1.0.0
+ *
+ * Registers are 16-bit big endian. The calibration register is derived
+ * from the shunt resistance and the chosen current resolution, so the
+ * chip reports current and power directly:
+ *   CAL = 0.00512 / (currentLsb * Rshunt) = 5120000 / (uA * mOhm)
+ *   power LSB = 25 * current LSB, bus voltage LSB = 1.25 mV
+ *
+ * ALERT is open drain, active low. With a latched alert the flag stays
+ * set until INA226_ReadAlert() reads it, so a dip between two polls is
+ * still seen even if the pin is not wired.
+ */
+
+#ifndef INA226_H
+#define INA226_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup INA226_Registers Registers
+ * @{
+ */
+#define INA226_REG_CONFIG   0x00
+#define INA226_REG_SHUNT    0x01
+#define INA226_REG_BUS      0x02
+#define INA226_REG_POWER    0x03
+#define INA226_REG_CURRENT  0x04
+#define INA226_REG_CALIB    0x05
+#define INA226_REG_MASK     0x06   ///< Mask / enable (alert source and flags)
+#define INA226_REG_LIMIT    0x07   ///< Alert limit
+#define INA226_REG_MFG_ID   0xFE
+#define INA226_MFG_ID       0x5449 ///< "TI"
+#define INA226_MASK_AFF     (1 << 4)   ///< Alert function flag
+#define INA226_MASK_CVRF    (1 << 3)   ///< Conversion ready flag
+#define INA226_MASK_APOL    (1 << 1)   ///< ALERT active high
+#define INA226_MASK_LEN     (1 << 0)   ///< Latch the alert until the mask register is read
+/** @} */
+
+/** @brief Status codes */
+typedef enum {
+  INA226_OK = 0,
+  INA226_ERROR        ///< Bus error or wrong manufacturer ID
+} INA226_Status;
+
+/** @brief Samples averaged per result (CONFIG AVG field) */
+typedef enum {
+  INA226_AVG_1 = 0,
+  INA226_AVG_4,
+  INA226_AVG_16,
+  INA226_AVG_64,
+  INA226_AVG_128,
+  INA226_AVG_256,
+  INA226_AVG_512,
+  INA226_AVG_1024
+} INA226_Averaging;
+
+/** @brief Conversion time of one sample (CONFIG VBUSCT / VSHCT fields) */
+typedef enum {
+  INA226_CT_140US = 0,
+  INA226_CT_204US,
+  INA226_CT_332US,
+  INA226_CT_588US,
+  INA226_CT_1100US,
+  INA226_CT_2116US,
+  INA226_CT_4156US,
+  INA226_CT_8244US
+} INA226_ConvTime;
+
+/** @brief Alert sources (mask / enable register bits 15-10) */
+typedef enum {
+  INA226_ALERT_NONE = 0,
+  INA226_ALERT_CONV_READY  = 1 << 10,  ///< Conversion ready
+  INA226_ALERT_POWER_OVER  = 1 << 11,  ///< Power above the limit
+  INA226_ALERT_BUS_UNDER   = 1 << 12,  ///< Bus voltage below the limit
+  INA226_ALERT_BUS_OVER    = 1 << 13,  ///< Bus voltage above the limit
+  INA226_ALERT_SHUNT_UNDER = 1 << 14,  ///< Shunt voltage below the limit
+  INA226_ALERT_SHUNT_OVER  = 1 << 15   ///< Shunt voltage above the limit (over-current)
+} INA226_Alert;
+
+/**
+ * @brief Device handle
+ */
+typedef struct {
+  uint8_t addr;              /**< 7-bit I2C address (0x40 with A0 = A1 = GND) */
+  uint16_t shuntMilliOhm;    /**< Shunt resistance (mOhm) */
+  uint16_t currentLsbUa;     /**< Current resolution (uA/LSB) */
+  uint8_t averaging;         /**< INA226_Averaging */
+  uint8_t busCT;             /**< INA226_ConvTime of the bus voltage */
+  uint8_t shuntCT;           /**< INA226_ConvTime of the shunt voltage */
+
+  uint16_t busMv;            /**< Last bus voltage (mV) */
+  int16_t currentMa;         /**< Last current (mA, positive = discharge) */
+  uint16_t powerMw;          /**< Last power (mW) */
+} INA226_Handle;
+
+/**
+ * @brief Check the manufacturer ID, then write the configuration
+ *        (continuous shunt + bus) and the calibration
+ * @param ina Handle with addr, shunt, current LSB and timing set
+ * @return INA226_Status
+ */
+INA226_Status INA226_Init(INA226_Handle *ina);
+
+/**
+ * @brief Apply averaging and conversion times (copied into the handle).
+ *        A result takes averaging * (busCT + shuntCT).
+ * @param ina Handle
+ * @param averaging INA226_Averaging
+ * @param busCT INA226_ConvTime of the bus voltage
+ * @param shuntCT INA226_ConvTime of the shunt voltage
+ * @return INA226_Status
+ */
+INA226_Status INA226_SetTiming(INA226_Handle *ina, INA226_Averaging averaging,
+                               INA226_ConvTime busCT, INA226_ConvTime shuntCT);
+
+/**
+ * @brief Read bus voltage, current and power into the handle
+ * @param ina Handle
+ * @return INA226_Status; the readings are unchanged on error
+ */
+INA226_Status INA226_Read(INA226_Handle *ina);
+
+/**
+ * @brief Arm the ALERT function; one source at a time
+ * @param ina Handle
+ * @param source INA226_Alert
+ * @param limit Threshold in the unit of the source: mV for bus and shunt
+ *        (shunt given as mA through the shunt), mW for power
+ * @param latch 1 to hold the alert until INA226_ReadAlert()
+ * @return INA226_Status
+ */
+INA226_Status INA226_SetAlert(INA226_Handle *ina, INA226_Alert source, uint16_t limit, uint8_t latch);
+
+/**
+ * @brief Read and (when latched) clear the alert flag
+ * @param ina Handle
+ * @return 1 if the alert condition occurred, 0 if not or on a bus error
+ */
+uint8_t INA226_ReadAlert(INA226_Handle *ina);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INA226_H */
@@ -0,0 +1,77 @@
+/**
+ * @file kalman.c
+ * @brief Fixed-point vertical-state filter implementation
+ * @author Nate Hunter
+ * @date 2025-07-23
+ * @version v1.0.0
+ */
+
+#include "kalman.h"
+
+/**
+ * @brief Signed 32 x unsigned Q16 multiply without 64-bit arithmetic
+ * @note Result must fit in int32_t; two 32x16 products on AVR.
+ */
+static inline int32_t KF_MulQ16(int32_t a, uint16_t b)
+{
+  int32_t hi = (a >> 16) * (int32_t)b;                // floor, so low part is >= 0
+  uint32_t lo = ((uint32_t)(a & 0xFFFF) * b) >> 16;
+  return hi + (int32_t)lo;
+}
+
+/**
+ * @brief Convert microseconds to seconds Q16, clamped to KF_MAX_DT_US
+ */
+static inline uint16_t KF_DtQ16(uint32_t dtUs)
+{
+  if (dtUs > KF_MAX_DT_US)
+    dtUs = KF_MAX_DT_US;
+  // 65536 / 1e6 = 4295 / 65536 (0.002% error)
+  return (uint16_t)((dtUs * 4295UL) >> 16);
+}
+
+/**
+ * @brief Gain = c * dt, saturated below 1.0 (Q16)
+ */
+static inline uint16_t KF_Gain(int32_t c, uint16_t dtQ16)
+{
+  int32_t k = KF_MulQ16(c, dtQ16);
+  return k > 0xFFFF ? 0xFFFF : (uint16_t)k;
+}
+
+void KF_Init(KF_Handle *kf, float crossover, int32_t altitude)
+{
+  float w = crossover;
+
+  kf->h = altitude << 8;
+  kf->v = 0;
+  kf->bias = 0;
+  kf->a = 0;
+
+  // Third-order complementary filter gains (init only, float is fine here)
+  kf->c1 = (int32_t)(3.0f * w * 65536.0f);
+  kf->c2 = (int32_t)(3.0f * w * w * 65536.0f);
+  kf->c3 = (int32_t)(w * w * w * 65536.0f);
+}
+
+void KF_Predict(KF_Handle *kf, int32_t accel, uint32_t dtUs)
+{
+  uint16_t dt = KF_DtQ16(dtUs);
+
+  kf->a = (accel << 8) - kf->bias;
+
+  // h += v*dt + a*dt^2/2, v += a*dt
+  int32_t dv = KF_MulQ16(kf->a, dt);
+  kf->h += KF_MulQ16(kf->v, dt) + KF_MulQ16(dv, dt >> 1);
+  kf->v += dv;
+}
+
+void KF_Correct(KF_Handle *kf, int32_t altitude, uint32_t dtUs)
+{
+  uint16_t dt = KF_DtQ16(dtUs);
+  int32_t e = (altitude << 8) - kf->h;
+
+  kf->h += KF_MulQ16(e, KF_Gain(kf->c1, dt));
+  kf->v += KF_MulQ16(e, KF_Gain(kf->c2, dt));
+  kf->bias -= KF_MulQ16(e, KF_Gain(kf->c3, dt));
+}
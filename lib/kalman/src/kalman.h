@@ -0,0 +1,77 @@
+/**
+ * @file kalman.h
+ * @brief Fixed-point vertical-state filter fusing baro altitude and acceleration
+ * @author Nate Hunter
+ * @date 2025-07-23
+ * @version v1.0.0
+ *
+ * Three-state (altitude, velocity, accelerometer bias) steady-state Kalman
+ * filter in its complementary form. Acceleration drives the prediction,
+ * baro altitude corrects it; the gains follow from a single crossover
+ * frequency so no covariance propagation is needed at runtime.
+ * Every call is straight-line 32-bit integer code (no loops, no 64-bit or
+ * float math), so cycle cost is bounded.
+ */
+
+#ifndef KALMAN_H
+#define KALMAN_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define KF_MAX_DT_US   500000UL   ///< Longer steps are clamped (Q16 time limit)
+
+/**
+ * @brief Filter state, all Q8 fixed point
+ */
+typedef struct {
+  int32_t h;        /**< Altitude (cm, Q8) */
+  int32_t v;        /**< Vertical velocity (cm/s, Q8) */
+  int32_t bias;     /**< Accelerometer bias (cm/s^2, Q8) */
+  int32_t a;        /**< Last bias-corrected acceleration (cm/s^2, Q8) */
+  int32_t c1;       /**< 3 * w (1/s, Q16) */
+  int32_t c2;       /**< 3 * w^2 (1/s^2, Q16) */
+  int32_t c3;       /**< w^3 (1/s^3, Q16) */
+} KF_Handle;
+
+/**
+ * @brief Initialize the filter
+ * @param kf Pointer to filter handle
+ * @param crossover Crossover frequency w (rad/s); higher trusts baro more
+ * @param altitude Initial altitude (cm)
+ */
+void KF_Init(KF_Handle *kf, float crossover, int32_t altitude);
+
+/**
+ * @brief Propagate the state with a vertical acceleration sample
+ * @param kf Pointer to filter handle
+ * @param accel Vertical acceleration with gravity removed (cm/s^2)
+ * @param dtUs Time since previous prediction (us)
+ */
+void KF_Predict(KF_Handle *kf, int32_t accel, uint32_t dtUs);
+
+/**
+ * @brief Correct the state with a baro altitude sample
+ * @param kf Pointer to filter handle
+ * @param altitude Baro altitude (cm)
+ * @param dtUs Time since previous correction (us)
+ */
+void KF_Correct(KF_Handle *kf, int32_t altitude, uint32_t dtUs);
+
+/** @brief Estimated altitude (cm) */
+static inline int32_t KF_GetAltitude(const KF_Handle *kf) { return kf->h >> 8; }
+
+/** @brief Estimated vertical velocity (cm/s) */
+static inline int32_t KF_GetVelocity(const KF_Handle *kf) { return kf->v >> 8; }
+
+/** @brief Estimated vertical acceleration (cm/s^2) */
+static inline int32_t KF_GetAccel(const KF_Handle *kf) { return kf->a >> 8; }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* KALMAN_H */
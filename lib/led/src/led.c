@@ -0,0 +1,197 @@
+/**
+ * @file led.c
+ * @brief Non-blocking RGB LED pattern engine implementation
+ * @author Nate Hunter
+ * @date 2025-07-31
+ * @version v1.0.0
+ */
+
+#include "led.h"
+#include "rgb_led.h"
+#include <avr/pgmspace.h>
+
+static const LED_Step ledOff[] PROGMEM = {
+  {   0,   0,   0, 100 },
+};
+
+// 36 hues at full saturation, 20 ms each
+static const LED_Step ledRainbow[] PROGMEM = {
+  { 255,   0,   0, 2 }, { 255,  42,   0, 2 }, { 255,  85,   0, 2 },
+  { 255, 128,   0, 2 }, { 255, 170,   0, 2 }, { 255, 212,   0, 2 },
+  { 255, 255,   0, 2 }, { 212, 255,   0, 2 }, { 170, 255,   0, 2 },
+  { 128, 255,   0, 2 }, {  85, 255,   0, 2 }, {  42, 255,   0, 2 },
+  {   0, 255,   0, 2 }, {   0, 255,  42, 2 }, {   0, 255,  85, 2 },
+  {   0, 255, 128, 2 }, {   0, 255, 170, 2 }, {   0, 255, 212, 2 },
+  {   0, 255, 255, 2 }, {   0, 212, 255, 2 }, {   0, 170, 255, 2 },
+  {   0, 128, 255, 2 }, {   0,  85, 255, 2 }, {   0,  43, 255, 2 },
+  {   0,   0, 255, 2 }, {  42,   0, 255, 2 }, {  85,   0, 255, 2 },
+  { 128,   0, 255, 2 }, { 170,   0, 255, 2 }, { 213,   0, 255, 2 },
+  { 255,   0, 255, 2 }, { 255,   0, 212, 2 }, { 255,   0, 170, 2 },
+  { 255,   0, 128, 2 }, { 255,   0,  85, 2 }, { 255,   0,  43, 2 },
+};
+
+static const LED_Step ledHeartbeat[] PROGMEM = {
+  {   0, 255,   0,  10 }, {   0,   0,   0,  15 },
+  {   0, 255,   0,  10 }, {   0,   0,   0, 165 },
+};
+
+static const LED_Step ledError[] PROGMEM = {
+  { 255,   0,   0,  25 }, {   0,   0,   0,  25 },
+};
+
+static const LED_Step ledFlight[] PROGMEM = {
+  { 255, 255, 255,   5 }, {   0,   0,   0,  45 },
+};
+
+static const LED_Step ledLanded[] PROGMEM = {
+  {   0,   0, 255,  20 }, {   0,   0,   0, 180 },
+};
+
+static const LED_Step ledBusy[] PROGMEM = {
+  { 160,   0, 255, 100 },
+};
+
+#define LED_PATTERN(t) { (t), sizeof(t) / sizeof((t)[0]) }
+
+/** @brief Pattern table entry */
+typedef struct {
+  const LED_Step *steps;
+  uint8_t count;
+} LED_Pattern;
+
+static const LED_Pattern ledPatterns[LED_PAT_COUNT] PROGMEM = {
+  LED_PATTERN(ledOff),
+  LED_PATTERN(ledRainbow),
+  LED_PATTERN(ledHeartbeat),
+  LED_PATTERN(ledError),
+  LED_PATTERN(ledFlight),
+  LED_PATTERN(ledLanded),
+  LED_PATTERN(ledBusy),
+};
+
+#define LED_MODE_CODE 0xFF   ///< ledPattern value while a blink code plays
+
+static uint8_t ledPattern = LED_PAT_COUNT;  ///< Active pattern, none yet
+static uint8_t ledResume = LED_PAT_COUNT;   ///< Pattern after a finite code
+static uint8_t ledIndex;                    ///< Step (code: half-pulse) index
+static uint32_t ledNextMs;                  ///< Time of the next step
+static uint8_t ledStart;                    ///< Output the first step at once
+static uint8_t ledCode[4];                  ///< Blink code r, g, b, count
+static uint8_t ledRepeats;                  ///< Code repetitions left, 0 = forever
+static uint8_t ledBrightness = 255;         ///< Output scale, 255 = as given
+
+/**
+ * @brief Drive the PWM outputs (common anode: 255 = off)
+ */
+static void LED_Output(uint8_t r, uint8_t g, uint8_t b)
+{
+  uint16_t k = (uint16_t)ledBrightness + 1;
+  r = (uint8_t)((r * k) >> 8);
+  g = (uint8_t)((g * k) >> 8);
+  b = (uint8_t)((b * k) >> 8);
+  RGB_SET(255 - r, 255 - g, 255 - b);
+}
+
+/**
+ * @brief Switch the buzzer (code pulses only)
+ */
+static void LED_Buzz(uint8_t on)
+{
+#if LED_BUZZER_ENABLE
+  LED_BUZZER_DDR |= (1 << LED_BUZZER_BIT);
+  if (on)
+    LED_BUZZER_PORT |= (1 << LED_BUZZER_BIT);
+  else
+    LED_BUZZER_PORT &= ~(1 << LED_BUZZER_BIT);
+#else
+  (void)on;
+#endif
+}
+
+void LED_Play(LED_PatternId id)
+{
+  if (id >= LED_PAT_COUNT)
+    return;
+  if (ledPattern == LED_MODE_CODE && ledRepeats) {
+    ledResume = id;
+    return;
+  }
+  if (ledPattern == id)
+    return;
+  ledPattern = id;
+  ledIndex = 0;
+  ledStart = 1;
+}
+
+void LED_PlayCode(uint8_t r, uint8_t g, uint8_t b, uint8_t n, uint8_t repeats)
+{
+  if (n < 1)
+    n = 1;
+  if (n > 15)
+    n = 15;
+  if (ledPattern == LED_MODE_CODE && ledCode[0] == r && ledCode[1] == g &&
+      ledCode[2] == b && ledCode[3] == n)
+    return;
+  ledCode[0] = r;
+  ledCode[1] = g;
+  ledCode[2] = b;
+  ledCode[3] = n;
+  ledRepeats = repeats;
+  if (ledPattern != LED_MODE_CODE)
+    ledResume = ledPattern;
+  ledPattern = LED_MODE_CODE;
+  ledIndex = 0;
+  ledStart = 1;
+}
+
+void LED_SetBrightness(uint8_t level)
+{
+  ledBrightness = level;
+}
+
+void LED_Update(uint32_t nowMs)
+{
+  if (ledPattern >= LED_PAT_COUNT && ledPattern != LED_MODE_CODE)
+    return;
+  if (!ledStart && (int32_t)(nowMs - ledNextMs) < 0)
+    return;
+  if (ledStart) {
+    ledStart = 0;
+    ledNextMs = nowMs;
+  }
+
+  if (ledPattern == LED_MODE_CODE) {
+    // Even index: pulse, odd: gap; the last gap is the long pause
+    uint8_t last = (uint8_t)(ledCode[3] * 2 - 1);
+    if (ledIndex & 1) {
+      LED_Output(0, 0, 0);
+      LED_Buzz(0);
+      ledNextMs += ledIndex == last ? LED_CODE_GAP_MS : LED_CODE_OFF_MS;
+    } else {
+      LED_Output(ledCode[0], ledCode[1], ledCode[2]);
+      LED_Buzz(1);
+      ledNextMs += LED_CODE_ON_MS;
+    }
+    if (++ledIndex > last) {
+      ledIndex = 0;
+      // Last repetition shown: fall back after its pause
+      if (ledRepeats && !--ledRepeats) {
+        ledPattern = ledResume;
+        ledResume = LED_PAT_COUNT;
+      }
+    }
+  } else {
+    LED_Pattern pat;
+    LED_Step step;
+    memcpy_P(&pat, &ledPatterns[ledPattern], sizeof(pat));
+    memcpy_P(&step, &pat.steps[ledIndex], sizeof(step));
+    LED_Output(step.r, step.g, step.b);
+    ledNextMs += (uint16_t)step.ticks * LED_TICK_MS;
+    if (++ledIndex >= pat.count)
+      ledIndex = 0;
+  }
+
+  // Late by more than a step (long blocking call): resync instead of racing
+  if ((int32_t)(nowMs - ledNextMs) > 0)
+    ledNextMs = nowMs;
+}
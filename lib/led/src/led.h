@@ -0,0 +1,110 @@
+/**
+ * @file led.h
+ * @brief Non-blocking RGB LED pattern engine (PROGMEM step tables)
+ * @author Nate Hunter
+ * @date 2025-07-31
+ * @version v1.0.0
+ *
+ * LED_Update() is cheap enough to call from a scheduler task or any wait
+ * loop: between steps it only compares a timestamp. Colors are given as
+ * intensities (0 = off, 255 = full); the common-anode inversion of
+ * rgb_led.h is applied on output.
+ */
+
+#ifndef LED_H
+#define LED_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup LED_Config Timing
+ * @{
+ */
+#ifndef LED_TICK_MS
+#define LED_TICK_MS      10    ///< Step duration unit (ms)
+#endif
+#ifndef LED_CODE_ON_MS
+#define LED_CODE_ON_MS   150   ///< Blink-code pulse (ms)
+#endif
+#ifndef LED_CODE_OFF_MS
+#define LED_CODE_OFF_MS  250   ///< Gap between pulses (ms)
+#endif
+#ifndef LED_CODE_GAP_MS
+#define LED_CODE_GAP_MS  1200  ///< Pause before the code repeats (ms)
+#endif
+/** @} */
+
+/** @defgroup LED_Buzzer Buzzer mirroring blink-code pulses
+ * @{
+ */
+#ifndef LED_BUZZER_ENABLE
+#define LED_BUZZER_ENABLE  1         ///< Sound blink-code pulses on an active buzzer
+#endif
+#ifndef LED_BUZZER_PORT
+#define LED_BUZZER_PORT    PORTD     ///< Buzzer port (high = sounding)
+#define LED_BUZZER_DDR     DDRD      ///< Buzzer direction register
+#define LED_BUZZER_BIT     PD4       ///< Buzzer pin (D4)
+#endif
+/** @} */
+
+/**
+ * @brief One pattern step (stored in PROGMEM)
+ */
+typedef struct {
+  uint8_t r;       /**< Red intensity */
+  uint8_t g;       /**< Green intensity */
+  uint8_t b;       /**< Blue intensity */
+  uint8_t ticks;   /**< Duration in LED_TICK_MS units */
+} LED_Step;
+
+/** @brief Built-in looping patterns */
+typedef enum {
+  LED_PAT_OFF = 0,    ///< Dark
+  LED_PAT_RAINBOW,    ///< Hue cycle, ~0.7 s
+  LED_PAT_HEARTBEAT,  ///< Green double pulse: idle, all OK
+  LED_PAT_ERROR,      ///< Red 2 Hz blink: fatal fault
+  LED_PAT_FLIGHT,     ///< White strobe: in flight
+  LED_PAT_LANDED,     ///< Blue slow flash: recovery beacon
+  LED_PAT_BUSY,       ///< Purple solid: calibration / long operation
+  LED_PAT_COUNT
+} LED_PatternId;
+
+/**
+ * @brief Start a built-in pattern (no-op if it is already playing)
+ * @note While a finite blink code plays, the pattern is queued and starts
+ *       when the code has finished.
+ */
+void LED_Play(LED_PatternId id);
+
+/**
+ * @brief Blink a numeric code: n pulses in one color (and on the buzzer),
+ *        then a pause
+ * @param r Red intensity
+ * @param g Green intensity
+ * @param b Blue intensity
+ * @param n Number of pulses (clamped to 1-15)
+ * @param repeats Times to show the code, 0 = forever; afterwards the
+ *        last pattern passed to LED_Play() resumes
+ */
+void LED_PlayCode(uint8_t r, uint8_t g, uint8_t b, uint8_t n, uint8_t repeats);
+
+/**
+ * @brief Scale all colors (patterns and codes)
+ * @param level 255 = as given, 0 = dark; takes effect with the next step
+ */
+void LED_SetBrightness(uint8_t level);
+
+/**
+ * @brief Advance the active pattern
+ * @param nowMs Current time (TIM_GetMillis())
+ */
+void LED_Update(uint32_t nowMs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LED_H */
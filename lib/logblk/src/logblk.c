@@ -0,0 +1,104 @@
+/**
+ * @file logblk.c
+ * @brief Self-describing log block writer implementation
+ * @author Nate Hunter
+ * @date 2025-08-12
+ * @version v1.0.0
+ */
+
+#include "logblk.h"
+#include "crc16.h"
+#include "time.h"
+#include <stddef.h>
+
+/* Private helpers */
+
+static SD_Status LOGBLK_Emit(LOGBLK_Handle *lb, const void *data, uint16_t len)
+{
+  const uint8_t *p = (const uint8_t *)data;
+  for (uint16_t i = 0; i < len; i++)
+    lb->crc = CRC16_Update(lb->crc, p[i]);
+  return SD_StreamWrite(lb->sd, data, len);
+}
+
+static SD_Status LOGBLK_Open(LOGBLK_Handle *lb)
+{
+  LOGBLK_Header h;
+  h.magic = LOGBLK_MAGIC;
+  h.schema = lb->schema;
+  h.reserved = 0;
+  h.boot = lb->boot;
+  h.seq = lb->seq;
+  h.tFirstMs = TIM_GetMillis();
+  lb->crc = CRC16_INIT;
+  lb->used = 0;
+  return LOGBLK_Emit(lb, &h, sizeof(h));
+}
+
+static SD_Status LOGBLK_Close(LOGBLK_Handle *lb, uint16_t used)
+{
+  LOGBLK_Trailer t;
+  t.tLastMs = TIM_GetMillis();
+  t.used = used;
+  SD_Status status = LOGBLK_Emit(lb, &t, offsetof(LOGBLK_Trailer, crc));
+  t.crc = lb->crc;
+  lb->seq++;
+  lb->used = 0;
+  if (status != SD_OK)
+    return status;
+  return SD_StreamWrite(lb->sd, &t.crc, sizeof(t.crc));
+}
+
+/* Public functions */
+
+void LOGBLK_Init(LOGBLK_Handle *lb, SD_Handle *sd, uint16_t boot, uint8_t schema, uint32_t seq)
+{
+  lb->sd = sd;
+  lb->boot = boot;
+  lb->schema = schema;
+  lb->seq = seq;
+  lb->used = 0;
+}
+
+uint16_t LOGBLK_Room(const LOGBLK_Handle *lb)
+{
+  return lb->sd->open ? LOGBLK_PAYLOAD - lb->used : LOGBLK_PAYLOAD;
+}
+
+SD_Status LOGBLK_Write(LOGBLK_Handle *lb, const void *data, uint16_t len)
+{
+  const uint8_t *p = (const uint8_t *)data;
+  SD_Status status = SD_OK;
+
+  while (len && status == SD_OK) {
+    if (!lb->sd->open && (status = LOGBLK_Open(lb)) != SD_OK)
+      break;
+    uint16_t n = LOGBLK_PAYLOAD - lb->used;
+    if (n > len)
+      n = len;
+    if ((status = LOGBLK_Emit(lb, p, n)) != SD_OK)
+      break;
+    p += n;
+    len -= n;
+    lb->used += n;
+    if (lb->used == LOGBLK_PAYLOAD)
+      status = LOGBLK_Close(lb, LOGBLK_PAYLOAD);
+  }
+  return status;
+}
+
+SD_Status LOGBLK_Pad(LOGBLK_Handle *lb)
+{
+  if (!lb->sd->open)
+    return SD_OK;
+
+  // The padding is covered by the CRC as well
+  uint16_t used = lb->used;
+  uint16_t n = LOGBLK_PAYLOAD - used;
+  for (uint16_t i = 0; i < n; i++)
+    lb->crc = CRC16_Update(lb->crc, 0x00);
+  SD_Status status = SD_StreamFill(lb->sd, 0x00, n);
+  if (status != SD_OK)
+    return status;
+  return LOGBLK_Close(lb, used);
+}
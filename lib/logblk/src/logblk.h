@@ -0,0 +1,113 @@
+/**
+ * @file logblk.h
+ * @brief Self-describing, crash-safe 512-byte log blocks on an SD stream
+ * @author Nate Hunter
+ * @date 2025-08-12
+ * @version v1.0.0
+ *
+ * Every card block carries its own metadata, so nothing is ever rewritten
+ * and a host can rebuild the log from a raw card image:
+ *
+ *   header  (16): magic "FDRL" | schema | 0 | boot (2) | seq (4) | tFirst ms (4)
+ *   payload (488): record bytes (COBS frames), zero padded
+ *   trailer  (8): tLast ms (4) | used (2) | crc16 (2)
+ *
+ * All fields are little endian. The CRC-16/CCITT-FALSE covers header,
+ * payload, tLast and used. seq counts blocks from the start of the log
+ * file and continues across warm restarts. boot changes on every cold
+ * boot. tFirst and tLast are the write times of the first and last
+ * payload byte; records are produced at most one queue latency earlier.
+ * A torn or never-written block fails its CRC and is skipped as a whole.
+ *
+ * The CRC is accumulated as bytes stream out, so no block buffer is needed.
+ */
+
+#ifndef LOGBLK_H
+#define LOGBLK_H
+
+#include <stdint.h>
+#include "sd.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LOGBLK_MAGIC    0x4C524446UL   ///< "FDRL" in little-endian byte order
+#define LOGBLK_HEADER   16
+#define LOGBLK_TRAILER  8
+#define LOGBLK_PAYLOAD  (SD_BLOCK_SIZE - LOGBLK_HEADER - LOGBLK_TRAILER)
+
+/**
+ * @brief Block header as written
+ */
+typedef struct {
+  uint32_t magic;              /**< LOGBLK_MAGIC */
+  uint8_t schema;              /**< Record layout version */
+  uint8_t reserved;            /**< 0 */
+  uint16_t boot;               /**< Cold-boot counter */
+  uint32_t seq;                /**< Block number in the log file */
+  uint32_t tFirstMs;           /**< Write time of the first payload byte */
+} LOGBLK_Header;
+
+/**
+ * @brief Block trailer as written
+ */
+typedef struct {
+  uint32_t tLastMs;            /**< Write time of the last payload byte */
+  uint16_t used;               /**< Payload bytes before the padding */
+  uint16_t crc;                /**< CRC-16 over everything before it */
+} LOGBLK_Trailer;
+
+/**
+ * @brief Block writer state
+ */
+typedef struct {
+  SD_Handle *sd;               /**< Card with a running stream */
+  uint32_t seq;                /**< Sequence number of the open / next block */
+  uint16_t boot;               /**< Cold-boot counter */
+  uint8_t schema;              /**< Record layout version */
+  uint16_t used;               /**< Payload bytes in the open block */
+  uint16_t crc;                /**< Running CRC of the open block */
+} LOGBLK_Handle;
+
+/**
+ * @brief Attach to a started SD stream
+ * @param lb Writer
+ * @param sd Card, SD_StreamStart() already called
+ * @param boot Cold-boot counter
+ * @param schema Record layout version
+ * @param seq Sequence number of the stream's first block
+ */
+void LOGBLK_Init(LOGBLK_Handle *lb, SD_Handle *sd, uint16_t boot, uint8_t schema, uint32_t seq);
+
+/**
+ * @brief Payload bytes that fit before the open block closes
+ * @param lb Writer
+ * @return Free payload bytes, LOGBLK_PAYLOAD if no block is open
+ */
+uint16_t LOGBLK_Room(const LOGBLK_Handle *lb);
+
+/**
+ * @brief Append payload bytes; opens blocks with a header and closes them
+ *        with a trailer as needed
+ * @param lb Writer
+ * @param data Bytes
+ * @param len Number of bytes
+ * @return SD_Status of the stream
+ * @note Opening a block waits for the card; check SD_StreamReady() first
+ *       where that matters.
+ */
+SD_Status LOGBLK_Write(LOGBLK_Handle *lb, const void *data, uint16_t len);
+
+/**
+ * @brief Zero-pad and close the open block, releasing the bus
+ * @param lb Writer
+ * @return SD_Status of the stream
+ */
+SD_Status LOGBLK_Pad(LOGBLK_Handle *lb);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LOGBLK_H */
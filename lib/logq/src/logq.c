@@ -0,0 +1,74 @@
+/**
+ * @file logq.c
+ * @brief Lock-free log byte queue implementation
+ * @author Nate Hunter
+ * @date 2025-08-10
+ * @version v1.0.0
+ */
+
+#include "logq.h"
+#include <string.h>
+
+#define LOGQ_MASK (LOGQ_SIZE - 1)
+
+#if (LOGQ_SIZE & LOGQ_MASK) || LOGQ_SIZE > 256
+#error "LOGQ_SIZE must be a power of two <= 256"
+#endif
+
+void LOGQ_Init(LOGQ_Handle *q)
+{
+  memset(q, 0, sizeof(*q));
+}
+
+uint8_t LOGQ_Used(const LOGQ_Handle *q)
+{
+  return (uint8_t)(q->head - q->tail) & LOGQ_MASK;
+}
+
+uint8_t LOGQ_Fits(const LOGQ_Handle *q, uint8_t len, uint8_t prio)
+{
+  uint16_t used = LOGQ_Used(q) + len;   // One slot stays empty: full != empty
+
+  if (prio == LOGQ_PRIO_LOW)
+    return used <= LOGQ_SIZE / 2;
+  if (prio == LOGQ_PRIO_NORMAL)
+    return used + LOGQ_HEADROOM_HIGH < LOGQ_SIZE;
+  return used < LOGQ_SIZE;
+}
+
+uint8_t LOGQ_Push(LOGQ_Handle *q, const uint8_t *data, uint8_t len, uint8_t prio)
+{
+  if (!LOGQ_Fits(q, len, prio)) {
+    if (q->dropped[prio] != 0xFFFF)
+      q->dropped[prio]++;
+    return 0;
+  }
+
+  uint8_t head = q->head;
+  for (uint8_t i = 0; i < len; i++) {
+    q->buf[head] = data[i];
+    head = (head + 1) & LOGQ_MASK;
+  }
+  q->head = head;                       // Publish the record in one store
+
+  uint8_t used = LOGQ_Used(q);
+  if (used > q->maxUsed)
+    q->maxUsed = used;
+  return 1;
+}
+
+uint8_t LOGQ_Peek(const LOGQ_Handle *q, const uint8_t **data)
+{
+  uint8_t tail = q->tail;
+  uint8_t head = q->head;
+
+  *data = &q->buf[tail];
+  if (head >= tail)
+    return head - tail;
+  return LOGQ_SIZE - tail;              // Up to the end; the rest after the wrap
+}
+
+void LOGQ_Consume(LOGQ_Handle *q, uint8_t n)
+{
+  q->tail = (q->tail + n) & LOGQ_MASK;
+}
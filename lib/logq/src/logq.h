@@ -0,0 +1,108 @@
+/**
+ * @file logq.h
+ * @brief Lock-free byte queue between the log producers and the storage writer
+ * @author Nate Hunter
+ * @date 2025-08-10
+ * @version v1.0.0
+ *
+ * Single producer, single consumer: the producer only writes head, the
+ * consumer only writes tail, and both are single bytes, so neither side
+ * needs to disable interrupts and either one may run in an ISR.
+ *
+ * Records are queued whole or not at all. When the writer lags (card busy)
+ * a record is admitted only if it leaves the headroom its priority
+ * requires, so low-value records are dropped first and the last free bytes
+ * are kept for rare, essential ones. Every drop is counted per priority.
+ */
+
+#ifndef LOGQ_H
+#define LOGQ_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup LOGQ_Config Queue sizing
+ * @{
+ */
+#ifndef LOGQ_SIZE
+#define LOGQ_SIZE          128   ///< Queue size (power of two, <= 256)
+#endif
+#ifndef LOGQ_HEADROOM_HIGH
+#define LOGQ_HEADROOM_HIGH 24    ///< Bytes normal records leave free for high ones
+#endif
+/** @} */
+
+/** @brief Record priorities, lowest dropped first */
+typedef enum {
+  LOGQ_PRIO_LOW = 0,   ///< Admitted while the queue is at most half full
+  LOGQ_PRIO_NORMAL,    ///< Admitted if LOGQ_HEADROOM_HIGH bytes stay free
+  LOGQ_PRIO_HIGH,      ///< Admitted whenever it fits
+  LOGQ_PRIO_COUNT
+} LOGQ_Priority;
+
+/**
+ * @brief Queue handle
+ */
+typedef struct {
+  uint8_t buf[LOGQ_SIZE];               /**< Storage */
+  volatile uint8_t head;                /**< Next write index (producer) */
+  volatile uint8_t tail;                /**< Next read index (consumer) */
+  uint8_t maxUsed;                      /**< Fill high-water mark (bytes) */
+  uint16_t dropped[LOGQ_PRIO_COUNT];    /**< Records dropped, per priority */
+} LOGQ_Handle;
+
+/**
+ * @brief Empty the queue and clear the statistics
+ * @param q Queue
+ */
+void LOGQ_Init(LOGQ_Handle *q);
+
+/**
+ * @brief Queued bytes
+ * @param q Queue
+ * @return Bytes waiting for the consumer
+ */
+uint8_t LOGQ_Used(const LOGQ_Handle *q);
+
+/**
+ * @brief Check whether a record would be admitted now
+ * @param q Queue
+ * @param len Record length
+ * @param prio LOGQ_Priority
+ * @return 1 if LOGQ_Push() would queue it
+ */
+uint8_t LOGQ_Fits(const LOGQ_Handle *q, uint8_t len, uint8_t prio);
+
+/**
+ * @brief Queue a whole record or drop it (producer side)
+ * @param q Queue
+ * @param data Record bytes
+ * @param len Record length
+ * @param prio LOGQ_Priority
+ * @return 1 if queued, 0 if dropped and counted
+ */
+uint8_t LOGQ_Push(LOGQ_Handle *q, const uint8_t *data, uint8_t len, uint8_t prio);
+
+/**
+ * @brief Contiguous queued bytes starting at the tail (consumer side)
+ * @param q Queue
+ * @param[out] data Set to the first queued byte
+ * @return Number of bytes readable at @p data without wrapping
+ */
+uint8_t LOGQ_Peek(const LOGQ_Handle *q, const uint8_t **data);
+
+/**
+ * @brief Release bytes returned by LOGQ_Peek() (consumer side)
+ * @param q Queue
+ * @param n Bytes consumed
+ */
+void LOGQ_Consume(LOGQ_Handle *q, uint8_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LOGQ_H */
@@ -8,6 +8,7 @@
 
 #include "lora.h"
 #include "spi_driver.h"
+#include "bustrace.h"
 #include <string.h>
 
 /* Static buffer for SPI transactions */
@@ -17,25 +18,37 @@ static uint8_t txBuffer[1];
 static inline void LoRa_WriteReg(LoRa_Handle_t *handle, LoRa_Register_t reg, uint8_t *data, uint8_t count);
 static inline void LoRa_WriteRegByte(LoRa_Handle_t *handle, LoRa_Register_t reg, uint8_t data);
 static inline uint8_t LoRa_ReadRegByte(LoRa_Handle_t *handle, LoRa_Register_t reg);
+static inline uint8_t LoRa_ReadRegByteRaw(LoRa_Handle_t *handle, LoRa_Register_t reg);
 static inline void LoRa_ReadReg(LoRa_Handle_t *handle, LoRa_Register_t reg, uint8_t *data, uint8_t count);
 
 /**
- * @brief Initialize the LoRa module
+ * @brief Check the version register without touching the configuration
  * @param handle Pointer to LoRa handle structure
- * @return 1 if successful, 0 if failed
+ * @return 1 if an SX127x answered, 0 otherwise
  */
-uint8_t LoRa_Init(LoRa_Handle_t *handle)
+uint8_t LoRa_Probe(LoRa_Handle_t *handle)
 {
     uint8_t id;
 
+    BUSTRACE_BEGIN();
     txBuffer[0] = LORA_REG_VERSION & ~LORA_SPI_WRITE_BIT;
     *(handle->nssPort) &= ~(1 << handle->nssPin);
     SPI_Transmit(handle->spiHandle, txBuffer[0]);
     id = SPI_Transmit(handle->spiHandle, 0xFF);
     *(handle->nssPort) |= (1 << handle->nssPin);
-    printf("LoRa ID: 0x%02X\n", id);
+    BUSTRACE_END(BUSTRACE_SPI | handle->nssPin, LORA_REG_VERSION, 1, id != 0x12);
 
-    if (id != 0x12) {
+    return id == 0x12;
+}
+
+/**
+ * @brief Initialize the LoRa module
+ * @param handle Pointer to LoRa handle structure
+ * @return 1 if successful, 0 if failed
+ */
+uint8_t LoRa_Init(LoRa_Handle_t *handle)
+{
+    if (!LoRa_Probe(handle)) {
         return 0;
     }
 
@@ -92,18 +105,14 @@ void LoRa_Transmit(LoRa_Handle_t *handle, void *data, uint8_t len)
     LoRa_WriteRegByte(handle, LORA_REG_PAYLOAD_LENGTH, len);
     LoRa_WriteRegByte(handle, LORA_REG_FIFO_ADDR_SPI, handle->config.txAddr);
 
-    *(handle->nssPort) &= ~(1 << handle->nssPin);
-    SPI_Transmit(handle->spiHandle, LORA_REG_FIFO | LORA_SPI_WRITE_BIT);
-
-    for (uint8_t i = 0; i < len; ++i) {
-        SPI_Transmit(handle->spiHandle, ((uint8_t*)data)[i]);
-    }
-
-    *(handle->nssPort) |= (1 << handle->nssPin);
+    LoRa_WriteReg(handle, LORA_REG_FIFO, (uint8_t*)data, len);
 
     LoRa_WriteRegByte(handle, LORA_REG_OP_MODE, 0x83); // Tx mode
 
-    while (!(LoRa_ReadRegByte(handle, LORA_REG_IRQ_FLAGS) & LORA_FLAG_TX_DONE));
+    // Airtime is traced as one entry (register 0xFF) instead of every poll
+    BUSTRACE_BEGIN();
+    while (!(LoRa_ReadRegByteRaw(handle, LORA_REG_IRQ_FLAGS) & LORA_FLAG_TX_DONE));
+    BUSTRACE_END(BUSTRACE_SPI | handle->nssPin, 0xFF, len, 0);
 
     LoRa_WriteRegByte(handle, LORA_REG_IRQ_FLAGS, LORA_FLAG_TX_DONE);
     LoRa_WriteRegByte(handle, LORA_REG_OP_MODE, 0x05); // back to Rx
@@ -172,12 +181,14 @@ void LoRa_DisableDIO0Interrupt(LoRa_Handle_t *handle)
  */
 static inline void LoRa_WriteReg(LoRa_Handle_t *handle, LoRa_Register_t reg, uint8_t *data, uint8_t count)
 {
+    BUSTRACE_BEGIN();
     *(handle->nssPort) &= ~(1 << handle->nssPin);
     SPI_Transmit(handle->spiHandle, reg | LORA_SPI_WRITE_BIT);
     for (uint8_t i = 0; i < count; ++i) {
         SPI_Transmit(handle->spiHandle, data[i]);
     }
     *(handle->nssPort) |= (1 << handle->nssPin);
+    BUSTRACE_END(BUSTRACE_SPI | handle->nssPin, reg, count, 0);
 }
 
 /**
@@ -189,9 +200,9 @@ static inline void LoRa_WriteRegByte(LoRa_Handle_t *handle, LoRa_Register_t reg,
 }
 
 /**
- * @brief Read single byte from register
+ * @brief Read single byte from register (not traced, used for polling)
  */
-static inline uint8_t LoRa_ReadRegByte(LoRa_Handle_t *handle, LoRa_Register_t reg)
+static inline uint8_t LoRa_ReadRegByteRaw(LoRa_Handle_t *handle, LoRa_Register_t reg)
 {
     uint8_t result = 0;
     *(handle->nssPort) &= ~(1 << handle->nssPin);
@@ -201,15 +212,28 @@ static inline uint8_t LoRa_ReadRegByte(LoRa_Handle_t *handle, LoRa_Register_t re
     return result;
 }
 
+/**
+ * @brief Read single byte from register
+ */
+static inline uint8_t LoRa_ReadRegByte(LoRa_Handle_t *handle, LoRa_Register_t reg)
+{
+    BUSTRACE_BEGIN();
+    uint8_t result = LoRa_ReadRegByteRaw(handle, reg);
+    BUSTRACE_END(BUSTRACE_SPI | handle->nssPin, reg, 1, 0);
+    return result;
+}
+
 /**
  * @brief Read multiple bytes from register
  */
 static inline void LoRa_ReadReg(LoRa_Handle_t *handle, LoRa_Register_t reg, uint8_t *data, uint8_t count)
 {
+    BUSTRACE_BEGIN();
     *(handle->nssPort) &= ~(1 << handle->nssPin);
     SPI_Transmit(handle->spiHandle, reg & ~LORA_SPI_WRITE_BIT);
     for (uint8_t i = 0; i < count; ++i) {
         data[i] = SPI_Transmit(handle->spiHandle, 0xFF);
     }
     *(handle->nssPort) |= (1 << handle->nssPin);
+    BUSTRACE_END(BUSTRACE_SPI | handle->nssPin, reg, count, 0);
 }
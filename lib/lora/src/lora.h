@@ -101,6 +101,13 @@ extern "C" {
  */
 uint8_t LoRa_Init(LoRa_Handle_t *handle);
 
+/**
+ * @brief Check that the module answers (version register) without configuring it
+ * @param handle Pointer to LoRa handle structure
+ * @return 1 if found, 0 otherwise
+ */
+uint8_t LoRa_Probe(LoRa_Handle_t *handle);
+
 /**
  * @brief Apply configuration to LoRa module
  * @param handle Pointer to LoRa handle structure
@@ -9,6 +9,26 @@
 #include "lsm6ds3.h"
 #include "twi.h"
 
+/**
+ * @brief Clamp a corrected sample to the int16_t range
+ */
+static inline int16_t LSM6DS3_Saturate(int32_t v) {
+  if (v > INT16_MAX) return INT16_MAX;
+  if (v < INT16_MIN) return INT16_MIN;
+  return (int16_t)v;
+}
+
+/**
+ * @brief Convert 6 little-endian bytes to calibrated X, Y, Z acceleration
+ */
+static void LSM6DS3_CorrectAccel(LSM6DS3_Handle *dev, const uint8_t *buffer, int16_t accel[3]) {
+  for (int i = 0; i < 3; i++) {
+    int16_t raw = (int16_t)(buffer[i * 2 + 1] << 8 | buffer[i * 2]);
+    int32_t v = (int32_t)raw - dev->accelOffset[i];
+    accel[i] = LSM6DS3_Saturate((v * dev->accelGain[i]) >> 14);
+  }
+}
+
 /**
  * @brief Initialize the LSM6DS3 device with desired configuration
  * 
@@ -34,6 +54,9 @@ uint8_t LSM6DS3_Init(LSM6DS3_Handle *dev,
   if (IIC_WriteByte(dev->i2c_addr, LSM6DS3_REG_CTRL3_C, 0x44) != IIC_SUCCESS)
     return 0;
 
+  // No correction until calibration is applied
+  LSM6DS3_SetCalibration(dev, 0, 0, 0);
+
   // Set accelerometer scale factor
   switch (accelFS) {
     case LSM6DS3_XL_2G:
@@ -77,14 +100,14 @@ uint8_t LSM6DS3_Init(LSM6DS3_Handle *dev,
 }
 
 /**
- * @brief Read accelerometer and gyroscope data from LSM6DS3
+ * @brief Read raw accelerometer and gyroscope samples from LSM6DS3
  * 
  * @param dev Pointer to LSM6DS3 device handle
- * @param accel Output array for accelerometer values (X, Y, Z)
- * @param gyro Output array for gyroscope values (X, Y, Z)
+ * @param accel Output array for raw accelerometer values (X, Y, Z)
+ * @param gyro Output array for raw gyroscope values (X, Y, Z)
  * @return 1 on success, 0 on failure
  */
-uint8_t LSM6DS3_ReadData(LSM6DS3_Handle *dev, float accel[3], float gyro[3]) {
+uint8_t LSM6DS3_ReadRaw(LSM6DS3_Handle *dev, int16_t accel[3], int16_t gyro[3]) {
   uint8_t buffer[12];
   if (IIC_ReadBytes(dev->i2c_addr, LSM6DS3_REG_OUTX_L_G, buffer, 12) != IIC_SUCCESS)
     return 0;
@@ -92,14 +115,197 @@ uint8_t LSM6DS3_ReadData(LSM6DS3_Handle *dev, float accel[3], float gyro[3]) {
   // Gyroscope: X, Y, Z
   for (int i = 0; i < 3; i++) {
     int16_t raw = (int16_t)(buffer[i * 2 + 1] << 8 | buffer[i * 2]);
-    gyro[i] = raw * dev->gyroScale;
+    gyro[i] = LSM6DS3_Saturate((int32_t)raw - dev->gyroBias[i]);
   }
 
   // Accelerometer: X, Y, Z
+  LSM6DS3_CorrectAccel(dev, &buffer[6], accel);
+
+  return 1;
+}
+
+/**
+ * @brief Set the correction applied in the read paths
+ * 
+ * @param dev Pointer to LSM6DS3 device handle
+ * @param gyroBias Gyroscope bias or NULL
+ * @param accelOffset Accelerometer offset or NULL
+ * @param accelGain Accelerometer gain (Q14) or NULL
+ */
+void LSM6DS3_SetCalibration(LSM6DS3_Handle *dev, const int16_t gyroBias[3],
+                            const int16_t accelOffset[3], const int16_t accelGain[3]) {
+  for (int i = 0; i < 3; i++) {
+    dev->gyroBias[i] = gyroBias ? gyroBias[i] : 0;
+    dev->accelOffset[i] = accelOffset ? accelOffset[i] : 0;
+    dev->accelGain[i] = accelGain ? accelGain[i] : 16384;
+  }
+}
+
+/**
+ * @brief Read accelerometer and gyroscope data from LSM6DS3
+ * 
+ * @param dev Pointer to LSM6DS3 device handle
+ * @param accel Output array for accelerometer values (X, Y, Z)
+ * @param gyro Output array for gyroscope values (X, Y, Z)
+ * @return 1 on success, 0 on failure
+ */
+uint8_t LSM6DS3_ReadData(LSM6DS3_Handle *dev, float accel[3], float gyro[3]) {
+  int16_t rawAccel[3], rawGyro[3];
+  if (!LSM6DS3_ReadRaw(dev, rawAccel, rawGyro))
+    return 0;
+
   for (int i = 0; i < 3; i++) {
-    int16_t raw = (int16_t)(buffer[6 + i * 2 + 1] << 8 | buffer[6 + i * 2]);
-    accel[i] = raw * dev->accelScale;
+    gyro[i] = rawGyro[i] * dev->gyroScale;
+    accel[i] = rawAccel[i] * dev->accelScale;
   }
 
   return 1;
 }
+
+/**
+ * @brief Change accelerometer and gyroscope output data rates
+ *
+ * @param dev Pointer to LSM6DS3 device handle
+ * @param accelODR New accelerometer ODR
+ * @param gyroODR New gyroscope ODR
+ * @return 1 on success, 0 on failure
+ */
+uint8_t LSM6DS3_SetODR(LSM6DS3_Handle *dev, LSM6DS3_ODR accelODR, LSM6DS3_ODR gyroODR) {
+  uint8_t reg;
+
+  // Keep full-scale bits, replace ODR nibble
+  if (IIC_ReadByte(dev->i2c_addr, LSM6DS3_REG_CTRL1_XL, &reg) != IIC_SUCCESS)
+    return 0;
+  if (IIC_WriteByte(dev->i2c_addr, LSM6DS3_REG_CTRL1_XL, (accelODR << 4) | (reg & 0x0F)) != IIC_SUCCESS)
+    return 0;
+
+  if (IIC_ReadByte(dev->i2c_addr, LSM6DS3_REG_CTRL2_G, &reg) != IIC_SUCCESS)
+    return 0;
+  if (IIC_WriteByte(dev->i2c_addr, LSM6DS3_REG_CTRL2_G, (gyroODR << 4) | (reg & 0x0F)) != IIC_SUCCESS)
+    return 0;
+
+  dev->accelODR = accelODR;
+  dev->gyroODR = gyroODR;
+  return 1;
+}
+
+/**
+ * @brief Enable latched wake-up and free-fall embedded functions
+ *
+ * @param dev Pointer to LSM6DS3 device handle
+ * @param wakeThs Wake-up threshold (0-63)
+ * @param ffThs Free-fall threshold
+ * @param ffDur Free-fall duration (0-31)
+ * @return 1 on success, 0 on failure
+ */
+uint8_t LSM6DS3_ConfigEvents(LSM6DS3_Handle *dev, uint8_t wakeThs,
+                             LSM6DS3_FreeFallThs ffThs, uint8_t ffDur) {
+  // Timestamp counter on, events latched until WAKE_UP_SRC is read; the
+  // interrupts themselves are enabled by the MD1_CFG routing below
+  if (IIC_WriteByte(dev->i2c_addr, LSM6DS3_REG_TAP_CFG,
+                    LSM6DS3_TAP_CFG_TIMER_EN | LSM6DS3_TAP_CFG_LIR) != IIC_SUCCESS)
+    return 0;
+
+  if (IIC_WriteByte(dev->i2c_addr, LSM6DS3_REG_WAKE_UP_THS, wakeThs & 0x3F) != IIC_SUCCESS)
+    return 0;
+
+  // FF_DUR5 lives in WAKE_UP_DUR, wake-up duration = 1 ODR period
+  if (IIC_WriteByte(dev->i2c_addr, LSM6DS3_REG_WAKE_UP_DUR, ((ffDur & 0x20) << 2) | (1 << 5)) != IIC_SUCCESS)
+    return 0;
+
+  if (IIC_WriteByte(dev->i2c_addr, LSM6DS3_REG_FREE_FALL, ((ffDur & 0x1F) << 3) | (ffThs & 0x07)) != IIC_SUCCESS)
+    return 0;
+
+  // Route wake-up and free-fall to INT1
+  if (IIC_WriteByte(dev->i2c_addr, LSM6DS3_REG_MD1_CFG,
+                    LSM6DS3_MD1_CFG_INT1_WU | LSM6DS3_MD1_CFG_INT1_FF) != IIC_SUCCESS)
+    return 0;
+
+  return 1;
+}
+
+/**
+ * @brief Read and clear latched embedded-function events
+ *
+ * @param dev Pointer to LSM6DS3 device handle
+ * @param src Output WAKE_UP_SRC value
+ * @return 1 on success, 0 on failure
+ */
+uint8_t LSM6DS3_ReadEvents(LSM6DS3_Handle *dev, uint8_t *src) {
+  return IIC_ReadByte(dev->i2c_addr, LSM6DS3_REG_WAKE_UP_SRC, src) == IIC_SUCCESS;
+}
+
+/**
+ * @brief Convert an ODR setting to its nominal rate
+ *
+ * @param odr ODR setting
+ * @return Rate in Hz
+ */
+uint16_t LSM6DS3_ODRToHz(LSM6DS3_ODR odr) {
+  static const uint16_t rates[] = { 0, 12, 26, 52, 104, 208, 416, 833, 1660, 3330, 6660 };
+  return odr <= LSM6DS3_ODR_6660HZ ? rates[odr] : 0;
+}
+
+/**
+ * @brief Clear the FIFO and start collecting accelerometer samples
+ *
+ * @param dev Pointer to LSM6DS3 device handle
+ * @param odr FIFO ODR
+ * @return 1 on success, 0 on failure
+ */
+uint8_t LSM6DS3_FifoStart(LSM6DS3_Handle *dev, LSM6DS3_ODR odr) {
+  // Bypass mode flushes previous contents
+  if (!LSM6DS3_FifoStop(dev))
+    return 0;
+
+  // Accelerometer without decimation, gyroscope not stored
+  if (IIC_WriteByte(dev->i2c_addr, LSM6DS3_REG_FIFO_CTRL3, 0x01) != IIC_SUCCESS)
+    return 0;
+
+  // FIFO mode: stop collecting when full
+  return IIC_WriteByte(dev->i2c_addr, LSM6DS3_REG_FIFO_CTRL5, (odr << 3) | 0x01) == IIC_SUCCESS;
+}
+
+/**
+ * @brief Stop and clear the FIFO
+ *
+ * @param dev Pointer to LSM6DS3 device handle
+ * @return 1 on success, 0 on failure
+ */
+uint8_t LSM6DS3_FifoStop(LSM6DS3_Handle *dev) {
+  return IIC_WriteByte(dev->i2c_addr, LSM6DS3_REG_FIFO_CTRL5, 0x00) == IIC_SUCCESS;
+}
+
+/**
+ * @brief Get the number of complete accelerometer samples in the FIFO
+ *
+ * @param dev Pointer to LSM6DS3 device handle
+ * @param samples Output sample count
+ * @return 1 on success, 0 on failure
+ */
+uint8_t LSM6DS3_FifoLevel(LSM6DS3_Handle *dev, uint16_t *samples) {
+  uint8_t st[2];
+  if (IIC_ReadBytes(dev->i2c_addr, LSM6DS3_REG_FIFO_STATUS1, st, 2) != IIC_SUCCESS)
+    return 0;
+
+  *samples = (((uint16_t)(st[1] & 0x0F) << 8) | st[0]) / 3;
+  return 1;
+}
+
+/**
+ * @brief Pop one accelerometer sample from the FIFO
+ *
+ * @param dev Pointer to LSM6DS3 device handle
+ * @param accel Output array for X, Y, Z
+ * @return 1 on success, 0 on failure
+ */
+uint8_t LSM6DS3_FifoReadAccel(LSM6DS3_Handle *dev, int16_t accel[3]) {
+  uint8_t buffer[6];
+
+  // The register pointer wraps inside FIFO_DATA_OUT_L/H, so one burst pops X, Y, Z
+  if (IIC_ReadBytes(dev->i2c_addr, LSM6DS3_REG_FIFO_DATA_OUT_L, buffer, 6) != IIC_SUCCESS)
+    return 0;
+
+  LSM6DS3_CorrectAccel(dev, buffer, accel);
+  return 1;
+}
@@ -24,12 +24,35 @@ extern "C" {
 #define LSM6DS3_WHO_AM_I       0x6A
 
 /// LSM6DS3 Register Map
+#define LSM6DS3_REG_FIFO_CTRL3 0x08  /**< FIFO decimation register */
+#define LSM6DS3_REG_FIFO_CTRL5 0x0A  /**< FIFO ODR and mode register */
 #define LSM6DS3_REG_WHO_AM_I   0x0F  /**< Device identification register */
 #define LSM6DS3_REG_CTRL1_XL   0x10  /**< Accelerometer control register */
 #define LSM6DS3_REG_CTRL2_G    0x11  /**< Gyroscope control register */
 #define LSM6DS3_REG_CTRL3_C    0x12  /**< Common settings register */
+#define LSM6DS3_REG_WAKE_UP_SRC 0x1B /**< Wake-up / free-fall event source register */
 #define LSM6DS3_REG_OUTX_L_G   0x22  /**< Gyroscope output register start */
 #define LSM6DS3_REG_OUTX_L_XL  0x28  /**< Accelerometer output register start */
+#define LSM6DS3_REG_FIFO_STATUS1 0x3A /**< FIFO unread words, low byte */
+#define LSM6DS3_REG_FIFO_STATUS2 0x3B /**< FIFO unread words high bits and flags */
+#define LSM6DS3_REG_FIFO_DATA_OUT_L 0x3E /**< FIFO data output */
+#define LSM6DS3_REG_TAP_CFG    0x58  /**< Timestamp, tap axes and interrupt latch register */
+#define LSM6DS3_REG_WAKE_UP_THS 0x5B /**< Wake-up threshold register */
+#define LSM6DS3_REG_WAKE_UP_DUR 0x5C /**< Wake-up / free-fall duration register */
+#define LSM6DS3_REG_FREE_FALL  0x5D  /**< Free-fall threshold and duration register */
+#define LSM6DS3_REG_MD1_CFG    0x5E  /**< INT1 routing of embedded functions */
+
+/// TAP_CFG bits (LSM6DS3; bit 7 is INTERRUPTS_ENABLE only on the LSM6DSL)
+#define LSM6DS3_TAP_CFG_TIMER_EN (1 << 7)  /**< Timestamp counter enable */
+#define LSM6DS3_TAP_CFG_LIR    (1 << 0)  /**< Latch events until the source register is read */
+
+/// MD1_CFG bits: embedded-function events routed to INT1
+#define LSM6DS3_MD1_CFG_INT1_WU (1 << 5) /**< Wake-up event on INT1 */
+#define LSM6DS3_MD1_CFG_INT1_FF (1 << 4) /**< Free-fall event on INT1 */
+
+/// WAKE_UP_SRC bits
+#define LSM6DS3_WU_SRC_FF_IA   (1 << 5)  /**< Free-fall event */
+#define LSM6DS3_WU_SRC_WU_IA   (1 << 3)  /**< Wake-up event */
 
 /** @} */
 
@@ -50,6 +73,18 @@ typedef enum {
     LSM6DS3_GYRO_2000DPS = 6
 } LSM6DS3_GyroFS;
 
+/** @brief Free-fall threshold */
+typedef enum {
+    LSM6DS3_FF_156MG = 0,
+    LSM6DS3_FF_219MG = 1,
+    LSM6DS3_FF_250MG = 2,
+    LSM6DS3_FF_312MG = 3,
+    LSM6DS3_FF_344MG = 4,
+    LSM6DS3_FF_406MG = 5,
+    LSM6DS3_FF_469MG = 6,
+    LSM6DS3_FF_500MG = 7
+} LSM6DS3_FreeFallThs;
+
 /** @brief Output data rate settings for accelerometer and gyroscope */
 typedef enum {
     LSM6DS3_ODR_OFF     = 0x00,
@@ -77,6 +112,10 @@ typedef struct {
 
     LSM6DS3_ODR accelODR;     /**< Accelerometer output data rate */
     LSM6DS3_ODR gyroODR;      /**< Gyroscope output data rate */
+
+    int16_t gyroBias[3];      /**< Gyroscope zero-rate bias (LSB) */
+    int16_t accelOffset[3];   /**< Accelerometer offset (LSB) */
+    int16_t accelGain[3];     /**< Accelerometer gain, Q14 (16384 = 1.0) */
 } LSM6DS3_Handle;
 
 /**
@@ -91,6 +130,18 @@ uint8_t LSM6DS3_Init(LSM6DS3_Handle *dev,
                      LSM6DS3_AccelFS accelFS,
                      LSM6DS3_GyroFS gyroFS);
 
+/**
+ * @brief Read raw acceleration and gyroscope samples from LSM6DS3
+ *
+ * Bias, offset and gain from LSM6DS3_SetCalibration() are applied.
+ * 
+ * @param dev Pointer to the device handle
+ * @param accel Output array for 3-axis raw acceleration (X, Y, Z) in LSB
+ * @param gyro Output array for 3-axis raw angular rate (X, Y, Z) in LSB
+ * @return 1 on success, 0 on failure
+ */
+uint8_t LSM6DS3_ReadRaw(LSM6DS3_Handle *dev, int16_t accel[3], int16_t gyro[3]);
+
 /**
  * @brief Read acceleration and gyroscope data from LSM6DS3
  * 
@@ -101,6 +152,102 @@ uint8_t LSM6DS3_Init(LSM6DS3_Handle *dev,
  */
 uint8_t LSM6DS3_ReadData(LSM6DS3_Handle *dev, float accel[3], float gyro[3]);
 
+/**
+ * @brief Set the correction applied in the read paths
+ *
+ * Corrected values are gyro - gyroBias and (accel - accelOffset) * accelGain / 16384.
+ * Passing NULL for an array restores the identity correction for it.
+ *
+ * @param dev Pointer to the device handle
+ * @param gyroBias Gyroscope bias X, Y, Z (LSB) or NULL
+ * @param accelOffset Accelerometer offset X, Y, Z (LSB) or NULL
+ * @param accelGain Accelerometer gain X, Y, Z (Q14) or NULL
+ */
+void LSM6DS3_SetCalibration(LSM6DS3_Handle *dev, const int16_t gyroBias[3],
+                            const int16_t accelOffset[3], const int16_t accelGain[3]);
+
+/**
+ * @brief Change accelerometer and gyroscope output data rates
+ *
+ * Full-scale settings are preserved.
+ *
+ * @param dev Pointer to the device handle
+ * @param accelODR New accelerometer ODR
+ * @param gyroODR New gyroscope ODR
+ * @return 1 on success, 0 on failure
+ */
+uint8_t LSM6DS3_SetODR(LSM6DS3_Handle *dev, LSM6DS3_ODR accelODR, LSM6DS3_ODR gyroODR);
+
+/**
+ * @brief Enable latched wake-up and free-fall embedded functions
+ *
+ * Events are routed to INT1 and latched in WAKE_UP_SRC, so they can be
+ * either wired to an external interrupt or polled with LSM6DS3_ReadEvents().
+ *
+ * @param dev Pointer to the device handle
+ * @param wakeThs Wake-up threshold, 1 LSB = full scale / 64 (0-63)
+ * @param ffThs Free-fall threshold
+ * @param ffDur Free-fall duration in ODR periods (0-31)
+ * @return 1 on success, 0 on failure
+ */
+uint8_t LSM6DS3_ConfigEvents(LSM6DS3_Handle *dev, uint8_t wakeThs,
+                             LSM6DS3_FreeFallThs ffThs, uint8_t ffDur);
+
+/**
+ * @brief Read and clear latched embedded-function events
+ *
+ * @param dev Pointer to the device handle
+ * @param[out] src WAKE_UP_SRC contents (LSM6DS3_WU_SRC_* bits)
+ * @return 1 on success, 0 on failure
+ */
+uint8_t LSM6DS3_ReadEvents(LSM6DS3_Handle *dev, uint8_t *src);
+
+/**
+ * @brief Convert an ODR setting to its nominal rate
+ *
+ * @param odr ODR setting
+ * @return Rate in Hz (12.5 Hz reported as 12)
+ */
+uint16_t LSM6DS3_ODRToHz(LSM6DS3_ODR odr);
+
+/**
+ * @brief Clear the FIFO and start collecting accelerometer samples
+ *
+ * Only the accelerometer is stored (X, Y, Z words per sample); the FIFO
+ * stops when full, so samples keep their exact ODR spacing until read.
+ *
+ * @param dev Pointer to the device handle
+ * @param odr FIFO ODR, normally equal to the accelerometer ODR
+ * @return 1 on success, 0 on failure
+ */
+uint8_t LSM6DS3_FifoStart(LSM6DS3_Handle *dev, LSM6DS3_ODR odr);
+
+/**
+ * @brief Stop and clear the FIFO (bypass mode)
+ *
+ * @param dev Pointer to the device handle
+ * @return 1 on success, 0 on failure
+ */
+uint8_t LSM6DS3_FifoStop(LSM6DS3_Handle *dev);
+
+/**
+ * @brief Get the number of complete accelerometer samples in the FIFO
+ *
+ * @param dev Pointer to the device handle
+ * @param[out] samples Unread samples
+ * @return 1 on success, 0 on failure
+ */
+uint8_t LSM6DS3_FifoLevel(LSM6DS3_Handle *dev, uint16_t *samples);
+
+/**
+ * @brief Pop one accelerometer sample from the FIFO (calibrated, LSB)
+ *
+ * @param dev Pointer to the device handle
+ * @param accel Output array for X, Y, Z
+ * @return 1 on success, 0 on failure
+ */
+uint8_t LSM6DS3_FifoReadAccel(LSM6DS3_Handle *dev, int16_t accel[3]);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,130 @@
+/**
+ * @file offload.c
+ * @brief Bulk log offload over the UART implementation
+ * @author Nate Hunter
+ * @date 2025-08-16
+ * @version v1.0.0
+ */
+
+#include "offload.h"
+#include "crc16.h"
+#include "time.h"
+#include "uart.h"
+#include <avr/wdt.h>
+
+/* Private helpers */
+
+static uint16_t OFFLOAD_Put(uint16_t crc, uint8_t b)
+{
+  UART_TransmitDirect(b);
+  return CRC16_Update(crc, b);
+}
+
+static uint16_t OFFLOAD_Put32(uint16_t crc, uint32_t v)
+{
+  for (uint8_t i = 0; i < 4; i++, v >>= 8)
+    crc = OFFLOAD_Put(crc, (uint8_t)v);
+  return crc;
+}
+
+static void OFFLOAD_End(uint16_t crc)
+{
+  UART_TransmitDirect((uint8_t)crc);
+  UART_TransmitDirect((uint8_t)(crc >> 8));
+}
+
+static void OFFLOAD_SendInfo(const OFFLOAD_Handle *ol)
+{
+  uint16_t crc = OFFLOAD_Put(CRC16_INIT, OFFLOAD_SYNC);
+  crc = OFFLOAD_Put(crc, 'I');
+  crc = OFFLOAD_Put(crc, OFFLOAD_VERSION);
+  crc = OFFLOAD_Put(crc, ol->sd->type);
+  crc = OFFLOAD_Put32(crc, OFFLOAD_BAUD);
+  crc = OFFLOAD_Put32(crc, ol->writeLba);
+  crc = OFFLOAD_Put32(crc, ol->endLba);
+  crc = OFFLOAD_Put(crc, (uint8_t)ol->boot);
+  crc = OFFLOAD_Put(crc, (uint8_t)(ol->boot >> 8));
+  OFFLOAD_End(crc);
+}
+
+/**
+ * @brief Copy one block from the card to the UART as it is read
+ * @return SD_Status of the read; an error reply was sent instead of data
+ */
+static SD_Status OFFLOAD_SendBlock(const OFFLOAD_Handle *ol, uint32_t lba)
+{
+  SD_Status status = ol->sd->type == SD_TYPE_NONE ? SD_NO_CARD : SD_ReadBegin(ol->sd, lba);
+
+  uint16_t crc = OFFLOAD_Put(CRC16_INIT, OFFLOAD_SYNC);
+  crc = OFFLOAD_Put(crc, status == SD_OK ? 'B' : 'E');
+  crc = OFFLOAD_Put32(crc, lba);
+  if (status == SD_OK) {
+    for (uint16_t i = 0; i < SD_BLOCK_SIZE; i++)
+      crc = OFFLOAD_Put(crc, SD_ReadByte(ol->sd));
+    SD_ReadEnd(ol->sd);
+  } else {
+    crc = OFFLOAD_Put(crc, status);
+  }
+  OFFLOAD_End(crc);
+  return status;
+}
+
+/* Public functions */
+
+uint32_t OFFLOAD_Run(const OFFLOAD_Handle *ol, uint32_t consoleBaud)
+{
+  uint8_t req[OFFLOAD_REQUEST_SIZE];
+  uint8_t n = 0;
+  uint32_t sent = 0;
+
+  UART_Flush();
+  OFFLOAD_SendInfo(ol);
+  UART_Flush();
+  UART_Init(OFFLOAD_BAUD);
+
+  uint32_t last = TIM_GetMillis();
+  while (TIM_GetMillis() - last < OFFLOAD_IDLE_MS) {
+    wdt_reset();
+    if (!UART_Available())
+      continue;
+
+    // Requests start with a known op; anything else is line noise
+    uint8_t b = UART_Receive();
+    uint32_t now = TIM_GetMillis();
+    if (now - last >= OFFLOAD_BYTE_TIMEOUT_MS)
+      n = 0;
+    last = now;
+    if (!n && b != 'I' && b != 'R' && b != 'Q')
+      continue;
+    req[n++] = b;
+    if (n < OFFLOAD_REQUEST_SIZE)
+      continue;
+    n = 0;
+
+    // A corrupted request is ignored; the host repeats it after a timeout
+    if (CRC16_Compute(req, OFFLOAD_REQUEST_SIZE - 2) !=
+        (req[7] | ((uint16_t)req[8] << 8)))
+      continue;
+
+    if (req[0] == 'Q')
+      break;
+    if (req[0] == 'I') {
+      OFFLOAD_SendInfo(ol);
+      continue;
+    }
+
+    uint32_t lba = req[1] | ((uint32_t)req[2] << 8) | ((uint32_t)req[3] << 16) | ((uint32_t)req[4] << 24);
+    uint16_t count = req[5] | ((uint16_t)req[6] << 8);
+    while (count-- && !UART_Available()) {
+      wdt_reset();
+      if (OFFLOAD_SendBlock(ol, lba++) != SD_OK)
+        break;
+      sent++;
+    }
+    last = TIM_GetMillis();
+  }
+
+  UART_Flush();
+  UART_Init(consoleBaud);
+  return sent;
+}
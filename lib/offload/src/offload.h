@@ -0,0 +1,77 @@
+/**
+ * @file offload.h
+ * @brief Bulk log offload over the UART: raw card blocks on request
+ * @author Nate Hunter
+ * @date 2025-08-16
+ * @version v1.0.0
+ *
+ * The host (tools/fdr_offload.py) asks for ranges of card blocks and gets
+ * each one as it comes off the card, with a CRC; it re-requests whatever
+ * fails or times out, so a transfer can be resumed at any block. The
+ * firmware knows nothing about files: the host reads the FAT itself.
+ *
+ * Little-endian fields, CRC-16/CCITT-FALSE (lib/crc16) over every byte
+ * before it:
+ *
+ *   request  host -> FDR  op | lba u32 | count u16 | crc
+ *            op 'I' info, 'R' read count blocks from lba, 'Q' quit
+ *   info     FDR -> host  A5 'I' | version | card type | baud u32 |
+ *                         write lba u32 | end lba u32 | boot u16 | crc
+ *   block    FDR -> host  A5 'B' | lba u32 | 512 data bytes | crc
+ *   error    FDR -> host  A5 'E' | lba u32 | SD_Status | crc
+ *
+ * A read stops early after an error reply or when the host sends a byte.
+ */
+
+#ifndef OFFLOAD_H
+#define OFFLOAD_H
+
+#include <stdint.h>
+#include "sd.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup OFFLOAD_Config Offload configuration
+ * @{
+ */
+#ifndef OFFLOAD_BAUD
+#define OFFLOAD_BAUD          1000000UL  ///< Transfer rate; 2000000 is exact at 16 MHz too
+#endif
+#ifndef OFFLOAD_IDLE_MS
+#define OFFLOAD_IDLE_MS       5000       ///< Back to the console after this long without a request
+#endif
+#ifndef OFFLOAD_BYTE_TIMEOUT_MS
+#define OFFLOAD_BYTE_TIMEOUT_MS 50       ///< A gap this long discards a partial request
+#endif
+#define OFFLOAD_VERSION       1          ///< Protocol version in the info reply
+#define OFFLOAD_SYNC          0xA5       ///< First byte of every reply
+#define OFFLOAD_REQUEST_SIZE  9
+/** @} */
+
+/**
+ * @brief What the info reply reports
+ */
+typedef struct {
+  SD_Handle *sd;               /**< Card, any stream stopped */
+  uint32_t writeLba;           /**< Next block of the live log, 0 if none */
+  uint32_t endLba;             /**< End of the live log file (exclusive) */
+  uint16_t boot;               /**< Cold-boot number of the live log */
+} OFFLOAD_Handle;
+
+/**
+ * @brief Send the info reply at the current baud rate, switch to
+ *        OFFLOAD_BAUD and serve requests until the host quits or goes
+ *        quiet, then switch back to @p consoleBaud. Feeds the watchdog.
+ * @param ol Card and log position
+ * @param consoleBaud Rate to restore
+ * @return Blocks sent
+ */
+uint32_t OFFLOAD_Run(const OFFLOAD_Handle *ol, uint32_t consoleBaud);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OFFLOAD_H */
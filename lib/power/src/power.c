@@ -0,0 +1,100 @@
+/**
+ * @file power.c
+ * @brief Battery state and power-saving level implementation
+ * @author Nate Hunter
+ * @date 2025-08-18
+ * @version v1.0.0
+ */
+
+#include "power.h"
+#include <avr/pgmspace.h>
+
+/** Resting 1S LiPo voltage at 0, 10, ... 100 % charge (mV) */
+static const uint16_t powerCurve[11] PROGMEM = {
+  3300, 3600, 3690, 3730, 3770, 3800, 3840, 3900, 3970, 4060, 4180
+};
+
+/* Private helpers */
+
+static uint8_t POWER_ChargeFromMv(uint16_t mv)
+{
+  uint16_t lo = pgm_read_word(&powerCurve[0]);
+  if (mv <= lo)
+    return 0;
+  for (uint8_t i = 1; i < 11; i++) {
+    uint16_t hi = pgm_read_word(&powerCurve[i]);
+    if (mv < hi)
+      return (uint8_t)((i - 1) * 10 + (uint16_t)(mv - lo) * 10 / (hi - lo));
+    lo = hi;
+  }
+  return 100;
+}
+
+static uint8_t POWER_Target(const POWER_Handle *pw, uint16_t mv, uint8_t pct)
+{
+  if (mv >= POWER_EXTERNAL_MV)
+    return POWER_NORMAL;
+  if (mv < pw->criticalMv || pct < POWER_CRITICAL_PCT)
+    return POWER_CRITICAL;
+  if (mv < pw->saveMv || pct < POWER_SAVE_PCT)
+    return POWER_SAVE;
+  return POWER_NORMAL;
+}
+
+/* Public functions */
+
+void POWER_Init(POWER_Handle *pw, uint16_t busMv, uint32_t nowMs)
+{
+  pw->busMv = busMv;
+  pw->avgMaQ8 = 0;
+  pw->remainingMas = (int32_t)pw->capacityMah * 36 * POWER_ChargeFromMv(busMv);
+  pw->carryMams = 0;
+  pw->lastMs = nowMs;
+  pw->level = POWER_Target(pw, busMv, POWER_GetCharge(pw));
+}
+
+uint8_t POWER_Update(POWER_Handle *pw, uint16_t busMv, int16_t currentMa, uint8_t alert, uint32_t nowMs)
+{
+  // Charge integral with the sub-second remainder carried over
+  int32_t mams = (int32_t)currentMa * (int32_t)(nowMs - pw->lastMs) + pw->carryMams;
+  pw->lastMs = nowMs;
+  pw->remainingMas -= mams / 1000;
+  pw->carryMams = (int16_t)(mams % 1000);
+  int32_t full = (int32_t)pw->capacityMah * 3600;
+  if (pw->remainingMas < 0)
+    pw->remainingMas = 0;
+  else if (pw->remainingMas > full)
+    pw->remainingMas = full;
+
+  // ~8 s voltage filter, ~1 min current average at one update per second
+  pw->busMv += ((int16_t)(busMv - pw->busMv)) / 8;
+  pw->avgMaQ8 += (((int32_t)currentMa << 8) - pw->avgMaQ8) / 64;
+
+  uint8_t pct = POWER_GetCharge(pw);
+  uint8_t level = alert ? POWER_CRITICAL : POWER_Target(pw, pw->busMv, pct);
+  if (level < pw->level) {
+    uint16_t mv = pw->busMv > POWER_HYST_MV ? pw->busMv - POWER_HYST_MV : 0;
+    uint8_t hyst = POWER_Target(pw, mv, pct > POWER_HYST_PCT ? pct - POWER_HYST_PCT : 0);
+    level = hyst < pw->level ? hyst : pw->level;
+  }
+  if (level == pw->level)
+    return 0;
+  pw->level = level;
+  return 1;
+}
+
+uint8_t POWER_GetCharge(const POWER_Handle *pw)
+{
+  if (!pw->capacityMah)
+    return 0;
+  return (uint8_t)(pw->remainingMas / ((int32_t)pw->capacityMah * 36));
+}
+
+uint16_t POWER_GetEndurance(const POWER_Handle *pw)
+{
+  int32_t ma = pw->avgMaQ8 >> 8;
+  if (ma <= 0)
+    return 0xFFFF;
+  uint32_t min = (uint32_t)pw->remainingMas / (uint32_t)ma / 60;
+  return min > 0xFFFE ? 0xFFFE : (uint16_t)min;
+}
@@ -0,0 +1,106 @@
+/**
+ * @file power.h
+ * @brief Battery state of charge, endurance estimate and power-saving level
+ * @author Nate Hunter
+ * @date 2025-08-18
+ * @version v1.0.0
+ *
+ * The charge starts from the bus voltage (resting 1S LiPo curve) and then
+ * follows the measured current (coulomb counting). Endurance is the
+ * remaining charge over the current averaged across about a minute.
+ *
+ * The level gets worse as soon as the filtered voltage, the charge or a
+ * hardware alert crosses a threshold, and better only with hysteresis,
+ * so a load step (LoRa TX) does not toggle it. Above POWER_EXTERNAL_MV
+ * the board runs from USB and the level stays normal.
+ */
+
+#ifndef POWER_H
+#define POWER_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup POWER_Config Thresholds
+ * @{
+ */
+#ifndef POWER_SAVE_PCT
+#define POWER_SAVE_PCT     30      ///< Charge below which the level is at least SAVE (%)
+#endif
+#ifndef POWER_CRITICAL_PCT
+#define POWER_CRITICAL_PCT 10      ///< Charge below which the level is CRITICAL (%)
+#endif
+#ifndef POWER_HYST_MV
+#define POWER_HYST_MV      100     ///< Voltage margin needed to improve the level (mV)
+#endif
+#ifndef POWER_HYST_PCT
+#define POWER_HYST_PCT     5       ///< Charge margin needed to improve the level (%)
+#endif
+#ifndef POWER_EXTERNAL_MV
+#define POWER_EXTERNAL_MV  4400    ///< Above a charged cell: USB supply (mV)
+#endif
+/** @} */
+
+/** @brief Power-saving levels */
+typedef enum {
+  POWER_NORMAL = 0,
+  POWER_SAVE,          ///< Reduced rates
+  POWER_CRITICAL,      ///< Minimum rates
+  POWER_LEVEL_COUNT
+} POWER_Level;
+
+/**
+ * @brief Governor state
+ */
+typedef struct {
+  uint16_t capacityMah;    /**< Battery capacity (mAh) */
+  uint16_t saveMv;         /**< Filtered voltage below which the level is at least SAVE */
+  uint16_t criticalMv;     /**< Filtered voltage below which the level is CRITICAL */
+
+  uint16_t busMv;          /**< Filtered bus voltage (mV) */
+  int32_t avgMaQ8;         /**< Averaged current (mA * 256) */
+  int32_t remainingMas;    /**< Charge left (mA*s) */
+  int16_t carryMams;       /**< Sub-second remainder of the charge integral (mA*ms) */
+  uint32_t lastMs;         /**< Time of the last update */
+  uint8_t level;           /**< POWER_Level */
+} POWER_Handle;
+
+/**
+ * @brief Start from the resting-voltage estimate of the charge
+ * @param pw Handle with capacity and voltage thresholds set
+ * @param busMv Bus voltage (mV)
+ * @param nowMs Current time (ms)
+ */
+void POWER_Init(POWER_Handle *pw, uint16_t busMv, uint32_t nowMs);
+
+/**
+ * @brief Integrate one measurement and re-evaluate the level
+ * @param pw Handle
+ * @param busMv Bus voltage (mV)
+ * @param currentMa Battery current (mA, positive = discharge)
+ * @param alert Hardware under-voltage alert seen since the last call
+ * @param nowMs Measurement time (ms)
+ * @return 1 if the level changed
+ */
+uint8_t POWER_Update(POWER_Handle *pw, uint16_t busMv, int16_t currentMa, uint8_t alert, uint32_t nowMs);
+
+/**
+ * @brief Remaining charge
+ * @return 0-100 (%)
+ */
+uint8_t POWER_GetCharge(const POWER_Handle *pw);
+
+/**
+ * @brief Time until the battery is empty at the averaged current
+ * @return Minutes, 0xFFFF if not discharging
+ */
+uint16_t POWER_GetEndurance(const POWER_Handle *pw);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* POWER_H */
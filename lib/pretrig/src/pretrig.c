@@ -0,0 +1,78 @@
+/**
+ * @file pretrig.c
+ * @brief Pre-trigger RAM ring buffer implementation
+ * @author Nate Hunter
+ * @date 2025-07-21
+ * @version v1.0.0
+ */
+
+#include "pretrig.h"
+
+// The ring is the largest buffer on a 2 KB part; a longer history must
+// trade resolution (PRETRIG_DECIMATION) rather than RAM
+_Static_assert(PRETRIG_DEPTH >= 1 && PRETRIG_DEPTH <= 255, "PRETRIG_DEPTH out of range");
+_Static_assert(PRETRIG_DEPTH * sizeof(PRETRIG_Record) <= PRETRIG_RAM_MAX,
+               "pre-trigger ring exceeds PRETRIG_RAM_MAX");
+
+void PRETRIG_Init(PRETRIG_Handle *pt)
+{
+  pt->head = 0;
+  pt->count = 0;
+  pt->decim = 0;
+  pt->newest = 0;
+}
+
+void PRETRIG_Push(PRETRIG_Handle *pt, uint32_t timestamp, uint32_t pressure,
+                  const int16_t accel[3], const int16_t gyro[3])
+{
+  if (++pt->decim < PRETRIG_DECIMATION)
+    return;
+  pt->decim = 0;
+
+  PRETRIG_Record *rec = &pt->ring[pt->head];
+  rec->tLow[0] = (uint8_t)timestamp;
+  rec->tLow[1] = (uint8_t)(timestamp >> 8);
+  rec->tLow[2] = (uint8_t)(timestamp >> 16);
+  rec->press[0] = (uint8_t)pressure;
+  rec->press[1] = (uint8_t)(pressure >> 8);
+  rec->press[2] = (uint8_t)(pressure >> 16);
+  for (uint8_t i = 0; i < 3; i++) {
+    rec->accel[i] = accel[i];
+    rec->gyro[i] = gyro[i];
+  }
+  pt->newest = timestamp;
+
+  if (++pt->head >= PRETRIG_DEPTH)
+    pt->head = 0;
+  if (pt->count < PRETRIG_DEPTH)
+    pt->count++;
+}
+
+uint8_t PRETRIG_Flush(PRETRIG_Handle *pt, PRETRIG_Sink sink)
+{
+  uint8_t n = pt->count;
+  uint8_t idx = (pt->head + PRETRIG_DEPTH - n) % PRETRIG_DEPTH;
+  PRETRIG_Sample s;
+
+  for (uint8_t i = 0; i < n; i++) {
+    const PRETRIG_Record *rec = &pt->ring[idx];
+
+    // Age relative to the newest record, wrap-safe over 24 bits
+    uint32_t tLow = (uint32_t)rec->tLow[0] | ((uint32_t)rec->tLow[1] << 8) |
+                    ((uint32_t)rec->tLow[2] << 16);
+    s.timestamp = pt->newest - ((pt->newest - tLow) & 0x00FFFFFFUL);
+    s.pressure = (uint32_t)rec->press[0] | ((uint32_t)rec->press[1] << 8) |
+                 ((uint32_t)rec->press[2] << 16);
+    for (uint8_t k = 0; k < 3; k++) {
+      s.accel[k] = rec->accel[k];
+      s.gyro[k] = rec->gyro[k];
+    }
+    sink(&s);
+
+    if (++idx >= PRETRIG_DEPTH)
+      idx = 0;
+  }
+
+  PRETRIG_Init(pt);
+  return n;
+}
@@ -0,0 +1,107 @@
+/**
+ * @file pretrig.h
+ * @brief Pre-trigger RAM ring buffer of packed IMU/baro records
+ * @author Nate Hunter
+ * @date 2025-07-21
+ * @version v1.0.0
+ */
+
+#ifndef PRETRIG_H
+#define PRETRIG_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup PRETRIG_Config Buffer sizing
+ * @{
+ */
+#ifndef PRETRIG_HISTORY_MS
+#define PRETRIG_HISTORY_MS  640  ///< History kept before the trigger (ms)
+#endif
+#ifndef PRETRIG_PERIOD_MS
+#define PRETRIG_PERIOD_MS   10   ///< Push period: the sample rate on the pad (ms)
+#endif
+#ifndef PRETRIG_DECIMATION
+#define PRETRIG_DECIMATION  4    ///< Keep one of every N pushed samples
+#endif
+#ifndef PRETRIG_DEPTH
+/** Records kept (18 bytes each): 640 ms at 40 ms spacing = 16 records, 288 bytes */
+#define PRETRIG_DEPTH       (PRETRIG_HISTORY_MS / (PRETRIG_PERIOD_MS * PRETRIG_DECIMATION))
+#endif
+#ifndef PRETRIG_RAM_MAX
+#define PRETRIG_RAM_MAX     320  ///< Ring size limit, checked at compile time (bytes)
+#endif
+/** @} */
+
+/**
+ * @brief Packed record stored in the ring (18 bytes)
+ * @note Only the low 24 bits of the timestamp are kept; the full value
+ *       is rebuilt from the newest record on flush, so the buffer may
+ *       span at most 16.7 s.
+ */
+typedef struct {
+  uint8_t tLow[3];     /**< Timestamp low 24 bits, little endian (us) */
+  uint8_t press[3];    /**< Pressure, 24-bit little endian (Pa) */
+  int16_t accel[3];    /**< Raw accelerometer (LSB) */
+  int16_t gyro[3];     /**< Raw gyroscope (LSB) */
+} PRETRIG_Record;
+
+/**
+ * @brief Unpacked sample handed to the flush sink
+ */
+typedef struct {
+  uint32_t timestamp;  /**< Absolute timestamp (us) */
+  uint32_t pressure;   /**< Pressure (Pa) */
+  int16_t accel[3];    /**< Raw accelerometer (LSB) */
+  int16_t gyro[3];     /**< Raw gyroscope (LSB) */
+} PRETRIG_Sample;
+
+/**
+ * @brief Flush callback, called once per record, oldest first
+ */
+typedef void (*PRETRIG_Sink)(const PRETRIG_Sample *sample);
+
+/**
+ * @brief Pre-trigger ring handle
+ */
+typedef struct {
+  PRETRIG_Record ring[PRETRIG_DEPTH]; /**< Record storage */
+  uint32_t newest;     /**< Full timestamp of the newest record (us) */
+  uint8_t head;        /**< Next write index */
+  uint8_t count;       /**< Valid records */
+  uint8_t decim;       /**< Decimation counter */
+} PRETRIG_Handle;
+
+/**
+ * @brief Clear the ring
+ * @param pt Pointer to ring handle
+ */
+void PRETRIG_Init(PRETRIG_Handle *pt);
+
+/**
+ * @brief Store a sample, overwriting the oldest record when full
+ * @param pt Pointer to ring handle
+ * @param timestamp Sample time (us)
+ * @param pressure Pressure (Pa)
+ * @param accel Raw accelerometer X, Y, Z
+ * @param gyro Raw gyroscope X, Y, Z
+ */
+void PRETRIG_Push(PRETRIG_Handle *pt, uint32_t timestamp, uint32_t pressure,
+                  const int16_t accel[3], const int16_t gyro[3]);
+
+/**
+ * @brief Hand all records to a sink in chronological order and clear the ring
+ * @param pt Pointer to ring handle
+ * @param sink Function receiving each unpacked sample
+ * @return Number of records flushed
+ */
+uint8_t PRETRIG_Flush(PRETRIG_Handle *pt, PRETRIG_Sink sink);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PRETRIG_H */
@@ -0,0 +1,89 @@
+/**
+ * @file prof.c
+ * @brief Hot-path profiling implementation
+ * @author Nate Hunter
+ * @date 2025-07-29
+ * @version v1.0.0
+ */
+
+#include "prof.h"
+
+#if PROF_ENABLE
+
+#include "time.h"
+#include "fmt.h"
+#include <avr/pgmspace.h>
+
+#define PROF_CYCLES_PER_TICK 64UL  ///< 16 MHz / prescaler 64
+
+static PROF_Stats profStats[PROF_COUNT];
+
+static const char profName0[] PROGMEM = "bmp_read";
+static const char profName1[] PROGMEM = "bmp_comp";
+static const char profName2[] PROGMEM = "imu_read";
+static const char profName3[] PROGMEM = "fusion";
+static const char profName4[] PROGMEM = "log_sample";
+static const char profName5[] PROGMEM = "fft";
+static const char profName6[] PROGMEM = "lora_tx";
+static const char profName7[] PROGMEM = "compress";
+
+static const char *const profNames[PROF_COUNT] PROGMEM = {
+  profName0, profName1, profName2, profName3, profName4, profName5, profName6,
+  profName7
+};
+
+uint32_t PROF_Begin(uint8_t id)
+{
+  // Folded at compile time; PROF_GPIO_REGION may name an enum value
+  if (PROF_GPIO_REGION != 0xFF && id == PROF_GPIO_REGION) {
+    PROF_GPIO_DDR |= (1 << PROF_GPIO_BIT);
+    PROF_GPIO_PORT |= (1 << PROF_GPIO_BIT);
+  }
+  return TIM_GetTicks();
+}
+
+void PROF_End(uint8_t id, uint32_t start)
+{
+  uint32_t d = TIM_GetTicks() - start;
+
+  if (PROF_GPIO_REGION != 0xFF && id == PROF_GPIO_REGION)
+    PROF_GPIO_PORT &= ~(1 << PROF_GPIO_BIT);
+
+  PROF_Stats *s = &profStats[id];
+  uint16_t d16 = d > 0xFFFF ? 0xFFFF : (uint16_t)d;
+  if (!s->count || d16 < s->min)
+    s->min = d16;
+  if (d16 > s->max)
+    s->max = d16;
+  s->sum += d;
+  s->count++;
+}
+
+void PROF_Reset(void)
+{
+  for (uint8_t i = 0; i < PROF_COUNT; i++) {
+    profStats[i].count = 0;
+    profStats[i].sum = 0;
+    profStats[i].min = 0;
+    profStats[i].max = 0;
+  }
+}
+
+uint8_t PROF_Format(uint8_t id, char *buf)
+{
+  const PROF_Stats *s = &profStats[id];
+
+  char *p = FMT_StrP(buf, PSTR("PRF:\t"));
+  p = FMT_StrP(p, (const char *)pgm_read_word(&profNames[id]));
+  p = FMT_StrP(p, PSTR("\tn:\t"));
+  p = FMT_UInt(p, s->count);
+  p = FMT_StrP(p, PSTR("\tmin:\t"));
+  p = FMT_UInt(p, s->min * PROF_CYCLES_PER_TICK);
+  p = FMT_StrP(p, PSTR("\tmean:\t"));
+  p = FMT_UInt(p, s->count ? s->sum / s->count * PROF_CYCLES_PER_TICK : 0);
+  p = FMT_StrP(p, PSTR("\tmax:\t"));
+  p = FMT_UInt(p, s->max * PROF_CYCLES_PER_TICK);
+  return (uint8_t)(FMT_End(p) - buf);
+}
+
+#endif /* PROF_ENABLE */
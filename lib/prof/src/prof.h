@@ -0,0 +1,98 @@
+/**
+ * @file prof.h
+ * @brief Compile-time enabled hot-path profiling (Timer1 tick statistics)
+ * @author Nate Hunter
+ * @date 2025-07-29
+ * @version v1.0.0
+ *
+ * Wrap a region with PROF_BEGIN(id) / PROF_END(id) in the same block.
+ * With PROF_ENABLE=0 (default) the markers expand to nothing and no
+ * table is allocated. One Timer1 tick is 4 us (64 CPU cycles); the
+ * markers themselves add roughly one tick per region.
+ */
+
+#ifndef PROF_H
+#define PROF_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup PROF_Config Profiling configuration
+ * @{
+ */
+#ifndef PROF_ENABLE
+#define PROF_ENABLE       0         ///< 1 = collect region statistics
+#endif
+#ifndef PROF_GPIO_REGION
+#define PROF_GPIO_REGION  0xFF      ///< Region mirrored on the probe pin, 0xFF = none
+#endif
+#ifndef PROF_GPIO_PORT
+#define PROF_GPIO_PORT    PORTD     ///< Probe pin port (high while inside the region)
+#define PROF_GPIO_DDR     DDRD      ///< Probe pin direction register
+#define PROF_GPIO_BIT     PD7       ///< Probe pin (D7, unused on the FDR board)
+#endif
+/** @} */
+
+/** @brief Profiled regions */
+typedef enum {
+  PROF_BMP_READ = 0,    ///< BMP280_ReadData (bus + compensation)
+  PROF_BMP_COMPENSATE,  ///< BMP280_Compensate only
+  PROF_IMU_READ,        ///< LSM6DS3_ReadRaw
+  PROF_FUSION,          ///< Kalman predict + correct
+  PROF_LOG_SAMPLE,      ///< Text / binary sample line
+  PROF_FFT,             ///< FFT_Process
+  PROF_LORA_TX,         ///< LoRa_Transmit
+  PROF_COMPRESS,        ///< RICE_Encode of a live sample
+  PROF_COUNT
+} PROF_Region;
+
+#if PROF_ENABLE
+
+#include <avr/io.h>
+
+/** @brief Per-region statistics (Timer1 ticks) */
+typedef struct {
+  uint32_t count;       /**< Completed passes */
+  uint32_t sum;         /**< Sum of durations */
+  uint16_t min;         /**< Shortest duration */
+  uint16_t max;         /**< Longest duration (saturates at 65535) */
+} PROF_Stats;
+
+/** @brief Start a region, returns the start tick */
+uint32_t PROF_Begin(uint8_t id);
+
+/** @brief Close a region started at @p start */
+void PROF_End(uint8_t id, uint32_t start);
+
+/** @brief Clear all statistics */
+void PROF_Reset(void);
+
+/**
+ * @brief Format one region as a text line, durations in CPU cycles
+ *
+ * "PRF:\t<name>\tn:\t<count>\tmin:\t<c>\tmean:\t<c>\tmax:\t<c>"
+ *
+ * @param id Region
+ * @param buf Output buffer (>= 80 bytes)
+ * @return Line length
+ */
+uint8_t PROF_Format(uint8_t id, char *buf);
+
+#define PROF_BEGIN(id)  uint32_t prof_start_##id = PROF_Begin(id)
+#define PROF_END(id)    PROF_End(id, prof_start_##id)
+
+#else
+
+#define PROF_BEGIN(id)  ((void)0)
+#define PROF_END(id)    ((void)0)
+
+#endif /* PROF_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PROF_H */
@@ -0,0 +1,137 @@
+/**
+ * @file restart.c
+ * @brief Reset-cause detection and flight-state checkpoint implementation
+ * @author Nate Hunter
+ * @date 2025-08-05
+ * @version v1.0.0
+ */
+
+#include "restart.h"
+#include "crc16.h"
+#include <avr/io.h>
+#include <avr/eeprom.h>
+#include <avr/wdt.h>
+#include <stddef.h>
+#include <string.h>
+
+/** MCUSR at start-up, written before .data/.bss are initialised */
+static uint8_t restartCause __attribute__((section(".noinit")));
+
+/** Copy kept across watchdog / brown-out resets */
+static RESTART_State restartRam __attribute__((section(".noinit")));
+
+/** Checkpoints kept across power loss; written alternately so a torn write
+ *  always leaves the previous one intact */
+static RESTART_State EEMEM restartEeprom[2];
+
+/** Cold boots since the EEPROM was erased */
+static uint16_t EEMEM restartBootCount;
+
+/** Checkpoint being copied to EEPROM, one byte per RESTART_Service() */
+static RESTART_State restartPending;
+static uint8_t restartSlot;                          ///< Slot being / last written
+static uint8_t restartIdx = sizeof(RESTART_State);   ///< Next byte, size = idle
+
+/**
+ * @brief Save and clear MCUSR and stop a watchdog left running by the reset
+ *        (WDRF keeps WDE set, the next timeout would hit in the C runtime)
+ */
+void RESTART_SaveCause(void) __attribute__((naked, used, section(".init3")));
+void RESTART_SaveCause(void)
+{
+  uint8_t bootCopy;
+  __asm__ __volatile__("mov %0, r2" : "=r"(bootCopy));
+  restartCause = MCUSR ? MCUSR : bootCopy;
+  MCUSR = 0;
+  wdt_disable();
+}
+
+/**
+ * @brief 1 if @p st is sealed and intact
+ */
+static uint8_t RESTART_Valid(const RESTART_State *st)
+{
+  return st->magic == RESTART_MAGIC &&
+         CRC16_Compute(st, offsetof(RESTART_State, crc)) == st->crc;
+}
+
+uint8_t RESTART_GetCause(void)
+{
+  return restartCause;
+}
+
+uint8_t RESTART_Load(RESTART_State *st)
+{
+  uint8_t source = RESTART_COLD;
+
+  // Power-on often latches BORF along with PORF: that, and the reset
+  // button, is a cold boot whatever else is set
+  if ((restartCause & ((1 << WDRF) | (1 << BORF))) &&
+      !(restartCause & ((1 << PORF) | (1 << EXTRF)))) {
+    if (RESTART_Valid(&restartRam)) {
+      *st = restartRam;
+      source = RESTART_WARM_RAM;
+    } else {
+      // Newest intact slot
+      for (uint8_t i = 0; i < 2; i++) {
+        eeprom_read_block(&restartPending, &restartEeprom[i], sizeof(restartPending));
+        if (RESTART_Valid(&restartPending) &&
+            (source == RESTART_COLD || restartPending.timeMs > st->timeMs)) {
+          *st = restartPending;
+          restartSlot = i;
+          source = RESTART_WARM_EEPROM;
+        }
+      }
+    }
+  }
+
+  if (source == RESTART_COLD) {
+    memset(st, 0, sizeof(*st));
+    RESTART_Clear();
+  } else {
+    st->restarts++;
+  }
+  return source;
+}
+
+uint16_t RESTART_NewBoot(void)
+{
+  uint16_t boot = eeprom_read_word(&restartBootCount) + 1;
+  eeprom_update_word(&restartBootCount, boot);
+  return boot;
+}
+
+void RESTART_Update(RESTART_State *st)
+{
+  st->magic = RESTART_MAGIC;
+  st->crc = CRC16_Compute(st, offsetof(RESTART_State, crc));
+  restartRam = *st;
+}
+
+void RESTART_Checkpoint(RESTART_State *st)
+{
+  RESTART_Update(st);
+  // A checkpoint still in progress is overwritten in the same slot
+  if (restartIdx >= sizeof(RESTART_State))
+    restartSlot ^= 1;
+  restartPending = *st;
+  restartIdx = 0;
+}
+
+void RESTART_Service(void)
+{
+  if (restartIdx >= sizeof(RESTART_State) || !eeprom_is_ready())
+    return;
+  eeprom_update_byte((uint8_t *)&restartEeprom[restartSlot] + restartIdx,
+                     ((const uint8_t *)&restartPending)[restartIdx]);
+  restartIdx++;
+}
+
+void RESTART_Clear(void)
+{
+  restartRam.magic = 0;
+  restartIdx = sizeof(RESTART_State);
+  // No write when already erased
+  eeprom_update_word(&restartEeprom[0].magic, 0xFFFF);
+  eeprom_update_word(&restartEeprom[1].magic, 0xFFFF);
+}
@@ -0,0 +1,108 @@
+/**
+ * @file restart.h
+ * @brief Reset-cause detection and flight-state checkpoint for warm restarts
+ * @author Nate Hunter
+ * @date 2025-08-05
+ * @version v1.0.0
+ *
+ * The application keeps a small RESTART_State up to date: every sample in a
+ * .noinit RAM block (survives watchdog and most brown-out resets, costs one
+ * CRC) and on every flight-phase change in EEPROM (survives anything, but
+ * is stale by up to one phase). The EEPROM copy is written one byte per
+ * RESTART_Service() call, so a checkpoint never stalls acquisition for the
+ * ~3.4 ms per byte an EEPROM write takes. After a watchdog or brown-out reset
+ * RESTART_Load returns the newest valid copy so the recorder can resume
+ * acquisition without POST and baro settling.
+ */
+
+#ifndef RESTART_H
+#define RESTART_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RESTART_MAGIC  0x5752   ///< "RW", marks a written state
+
+/** @brief Where the resumed state came from */
+typedef enum {
+  RESTART_COLD = 0,    ///< Power-on, reset button or no valid state: full boot
+  RESTART_WARM_RAM,    ///< .noinit copy, as of the last sample
+  RESTART_WARM_EEPROM  ///< EEPROM checkpoint, as of the last phase change
+} RESTART_Source;
+
+/**
+ * @brief State needed to continue a flight log (36 bytes)
+ */
+typedef struct {
+  uint16_t magic;          /**< RESTART_MAGIC */
+  uint8_t restarts;        /**< Warm restarts since the cold boot */
+  uint8_t phase;           /**< FLIGHT_Phase */
+  uint32_t timeMs;         /**< Time of this snapshot (ms) */
+  uint32_t phaseStartMs;   /**< Start of the current phase (ms) */
+  int32_t maxAltitude;     /**< Apogee tracking (cm) */
+  uint32_t baroRef;        /**< Zero-level pressure (Pa) */
+  uint16_t frameSeq;       /**< Next frame sequence number */
+  uint32_t logPos;         /**< Next block of the storage log */
+  uint32_t logEnd;         /**< End of the storage log (exclusive), 0 if none */
+  uint32_t logSeq;         /**< Sequence number of the block at logPos */
+  uint16_t bootId;         /**< Cold-boot counter of this log */
+  uint16_t crc;            /**< CRC-16 over all preceding bytes */
+} RESTART_State;
+
+/**
+ * @brief Reset cause as read from MCUSR at start-up (PORF, EXTRF, BORF, WDRF bits)
+ * @note Captured in .init3 before the bootloader value is lost; with
+ *       Optiboot, which clears MCUSR, the copy it leaves in r2 is used.
+ */
+uint8_t RESTART_GetCause(void);
+
+/**
+ * @brief Pick the state to resume from
+ * @param[out] st Resumed state (restarts already incremented), zeroed on a cold boot
+ * @return RESTART_Source
+ * @note Only watchdog and brown-out resets without PORF / EXTRF resume;
+ *       a cold boot also drops the EEPROM checkpoint so a later power-on
+ *       cannot pick it up.
+ */
+uint8_t RESTART_Load(RESTART_State *st);
+
+/**
+ * @brief Count a cold boot
+ * @return New value of the cold-boot counter kept in EEPROM
+ * @note Blocks for one EEPROM word write
+ */
+uint16_t RESTART_NewBoot(void);
+
+/**
+ * @brief Seal the state and copy it to the .noinit block (every sample)
+ * @param st State, crc is updated
+ */
+void RESTART_Update(RESTART_State *st);
+
+/**
+ * @brief RESTART_Update plus an EEPROM checkpoint (phase changes only)
+ * @param st State, crc is updated
+ * @note Queued; written by RESTART_Service()
+ */
+void RESTART_Checkpoint(RESTART_State *st);
+
+/**
+ * @brief Write the next byte of a queued checkpoint if the EEPROM is idle
+ * @note Never waits; call once per sample
+ */
+void RESTART_Service(void);
+
+/**
+ * @brief Invalidate the RAM copy and both EEPROM slots, e.g. after landing
+ * @note Blocks for up to four EEPROM byte writes
+ */
+void RESTART_Clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RESTART_H */
@@ -0,0 +1,150 @@
+/**
+ * @file rice.c
+ * @brief Lossless delta + Rice coding implementation
+ * @author Nate Hunter
+ * @date 2025-08-14
+ * @version v1.0.0
+ */
+
+#include "rice.h"
+#include <avr/pgmspace.h>
+#include <string.h>
+
+/** @brief MSB-first bit writer over a bounded buffer */
+typedef struct {
+  uint8_t *buf;
+  uint8_t cap;       ///< Buffer size (bytes)
+  uint8_t pos;       ///< Current byte
+  uint8_t bit;       ///< Free bits left in the current byte (8 = empty)
+  uint8_t full;      ///< Ran out of space
+} RICE_Writer;
+
+/* Private helpers */
+
+static void RICE_PutBits(RICE_Writer *w, uint32_t value, uint8_t n)
+{
+  while (n && !w->full) {
+    if (w->bit == 8) {
+      if (w->pos >= w->cap) {
+        w->full = 1;
+        return;
+      }
+      w->buf[w->pos] = 0;
+    }
+    uint8_t take = n < w->bit ? n : w->bit;
+    uint8_t chunk = (uint8_t)(value >> (n - take)) & (uint8_t)((1 << take) - 1);
+    w->bit -= take;
+    w->buf[w->pos] |= chunk << w->bit;
+    n -= take;
+    if (!w->bit) {
+      w->bit = 8;
+      w->pos++;
+    }
+  }
+}
+
+static void RICE_PutOnes(RICE_Writer *w, uint8_t n)
+{
+  while (n >= 8) {
+    RICE_PutBits(w, 0xFF, 8);
+    n -= 8;
+  }
+  RICE_PutBits(w, (1 << n) - 1, n);
+}
+
+/** @brief Read a channel, widened to 32 bits */
+static uint32_t RICE_Get(const uint8_t *p, uint8_t type)
+{
+  if (type == RICE_U8)
+    return p[0];
+  if (type == RICE_I16)
+    return (uint32_t)(int32_t)(int16_t)(p[0] | (p[1] << 8));
+  return p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint8_t RICE_BitLength(uint32_t u)
+{
+  uint8_t n = 0;
+  while (u) {
+    u >>= 1;
+    n++;
+  }
+  return n;
+}
+
+/* Public functions */
+
+void RICE_Init(RICE_Handle *rz, const RICE_Channel *channels, uint8_t count, uint8_t size)
+{
+  memset(rz, 0, sizeof(*rz));
+  rz->channels = channels;
+  rz->count = count;
+  rz->size = size;
+}
+
+void RICE_Reset(RICE_Handle *rz)
+{
+  rz->valid = 0;
+}
+
+uint8_t RICE_Encode(RICE_Handle *rz, const void *record, uint8_t *out)
+{
+  const uint8_t *cur = (const uint8_t *)record;
+  RICE_Writer w = { out, (uint8_t)(rz->size - 1), 0, 8, 0 };
+  uint8_t len = 0;
+
+  rz->rawBytes += rz->size;
+
+  if (rz->valid) {
+    uint8_t k[RICE_MAX_CHANNELS];
+    int32_t timeStep = rz->timeStep;
+    memcpy(k, rz->k, rz->count);
+
+    for (uint8_t c = 0; c < rz->count && !w.full; c++) {
+      uint8_t offset = pgm_read_byte(&rz->channels[c].offset);
+      uint8_t type = pgm_read_byte(&rz->channels[c].type);
+      uint32_t value = RICE_Get(cur + offset, type);
+      uint32_t pred = RICE_Get(rz->prev + offset, type);
+      if (type == RICE_T32) {
+        uint32_t step = value - pred;
+        pred += (uint32_t)timeStep;
+        timeStep = (int32_t)step;
+      }
+      int32_t r = (int32_t)(value - pred);
+      uint32_t u = ((uint32_t)r << 1) ^ (uint32_t)(r >> 31);
+
+      uint32_t q = u >> k[c];
+      if (q >= RICE_ESCAPE) {
+        RICE_PutOnes(&w, RICE_ESCAPE);
+        RICE_PutBits(&w, u, 32);
+        k[c] = RICE_BitLength(u) - 1;
+      } else {
+        RICE_PutOnes(&w, (uint8_t)q);
+        RICE_PutBits(&w, 0, 1);
+        RICE_PutBits(&w, u, k[c]);
+        if (q > 1)
+          k[c]++;
+        else if (!q && k[c] && u < (1UL << (k[c] - 1)))
+          k[c]--;
+      }
+    }
+
+    if (!w.full) {
+      len = w.pos + (w.bit != 8);
+      memcpy(rz->k, k, rz->count);
+      rz->timeStep = timeStep;
+    }
+  }
+
+  if (!len) {
+    // Key: restart every channel from its initial parameter
+    for (uint8_t c = 0; c < rz->count; c++)
+      rz->k[c] = pgm_read_byte(&rz->channels[c].k0);
+    rz->timeStep = 0;
+  }
+
+  memcpy(rz->prev, cur, rz->size);
+  rz->valid = 1;
+  rz->codedBytes += len ? len : rz->size;
+  return len;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file rice.h
+ * @brief Lossless delta + Rice coding of fixed-layout records
+ * @author Nate Hunter
+ * @date 2025-08-14
+ * @version v1.0.0
+ *
+ * Each channel of a record is predicted from the previous record (the
+ * timestamp channel linearly from the previous two), the residual is
+ * zigzag mapped and Rice coded with a per-channel parameter k that adapts
+ * after every value. Bits are packed MSB first.
+ *
+ * A record with no reference (after RICE_Reset) or one that would not get
+ * smaller is not coded; the caller stores it raw as a key and the
+ * predictor restarts from it. Decoding needs the key and every coded
+ * record after it, so the caller resets wherever the stream must become
+ * independently decodable (e.g. at each storage block).
+ *
+ * Code for one residual u with parameter k:
+ *   q = u >> k;  q < RICE_ESCAPE: q ones, a zero, then the low k bits of u
+ *                otherwise:       RICE_ESCAPE ones, then u as 32 bits
+ * Adaptation: after an escape k = bit length of u - 1; otherwise k + 1
+ * if q > 1, k - 1 if q == 0 and u < 2^(k-1).
+ */
+
+#ifndef RICE_H
+#define RICE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup RICE_Config Codec limits
+ * @{
+ */
+#ifndef RICE_MAX_RECORD
+#define RICE_MAX_RECORD    40    ///< Largest record (bytes)
+#endif
+#ifndef RICE_MAX_CHANNELS
+#define RICE_MAX_CHANNELS  16    ///< Most channels per record
+#endif
+#define RICE_ESCAPE        16    ///< Unary length that introduces a raw value
+/** @} */
+
+/** @brief Channel types (little endian in the record) */
+typedef enum {
+  RICE_U8 = 0,     ///< Unsigned byte
+  RICE_I16,        ///< Signed 16-bit
+  RICE_I32,        ///< Signed 32-bit
+  RICE_U32,        ///< Unsigned 32-bit, differences wrap
+  RICE_T32         ///< Unsigned 32-bit time, second-order prediction (one per record)
+} RICE_Type;
+
+/**
+ * @brief Channel description, kept in PROGMEM
+ */
+typedef struct {
+  uint8_t offset;    /**< Byte offset in the record */
+  uint8_t type;      /**< RICE_Type */
+  uint8_t k0;        /**< Rice parameter after a key */
+} RICE_Channel;
+
+/**
+ * @brief Coder state
+ */
+typedef struct {
+  const RICE_Channel *channels;    /**< PROGMEM channel table */
+  uint8_t count;                   /**< Channels */
+  uint8_t size;                    /**< Record size (bytes) */
+  uint8_t valid;                   /**< prev holds a reference */
+  uint8_t k[RICE_MAX_CHANNELS];    /**< Current Rice parameters */
+  uint8_t prev[RICE_MAX_RECORD];   /**< Reference record */
+  int32_t timeStep;                /**< Last step of the RICE_T32 channel */
+  uint32_t rawBytes;               /**< Record bytes passed to RICE_Encode */
+  uint32_t codedBytes;             /**< Bytes out: coded length or record size for keys */
+} RICE_Handle;
+
+/**
+ * @brief Set up a coder
+ * @param rz Coder
+ * @param channels PROGMEM channel table
+ * @param count Number of channels (<= RICE_MAX_CHANNELS)
+ * @param size Record size (<= RICE_MAX_RECORD)
+ */
+void RICE_Init(RICE_Handle *rz, const RICE_Channel *channels, uint8_t count, uint8_t size);
+
+/**
+ * @brief Make the next record a key
+ * @param rz Coder
+ */
+void RICE_Reset(RICE_Handle *rz);
+
+/**
+ * @brief Code one record against the reference, then make it the reference
+ * @param rz Coder
+ * @param record Record of rz->size bytes
+ * @param out Output, at least rz->size - 1 bytes
+ * @return Coded length, or 0 if the record must be stored raw as a key
+ */
+uint8_t RICE_Encode(RICE_Handle *rz, const void *record, uint8_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RICE_H */
@@ -0,0 +1,213 @@
+/**
+ * @file sched.c
+ * @brief Time-triggered cooperative scheduler implementation
+ * @author Nate Hunter
+ * @date 2025-07-28
+ * @version v1.0.0
+ */
+
+#include "sched.h"
+#include "time.h"
+#include "fmt.h"
+#include <avr/pgmspace.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+
+static SCHED_Task *schedTasks;
+static uint8_t schedCount;
+static uint32_t schedWindowStart;  ///< Start of the statistics window (us)
+static uint32_t schedSleepUs;      ///< Time spent asleep in the window (us)
+static uint32_t schedSleeps;       ///< Sleep entries in the window
+static uint32_t schedWakeMax;      ///< Longest planned-wake overshoot (us)
+
+static void SCHED_ClearStats(SCHED_Task *t)
+{
+  t->runs = 0;
+  t->execSum = 0;
+  t->execMax = 0;
+  t->latencyMin = UINT32_MAX;
+  t->latencyMax = 0;
+  t->misses = 0;
+}
+
+void SCHED_Init(SCHED_Task *tasks, uint8_t count)
+{
+  uint32_t now = TIM_GetMicros();
+
+  schedTasks = tasks;
+  schedCount = count;
+  for (uint8_t i = 0; i < count; i++) {
+    tasks[i].release = now + tasks[i].phase;
+    SCHED_ClearStats(&tasks[i]);
+  }
+  schedWindowStart = now;
+  schedSleepUs = 0;
+  schedSleeps = 0;
+  schedWakeMax = 0;
+}
+
+uint8_t SCHED_Run(void)
+{
+  uint32_t now = TIM_GetMicros();
+  SCHED_Task *t = 0;
+
+  for (uint8_t i = 0; i < schedCount; i++) {
+    SCHED_Task *c = &schedTasks[i];
+    if (!c->period || (int32_t)(now - c->release) < 0)
+      continue;
+    if (!t || c->priority < t->priority ||
+        (c->priority == t->priority && (int32_t)(c->release - t->release) < 0))
+      t = c;
+  }
+  if (!t)
+    return 0;
+
+  uint32_t start = TIM_GetMicros();
+  uint32_t latency = start - t->release;
+  t->fn();
+  uint32_t end = TIM_GetMicros();
+  uint32_t exec = end - start;
+
+  t->runs++;
+  t->execSum += exec;
+  if (exec > t->execMax)
+    t->execMax = exec;
+  if (latency < t->latencyMin)
+    t->latencyMin = latency;
+  if (latency > t->latencyMax)
+    t->latencyMax = latency;
+
+  // Keep the phase; releases already in the past are dropped, not queued
+  if (t->period) {
+    t->release += t->period;
+    while ((int32_t)(end - t->release) > 0) {
+      t->release += t->period;
+      if (t->misses < UINT16_MAX)
+        t->misses++;
+    }
+  }
+  return 1;
+}
+
+void SCHED_Idle(void)
+{
+  // One read for both domains: micros wrap after 71.6 min, ticks do not
+  uint32_t ticks = TIM_GetTicks();
+  uint32_t now = ticks * TIM_TICK_US;
+  uint32_t next = 0;
+  uint8_t any = 0;
+
+  for (uint8_t i = 0; i < schedCount; i++) {
+    const SCHED_Task *t = &schedTasks[i];
+    if (!t->period)
+      continue;
+    if (!any || (int32_t)(t->release - next) < 0)
+      next = t->release;
+    any = 1;
+  }
+
+  int32_t slack = any ? (int32_t)(next - now) : INT32_MAX;
+  if (slack < SCHED_IDLE_MIN_US)
+    return;
+
+#if SCHED_IDLE_SLEEP
+  uint32_t wake = next - SCHED_WAKE_LEAD_US;
+  uint8_t armed = any && TIM_WakeAt(ticks + (uint32_t)(slack - SCHED_WAKE_LEAD_US) / TIM_TICK_US);
+
+  // sei() takes effect after the next instruction, so no interrupt can
+  // slip in between enabling and entering sleep
+  set_sleep_mode(SLEEP_MODE_IDLE);
+  cli();
+  sleep_enable();
+  sei();
+  sleep_cpu();
+  sleep_disable();
+
+  uint32_t woke = TIM_GetMicros();
+  schedSleepUs += woke - now;
+  schedSleeps++;
+  if (armed && (int32_t)(woke - wake) >= 0 && woke - wake > schedWakeMax)
+    schedWakeMax = woke - wake;
+#endif
+}
+
+void SCHED_SetPeriod(uint8_t id, uint32_t periodUs)
+{
+  if (id >= schedCount)
+    return;
+  SCHED_Task *t = &schedTasks[id];
+  // Re-enabled tasks start now instead of catching up from a stale release
+  if (!t->period)
+    t->release = TIM_GetMicros();
+  t->period = periodUs;
+}
+
+void SCHED_ResetStats(void)
+{
+  for (uint8_t i = 0; i < schedCount; i++)
+    SCHED_ClearStats(&schedTasks[i]);
+  schedWindowStart = TIM_GetMicros();
+  schedSleepUs = 0;
+  schedSleeps = 0;
+  schedWakeMax = 0;
+}
+
+uint8_t SCHED_TaskCount(void)
+{
+  return schedCount;
+}
+
+uint8_t SCHED_FormatTask(uint8_t id, char *buf)
+{
+  if (id >= schedCount) {
+    *buf = '\0';
+    return 0;
+  }
+  const SCHED_Task *t = &schedTasks[id];
+  uint32_t window = TIM_GetMicros() - schedWindowStart;
+  uint32_t jitter = t->runs ? t->latencyMax - t->latencyMin : 0;
+
+  char *p = FMT_StrP(buf, PSTR("SCH:\t"));
+  p = FMT_StrP(p, t->name);
+  p = FMT_StrP(p, PSTR("\tT:\t"));
+  p = FMT_UInt(p, t->period);
+  p = FMT_StrP(p, PSTR("us\tn:\t"));
+  p = FMT_UInt(p, t->runs);
+  p = FMT_StrP(p, PSTR("\texe:\t"));
+  p = FMT_UInt(p, t->runs ? t->execSum / t->runs : 0);
+  *p++ = '/';
+  p = FMT_UInt(p, t->execMax);
+  p = FMT_StrP(p, PSTR("us\tlat:\t"));
+  p = FMT_UInt(p, t->latencyMax);
+  p = FMT_StrP(p, PSTR("us\tjit:\t"));
+  p = FMT_UInt(p, jitter);
+  p = FMT_StrP(p, PSTR("us\tmiss:\t"));
+  p = FMT_UInt(p, t->misses);
+  p = FMT_StrP(p, PSTR("\tload:\t"));
+  // Share of the window spent in this task, 0.01 % units
+  p = FMT_Fixed(p, window >= 10000UL ? (int32_t)(t->execSum / (window / 10000UL)) : 0, 2);
+  *p++ = '%';
+  return (uint8_t)(FMT_End(p) - buf);
+}
+
+uint16_t SCHED_GetSleepShare(void)
+{
+  uint32_t window = TIM_GetMicros() - schedWindowStart;
+  if (window < 10000UL)
+    return 0;
+  return (uint16_t)(schedSleepUs / (window / 10000UL));
+}
+
+uint8_t SCHED_FormatIdle(char *buf)
+{
+  char *p = FMT_StrP(buf, PSTR("IDLE:\tsleep:\t"));
+  p = FMT_Fixed(p, SCHED_GetSleepShare(), 2);
+  p = FMT_StrP(p, PSTR("%\tn:\t"));
+  p = FMT_UInt(p, schedSleeps);
+  p = FMT_StrP(p, PSTR("\twake:\t"));
+  p = FMT_UInt(p, schedWakeMax);
+  p = FMT_StrP(p, PSTR("us\twin:\t"));
+  p = FMT_UInt(p, (TIM_GetMicros() - schedWindowStart) / 1000UL);
+  p = FMT_StrP(p, PSTR("ms"));
+  return (uint8_t)(FMT_End(p) - buf);
+}
@@ -0,0 +1,139 @@
+/**
+ * @file sched.h
+ * @brief Time-triggered cooperative scheduler with per-task timing statistics
+ * @author Nate Hunter
+ * @date 2025-07-28
+ * @version v1.0.0
+ *
+ * Tasks are released every period (us) from their phase offset and run to
+ * completion. When several are due, the lowest priority value runs first,
+ * then the oldest release. A release that is already in the past when the
+ * previous instance finishes is dropped and counted as a deadline miss.
+ */
+
+#ifndef SCHED_H
+#define SCHED_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup SCHED_Config Idle configuration
+ * @{
+ */
+#ifndef SCHED_IDLE_SLEEP
+#define SCHED_IDLE_SLEEP     1    ///< Sleep (Idle mode) between releases, 0 = spin
+#endif
+#ifndef SCHED_IDLE_MIN_US
+#define SCHED_IDLE_MIN_US    40   ///< Do not sleep for less than this (us)
+#endif
+#ifndef SCHED_WAKE_LEAD_US
+#define SCHED_WAKE_LEAD_US   8    ///< Wake this early to cover wake-up and ISR entry (us)
+#endif
+/** @} */
+
+/** @brief Task body */
+typedef void (*SCHED_Fn)(void);
+
+/**
+ * @brief Task table entry
+ * @note Configuration first so tables can be written with SCHED_TASK().
+ */
+typedef struct {
+  SCHED_Fn fn;           /**< Task body */
+  const char *name;      /**< PROGMEM name for reports */
+  uint32_t period;       /**< Release period (us), 0 disables the task */
+  uint32_t phase;        /**< First release offset from SCHED_Init (us) */
+  uint8_t priority;      /**< Lower value runs first */
+
+  uint32_t release;      /**< Next release time (us) */
+  uint32_t runs;         /**< Completed runs */
+  uint32_t execSum;      /**< Sum of execution times (us) */
+  uint32_t execMax;      /**< Longest execution (us) */
+  uint32_t latencyMin;   /**< Shortest release-to-start delay (us) */
+  uint32_t latencyMax;   /**< Longest release-to-start delay (us) */
+  uint16_t misses;       /**< Releases dropped because the task ran late */
+} SCHED_Task;
+
+/** @brief Static task table initializer */
+#define SCHED_TASK(name, fn, periodUs, phaseUs, prio) \
+  { (fn), (name), (periodUs), (phaseUs), (prio), 0, 0, 0, 0, 0, 0, 0 }
+
+/**
+ * @brief Install a task table and release every task at now + phase
+ * @param tasks Task table (kept by reference)
+ * @param count Number of tasks
+ */
+void SCHED_Init(SCHED_Task *tasks, uint8_t count);
+
+/**
+ * @brief Run the most urgent due task, if any
+ * @return 1 if a task ran, 0 if none was due
+ */
+uint8_t SCHED_Run(void);
+
+/**
+ * @brief Wait for the next release
+ *
+ * Puts the CPU into Idle sleep until the next interrupt. Timer0/2 (LED
+ * PWM), Timer1 (timebase) and the UART keep running in Idle. A Timer1
+ * compare-B wake-up is armed SCHED_WAKE_LEAD_US before the next release
+ * when it falls inside the current millisecond; otherwise the 1 ms tick
+ * wakes the CPU and the caller simply calls SCHED_Run() again.
+ * Call when SCHED_Run() returned 0.
+ */
+void SCHED_Idle(void);
+
+/**
+ * @brief Change a task period; takes effect from its next release
+ * @param id Task index
+ * @param periodUs New period (us), 0 disables the task
+ */
+void SCHED_SetPeriod(uint8_t id, uint32_t periodUs);
+
+/**
+ * @brief Clear all statistics and start a new measurement window
+ */
+void SCHED_ResetStats(void);
+
+/** @brief Number of installed tasks */
+uint8_t SCHED_TaskCount(void);
+
+/**
+ * @brief Format one task's statistics as a text line
+ *
+ * "SCH:\t<name>\tT:\t<period>us\tn:\t<runs>\texe:\t<mean>/<max>us\t
+ *  lat:\t<max>us\tjit:\t<max-min>us\tmiss:\t<misses>\tload:\t<%>"
+ *
+ * @param id Task index
+ * @param buf Output buffer (>= 128 bytes)
+ * @return Line length
+ */
+uint8_t SCHED_FormatTask(uint8_t id, char *buf);
+
+/**
+ * @brief Format the sleep / active duty cycle as a text line
+ *
+ * "IDLE:\tsleep:\t<%>\tn:\t<sleeps>\twake:\t<max>us\twin:\t<window>ms"
+ *
+ * wake is the longest delay between a planned compare-B wake-up and the
+ * CPU running again.
+ *
+ * @param buf Output buffer (>= 80 bytes)
+ * @return Line length
+ */
+uint8_t SCHED_FormatIdle(char *buf);
+
+/**
+ * @brief Sleep share of the current measurement window
+ * @return Sleep time in 0.01 % units
+ */
+uint16_t SCHED_GetSleepShare(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCHED_H */
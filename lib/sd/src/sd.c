@@ -0,0 +1,405 @@
+/**
+ * @file sd.c
+ * @brief microSD card driver over SPI implementation
+ * @author Nate Hunter
+ * @date 2025-08-08
+ * @version v1.0.0
+ */
+
+#include "sd.h"
+#include "time.h"
+#include "bustrace.h"
+
+/* Commands */
+#define SD_CMD0    0     ///< GO_IDLE_STATE
+#define SD_CMD8    8     ///< SEND_IF_COND
+#define SD_CMD16   16    ///< SET_BLOCKLEN
+#define SD_CMD17   17    ///< READ_SINGLE_BLOCK
+#define SD_CMD24   24    ///< WRITE_BLOCK
+#define SD_CMD25   25    ///< WRITE_MULTIPLE_BLOCK
+#define SD_CMD55   55    ///< APP_CMD
+#define SD_CMD58   58    ///< READ_OCR
+#define SD_ACMD23  23    ///< SET_WR_BLK_ERASE_COUNT
+#define SD_ACMD41  41    ///< SD_SEND_OP_COND
+
+/* Tokens and responses */
+#define SD_R1_IDLE           0x01
+#define SD_R1_ILLEGAL        0x04
+#define SD_TOKEN_DATA        0xFE   ///< Single block read / write
+#define SD_TOKEN_MULTI       0xFC   ///< Multi-block write, data follows
+#define SD_TOKEN_STOP        0xFD   ///< Multi-block write, stop
+#define SD_DATA_ACCEPTED     0x05
+
+/* Private helpers */
+
+static void SD_Select(SD_Handle *sd)
+{
+  SPI_SetClock(sd->sck);
+  *(sd->csPort) &= ~(1 << sd->csPin);
+}
+
+static void SD_Deselect(SD_Handle *sd)
+{
+  *(sd->csPort) |= (1 << sd->csPin);
+  SPI_Transmit(sd->spi, 0xFF);        // Card releases MISO on the next clock
+  SPI_SetClock(sd->spi->config.clockDiv);
+}
+
+/**
+ * @brief Clock the bus until the card stops signalling busy
+ * @return 1 if ready, 0 on timeout
+ */
+static uint8_t SD_WaitReady(SD_Handle *sd, uint16_t timeoutMs)
+{
+  uint32_t start = TIM_GetMillis();
+  while (SPI_Transmit(sd->spi, 0xFF) != 0xFF) {
+    if (TIM_GetMillis() - start >= timeoutMs)
+      return 0;
+  }
+  return 1;
+}
+
+/**
+ * @brief Send a command frame and return its R1 response
+ * @note CS must already be low; 0xFF means no response
+ */
+static uint8_t SD_Command(SD_Handle *sd, uint8_t cmd, uint32_t arg)
+{
+  uint8_t r1;
+
+  if (cmd != SD_CMD0)
+    SD_WaitReady(sd, SD_BUSY_TIMEOUT_MS);
+
+  BUSTRACE_BEGIN();
+  SPI_Transmit(sd->spi, 0x40 | cmd);
+  SPI_Transmit(sd->spi, (uint8_t)(arg >> 24));
+  SPI_Transmit(sd->spi, (uint8_t)(arg >> 16));
+  SPI_Transmit(sd->spi, (uint8_t)(arg >> 8));
+  SPI_Transmit(sd->spi, (uint8_t)arg);
+  // CRC is only checked for CMD0 and CMD8 in SPI mode
+  SPI_Transmit(sd->spi, cmd == SD_CMD0 ? 0x95 : cmd == SD_CMD8 ? 0x87 : 0x01);
+
+  for (uint8_t i = 0; i < 8; i++) {
+    r1 = SPI_Transmit(sd->spi, 0xFF);
+    if (!(r1 & 0x80))
+      break;
+  }
+  BUSTRACE_END(BUSTRACE_SPI | sd->csPin, cmd, 6, (r1 & 0xFE) != 0);
+  return r1;
+}
+
+static uint8_t SD_AppCommand(SD_Handle *sd, uint8_t cmd, uint32_t arg)
+{
+  SD_Command(sd, SD_CMD55, 0);
+  return SD_Command(sd, cmd, arg);
+}
+
+/** @brief Block number to command argument */
+static uint32_t SD_Address(const SD_Handle *sd, uint32_t lba)
+{
+  return sd->type == SD_TYPE_SDHC ? lba : lba << 9;
+}
+
+/**
+ * @brief Open the next stream block: wait out the previous block's busy,
+ *        then send the data token
+ */
+static SD_Status SD_BeginBlock(SD_Handle *sd)
+{
+  if (sd->lba >= sd->endLba)
+    return SD_END_OF_STREAM;
+  if (!sd->streaming)
+    return SD_WRITE_ERROR;
+
+  SD_Select(sd);
+  uint32_t t0 = TIM_GetMicros();
+  uint8_t ready = SD_WaitReady(sd, SD_BUSY_TIMEOUT_MS);
+  uint32_t waitUs = TIM_GetMicros() - t0;
+  if (waitUs > sd->maxBusyUs)
+    sd->maxBusyUs = waitUs > 0xFFFF ? 0xFFFF : (uint16_t)waitUs;
+  if (!ready) {
+    SD_Deselect(sd);
+    sd->errors++;
+    return SD_TIMEOUT;
+  }
+
+  SPI_Transmit(sd->spi, SD_TOKEN_MULTI);
+  sd->open = 1;
+  sd->blockPos = 0;
+  return SD_OK;
+}
+
+/**
+ * @brief Finish the full block and release the bus without waiting for busy
+ */
+static SD_Status SD_EndBlock(SD_Handle *sd)
+{
+  BUSTRACE_BEGIN();
+  SPI_Transmit(sd->spi, 0xFF);        // CRC, not checked
+  SPI_Transmit(sd->spi, 0xFF);
+  uint8_t resp = SPI_Transmit(sd->spi, 0xFF) & 0x1F;
+  BUSTRACE_END(BUSTRACE_SPI | sd->csPin, SD_TOKEN_MULTI, 0, resp != SD_DATA_ACCEPTED);
+  SD_Deselect(sd);
+
+  sd->open = 0;
+  sd->lba++;
+  sd->blocks++;
+  if (resp != SD_DATA_ACCEPTED) {
+    sd->errors++;
+    return SD_WRITE_ERROR;
+  }
+  if (sd->lba >= sd->endLba)
+    return SD_StreamStop(sd);
+  return SD_OK;
+}
+
+/* Public functions */
+
+SD_Status SD_Init(SD_Handle *sd)
+{
+  uint8_t r1, ocr[4];
+  uint8_t v2 = 0;
+
+  sd->type = SD_TYPE_NONE;
+  sd->streaming = sd->open = 0;
+  sd->sck = SPI_CLOCK_DIV128;         // <= 400 kHz until initialized
+
+  *(sd->csPort) |= (1 << sd->csPin);
+  SPI_SetClock(sd->sck);
+  for (uint8_t i = 0; i < 10; i++)    // >= 74 clocks with CS high
+    SPI_Transmit(sd->spi, 0xFF);
+
+  // A card left inside a CMD25 stream by an MCU reset: complete the open
+  // block and stop the stream. An idle card ignores both.
+  SD_Select(sd);
+  for (uint16_t i = 0; i < SD_BLOCK_SIZE + 3; i++)
+    SPI_Transmit(sd->spi, 0xFF);
+  SPI_Transmit(sd->spi, SD_TOKEN_STOP);
+  SPI_Transmit(sd->spi, 0xFF);
+  SD_WaitReady(sd, SD_BUSY_TIMEOUT_MS);
+
+  for (uint8_t i = 0; (r1 = SD_Command(sd, SD_CMD0, 0)) != SD_R1_IDLE; i++) {
+    if (i == 10) {
+      SD_Deselect(sd);
+      return SD_NO_CARD;
+    }
+  }
+
+  // Version 2 cards echo the check pattern
+  if (!(SD_Command(sd, SD_CMD8, 0x1AA) & SD_R1_ILLEGAL)) {
+    for (uint8_t i = 0; i < 4; i++)
+      ocr[i] = SPI_Transmit(sd->spi, 0xFF);
+    if (ocr[2] != 0x01 || ocr[3] != 0xAA) {
+      SD_Deselect(sd);
+      return SD_UNSUPPORTED;
+    }
+    v2 = 1;
+  }
+
+  uint32_t start = TIM_GetMillis();
+  while ((r1 = SD_AppCommand(sd, SD_ACMD41, v2 ? 0x40000000UL : 0)) != 0) {
+    if ((r1 & ~SD_R1_IDLE) || TIM_GetMillis() - start >= SD_INIT_TIMEOUT_MS) {
+      SD_Deselect(sd);
+      return r1 & ~SD_R1_IDLE ? SD_UNSUPPORTED : SD_TIMEOUT;
+    }
+  }
+
+  sd->type = SD_TYPE_SDSC;
+  if (v2 && SD_Command(sd, SD_CMD58, 0) == 0) {
+    for (uint8_t i = 0; i < 4; i++)
+      ocr[i] = SPI_Transmit(sd->spi, 0xFF);
+    if (ocr[0] & 0x40)                // CCS: block addressed
+      sd->type = SD_TYPE_SDHC;
+  }
+  if (sd->type == SD_TYPE_SDSC && SD_Command(sd, SD_CMD16, SD_BLOCK_SIZE) != 0) {
+    SD_Deselect(sd);
+    sd->type = SD_TYPE_NONE;
+    return SD_UNSUPPORTED;
+  }
+
+  SD_Deselect(sd);
+  sd->sck = sd->clockDiv;
+  return SD_OK;
+}
+
+SD_Status SD_ReadBlock(SD_Handle *sd, uint32_t lba, uint8_t *buf)
+{
+  SD_Status status = SD_ReadBegin(sd, lba);
+  if (status == SD_OK) {
+    for (uint16_t i = 0; i < SD_BLOCK_SIZE; i++)
+      buf[i] = SD_ReadByte(sd);
+    SD_ReadEnd(sd);
+  }
+  return status;
+}
+
+SD_Status SD_ReadBegin(SD_Handle *sd, uint32_t lba)
+{
+  SD_Status status = SD_READ_ERROR;
+
+  if (sd->streaming)
+    return SD_READ_ERROR;
+
+  SD_Select(sd);
+  if (SD_Command(sd, SD_CMD17, SD_Address(sd, lba)) == 0) {
+    uint32_t start = TIM_GetMillis();
+    uint8_t token;
+    while ((token = SPI_Transmit(sd->spi, 0xFF)) == 0xFF) {
+      if (TIM_GetMillis() - start >= SD_READ_TIMEOUT_MS)
+        break;
+    }
+    if (token == SD_TOKEN_DATA)
+      return SD_OK;                   // Card keeps the bus until SD_ReadEnd
+    if (token == 0xFF)
+      status = SD_TIMEOUT;
+  }
+  SD_Deselect(sd);
+  return status;
+}
+
+uint8_t SD_ReadByte(SD_Handle *sd)
+{
+  return SPI_Transmit(sd->spi, 0xFF);
+}
+
+void SD_ReadEnd(SD_Handle *sd)
+{
+  SPI_Transmit(sd->spi, 0xFF);        // CRC
+  SPI_Transmit(sd->spi, 0xFF);
+  SD_Deselect(sd);
+}
+
+SD_Status SD_WriteBlock(SD_Handle *sd, uint32_t lba, const uint8_t *buf)
+{
+  SD_Status status = SD_WRITE_ERROR;
+
+  SD_Select(sd);
+  if (SD_Command(sd, SD_CMD24, SD_Address(sd, lba)) == 0) {
+    SPI_Transmit(sd->spi, SD_TOKEN_DATA);
+    SPI_TransmitBlock(sd->spi, buf, SD_BLOCK_SIZE);
+    SPI_Transmit(sd->spi, 0xFF);      // CRC
+    SPI_Transmit(sd->spi, 0xFF);
+    if ((SPI_Transmit(sd->spi, 0xFF) & 0x1F) == SD_DATA_ACCEPTED)
+      status = SD_WaitReady(sd, SD_BUSY_TIMEOUT_MS) ? SD_OK : SD_TIMEOUT;
+  }
+  SD_Deselect(sd);
+  return status;
+}
+
+SD_Status SD_StreamStart(SD_Handle *sd, uint32_t lba, uint32_t endLba)
+{
+  if (sd->type == SD_TYPE_NONE || lba >= endLba)
+    return SD_WRITE_ERROR;
+
+  // Pre-erase hint; optional for the card, so its answer is not checked
+  uint32_t count = endLba - lba;
+  SD_Select(sd);
+  SD_AppCommand(sd, SD_ACMD23, count < SD_PRE_ERASE_BLOCKS ? count : SD_PRE_ERASE_BLOCKS);
+  uint8_t r1 = SD_Command(sd, SD_CMD25, SD_Address(sd, lba));
+  SD_Deselect(sd);
+  if (r1 != 0)
+    return SD_WRITE_ERROR;
+
+  sd->streaming = 1;
+  sd->open = 0;
+  sd->waitSinceUs = 0;
+  sd->lba = lba;
+  sd->endLba = endLba;
+  return SD_OK;
+}
+
+uint8_t SD_StreamReady(SD_Handle *sd)
+{
+  if (sd->open || !sd->streaming)
+    return 1;
+
+  SD_Select(sd);
+  uint8_t ready = SPI_Transmit(sd->spi, 0xFF) == 0xFF;
+  SD_Deselect(sd);
+
+  uint32_t now = TIM_GetMicros();
+  if (!ready) {
+    if (!sd->waitSinceUs)
+      sd->waitSinceUs = now | 1;
+    return 0;
+  }
+  if (sd->waitSinceUs) {
+    uint32_t ms = (now - sd->waitSinceUs) / 1000;
+    if (ms > sd->maxWaitMs)
+      sd->maxWaitMs = ms > 0xFFFF ? 0xFFFF : (uint16_t)ms;
+    sd->waitSinceUs = 0;
+  }
+  return 1;
+}
+
+SD_Status SD_StreamWrite(SD_Handle *sd, const void *data, uint16_t len)
+{
+  const uint8_t *p = (const uint8_t *)data;
+  SD_Status status = SD_OK;
+
+  while (len && status == SD_OK) {
+    if (!sd->open && (status = SD_BeginBlock(sd)) != SD_OK)
+      break;
+    uint16_t n = SD_BLOCK_SIZE - sd->blockPos;
+    if (n > len)
+      n = len;
+    SPI_TransmitBlock(sd->spi, p, n);
+    p += n;
+    len -= n;
+    sd->blockPos += n;
+    if (sd->blockPos == SD_BLOCK_SIZE)
+      status = SD_EndBlock(sd);
+  }
+  return status;
+}
+
+SD_Status SD_StreamFill(SD_Handle *sd, uint8_t value, uint16_t count)
+{
+  SD_Status status = SD_OK;
+
+  while (count && status == SD_OK) {
+    if (!sd->open && (status = SD_BeginBlock(sd)) != SD_OK)
+      break;
+    uint16_t n = SD_BLOCK_SIZE - sd->blockPos;
+    if (n > count)
+      n = count;
+    count -= n;
+    sd->blockPos += n;
+    while (n--)
+      SPI_Transmit(sd->spi, value);
+    if (sd->blockPos == SD_BLOCK_SIZE)
+      status = SD_EndBlock(sd);
+  }
+  return status;
+}
+
+SD_Status SD_StreamPad(SD_Handle *sd)
+{
+  if (!sd->open)
+    return SD_OK;
+  return SD_StreamFill(sd, 0x00, SD_BLOCK_SIZE - sd->blockPos);
+}
+
+SD_Status SD_StreamStop(SD_Handle *sd)
+{
+  SD_Status status = SD_OK;
+
+  if (!sd->streaming)
+    return SD_OK;
+  if (sd->open) {
+    // Padding the last block re-enters here through SD_EndBlock
+    sd->endLba = sd->lba + 1;
+    return SD_StreamPad(sd);
+  }
+
+  SD_Select(sd);
+  if (!SD_WaitReady(sd, SD_BUSY_TIMEOUT_MS))
+    status = SD_TIMEOUT;
+  SPI_Transmit(sd->spi, SD_TOKEN_STOP);
+  SPI_Transmit(sd->spi, 0xFF);
+  if (!SD_WaitReady(sd, SD_BUSY_TIMEOUT_MS))
+    status = SD_TIMEOUT;
+  SD_Deselect(sd);
+  sd->streaming = 0;
+  return status;
+}
@@ -0,0 +1,189 @@
+/**
+ * @file sd.h
+ * @brief microSD card driver over SPI: block I/O and streaming multi-block writes
+ * @author Nate Hunter
+ * @date 2025-08-08
+ * @version v1.0.0
+ *
+ * Supports SDHC/SDXC (block addressed) and SDSC cards. Logging uses a
+ * CMD25 stream that is fed byte-wise, so no 512-byte buffer is needed in
+ * RAM: a data block is opened on the first byte, closed after the 512th,
+ * and the card's programming time (busy) is not waited for until the next
+ * block starts.
+ *
+ * SD_StreamReady() lets a caller that must not stall check the busy state
+ * first and open the next block only once the card can take it.
+ *
+ * While a block is open the card keeps the bus (CS low). Other devices on
+ * the same SPI bus must call SD_StreamPad() before their transaction; CS
+ * is released between blocks, including while the card is busy.
+ */
+
+#ifndef SD_H
+#define SD_H
+
+#include <stdint.h>
+#include "spi_driver.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SD_BLOCK_SIZE          512
+
+#ifndef SD_INIT_TIMEOUT_MS
+#define SD_INIT_TIMEOUT_MS     1000  ///< ACMD41 initialization limit
+#endif
+#ifndef SD_BUSY_TIMEOUT_MS
+#define SD_BUSY_TIMEOUT_MS     250   ///< Longest write busy allowed by the SD spec
+#endif
+#ifndef SD_PRE_ERASE_BLOCKS
+#define SD_PRE_ERASE_BLOCKS    8192  ///< ACMD23 count for streams, one 4 MB allocation unit
+#endif
+#ifndef SD_READ_TIMEOUT_MS
+#define SD_READ_TIMEOUT_MS     100   ///< Data token wait on reads
+#endif
+
+/** @brief Status codes */
+typedef enum {
+  SD_OK = 0,
+  SD_NO_CARD,         ///< No answer to CMD0
+  SD_UNSUPPORTED,     ///< Not an SD card, or voltage range rejected
+  SD_TIMEOUT,         ///< Initialization, busy or data token timeout
+  SD_READ_ERROR,      ///< Command or data error on a read
+  SD_WRITE_ERROR,     ///< Command rejected or data block not accepted
+  SD_END_OF_STREAM    ///< Stream reached its end LBA, data dropped
+} SD_Status;
+
+/** @brief Card type */
+typedef enum {
+  SD_TYPE_NONE = 0,
+  SD_TYPE_SDSC,       ///< Byte addressed, <= 2 GB
+  SD_TYPE_SDHC        ///< Block addressed, SDHC / SDXC
+} SD_Type;
+
+/**
+ * @brief Card handle
+ */
+typedef struct {
+  SPI_HandleTypeDef *spi;      /**< Shared SPI bus */
+  volatile uint8_t *csPort;    /**< Chip-select port */
+  uint8_t csPin;               /**< Chip-select pin */
+  uint8_t clockDiv;            /**< SCK divider after init (SPI_CLOCK_DIV2) */
+
+  uint8_t type;                /**< SD_Type, set by SD_Init */
+  uint8_t sck;                 /**< SCK divider in use */
+
+  uint8_t streaming;           /**< CMD25 in progress */
+  uint8_t open;                /**< Data block open (card owns the bus) */
+  uint16_t blockPos;           /**< Bytes written into the open block */
+  uint32_t lba;                /**< Block the stream writes next */
+  uint32_t endLba;             /**< Stream end (exclusive) */
+
+  uint32_t blocks;             /**< Blocks written by streams */
+  uint16_t errors;             /**< Rejected or timed-out stream blocks */
+  uint16_t maxBusyUs;          /**< Longest blocking busy wait before a stream block (us) */
+  uint16_t maxWaitMs;          /**< Longest busy seen by SD_StreamReady (ms) */
+  uint32_t waitSinceUs;        /**< First busy SD_StreamReady poll, 0 if none pending */
+} SD_Handle;
+
+/**
+ * @brief Initialize the card (CMD0, CMD8, ACMD41, CMD58) at 125 kHz, then
+ *        switch to the handle's clockDiv
+ * @param sd Handle with spi, csPort, csPin and clockDiv set
+ * @return SD_Status
+ */
+SD_Status SD_Init(SD_Handle *sd);
+
+/**
+ * @brief Read one block
+ * @param sd Handle
+ * @param lba Block address
+ * @param buf 512-byte destination
+ * @return SD_Status
+ */
+SD_Status SD_ReadBlock(SD_Handle *sd, uint32_t lba, uint8_t *buf);
+
+/**
+ * @brief Start reading one block without a buffer (CMD17): on SD_OK the
+ *        card holds the bus until exactly SD_BLOCK_SIZE SD_ReadByte()
+ *        calls and SD_ReadEnd(). Not available while a stream is open.
+ * @param sd Handle
+ * @param lba Block address
+ * @return SD_Status
+ */
+SD_Status SD_ReadBegin(SD_Handle *sd, uint32_t lba);
+
+/**
+ * @brief Next byte of the block started by SD_ReadBegin()
+ * @param sd Handle
+ * @return Data byte
+ */
+uint8_t SD_ReadByte(SD_Handle *sd);
+
+/**
+ * @brief Skip the block CRC and release the bus
+ * @param sd Handle
+ */
+void SD_ReadEnd(SD_Handle *sd);
+
+/**
+ * @brief Write one block and wait until it is programmed (CMD24)
+ * @param sd Handle
+ * @param lba Block address
+ * @param buf 512-byte source
+ * @return SD_Status
+ */
+SD_Status SD_WriteBlock(SD_Handle *sd, uint32_t lba, const uint8_t *buf);
+
+/**
+ * @brief Start a multi-block write stream (ACMD23 pre-erase count, CMD25)
+ * @param sd Handle
+ * @param lba First block
+ * @param endLba Stream stops before this block
+ * @return SD_Status
+ */
+SD_Status SD_StreamStart(SD_Handle *sd, uint32_t lba, uint32_t endLba);
+
+/**
+ * @brief Check without waiting whether stream bytes can be written now
+ * @param sd Handle
+ * @return 1 if a block is open or the card finished programming the last
+ *         one; 0 while it is busy (the busy time is tracked in maxWaitMs)
+ */
+uint8_t SD_StreamReady(SD_Handle *sd);
+
+/**
+ * @brief Append bytes to the stream
+ * @param sd Handle
+ * @param data Bytes
+ * @param len Number of bytes
+ * @return SD_Status; on error the remaining bytes are dropped
+ */
+SD_Status SD_StreamWrite(SD_Handle *sd, const void *data, uint16_t len);
+
+/**
+ * @brief Append @p count copies of @p value to the stream
+ * @return SD_Status
+ */
+SD_Status SD_StreamFill(SD_Handle *sd, uint8_t value, uint16_t count);
+
+/**
+ * @brief Close the open block by padding it with zeros and release the bus
+ * @param sd Handle
+ * @return SD_Status
+ */
+SD_Status SD_StreamPad(SD_Handle *sd);
+
+/**
+ * @brief Pad the open block and end the stream (stop token)
+ * @param sd Handle
+ * @return SD_Status
+ */
+SD_Status SD_StreamStop(SD_Handle *sd);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SD_H */
@@ -47,10 +47,21 @@ void SPI_Init(SPI_HandleTypeDef *hspi)
             break;
     }
 
-    // Set clock divider
+    SPI_SetClock(hspi->config.clockDiv);
+}
+
+/**
+ * @brief Change the SCK divider, e.g. per device on a shared bus
+ * @param clockDiv SPI_CLOCK_DIVx
+ */
+void SPI_SetClock(uint8_t clockDiv)
+{
     SPCR &= ~((1 << SPR1) | (1 << SPR0));
     SPSR &= ~(1 << SPI2X);
-    switch (hspi->config.clockDiv) {
+    switch (clockDiv) {
+        case SPI_CLOCK_DIV2:
+            SPSR |= (1 << SPI2X);
+            break;
         case SPI_CLOCK_DIV4:
             break;
         case SPI_CLOCK_DIV16:
@@ -77,10 +88,10 @@ uint8_t SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t data)
 {
     (void)hspi; // Not used for now
 
-    SPDR = data;
-    while (!(SPSR & (1 << SPIF))); // Wait for transmission complete
+    HAL_WRITE(SPDR, data);
+    while (!(HAL_READ(SPSR) & (1 << SPIF))); // Wait for transmission complete
 
-    return SPDR; // Return received byte
+    return HAL_READ(SPDR); // Return received byte
 }
 
 /**
@@ -103,3 +114,27 @@ uint8_t SPI_TransmitReceive(SPI_HandleTypeDef *hspi, uint8_t data)
 {
     return SPI_Transmit(hspi, data);
 }
+
+/**
+ * @brief Transmit a buffer, discarding received bytes
+ * @param hspi Pointer to the SPI handle structure
+ * @param data Bytes to send
+ * @param len Number of bytes
+ * @note The next byte is fetched while the current one shifts out, so at
+ *       SPI_CLOCK_DIV2 the bus runs close to 1 us per byte.
+ */
+void SPI_TransmitBlock(SPI_HandleTypeDef *hspi, const uint8_t *data, uint16_t len)
+{
+    (void)hspi;
+
+    if (!len)
+        return;
+    HAL_WRITE(SPDR, *data++);
+    while (--len) {
+        uint8_t next = *data++;
+        while (!(HAL_READ(SPSR) & (1 << SPIF)));
+        HAL_WRITE(SPDR, next);
+    }
+    while (!(HAL_READ(SPSR) & (1 << SPIF)));
+    (void)HAL_READ(SPDR);
+}
@@ -10,7 +10,7 @@
 #define SPI_DRIVER_H
 
 #include <stdint.h>
-#include <avr/io.h>
+#include "hal.h"
 
 /**
  * @brief SPI configuration structure
@@ -33,6 +33,7 @@ typedef struct {
 #define SPI_CLOCK_DIV16   1
 #define SPI_CLOCK_DIV64   2
 #define SPI_CLOCK_DIV128  3
+#define SPI_CLOCK_DIV2    4  /**< SPI2X, 8 MHz at 16 MHz */
 
 // SPI mode macros
 #define SPI_MODE0         0  /**< CPOL = 0, CPHA = 0 */
@@ -52,6 +53,8 @@ void SPI_Init(SPI_HandleTypeDef *hspi);
 uint8_t SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t data);
 uint8_t SPI_Receive(SPI_HandleTypeDef *hspi);
 uint8_t SPI_TransmitReceive(SPI_HandleTypeDef *hspi, uint8_t data);
+void SPI_SetClock(uint8_t clockDiv);
+void SPI_TransmitBlock(SPI_HandleTypeDef *hspi, const uint8_t *data, uint16_t len);
 
 #ifdef __cplusplus
 }
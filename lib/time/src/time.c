@@ -1,12 +1,15 @@
 /**
- * @file Time.c
- * @brief Timer1-based millisecond counter and delay functions
+ * @file time.c
+ * @brief Timer1-based millisecond / microsecond timebase and delay functions
  * @author Nate Hunter
  * @date 2025-07-14
- * @version v1.0.0
+ * @version v1.1.0
  */
 
-#include "Time.h"
+#include "time.h"
+
+#if defined(__AVR__)
+
 #include <avr/io.h>
 #include <avr/interrupt.h>
 
@@ -33,7 +36,7 @@ void TIM_InitMillis(void)
     TCCR1B |= (1 << WGM12) | (1 << CS11) | (1 << CS10);
 
     // 16MHz / 64 / 250 = 1000Hz (1ms)
-    OCR1A = 249;
+    OCR1A = TIM_TICKS_PER_MS - 1;
     TIMSK1 |= (1 << OCIE1A);  // Enable compare match interrupt
     sei();                    // Enable global interrupts
 }
@@ -50,17 +53,96 @@ ISR(TIMER1_COMPA_vect)
 /**
  * @brief Get current milliseconds count
  * @return Current milliseconds since initialization
- * @note Atomic read operation (disables interrupts temporarily)
+ * @note Atomic read; restores the caller's interrupt state
  */
 uint32_t TIM_GetMillis(void)
 {
     uint32_t m;
+    uint8_t sreg = SREG;
     cli();  // Disable interrupts for atomic read
     m = _timer1_millis;
-    sei();
+    SREG = sreg;
     return m;
 }
 
+/**
+ * @brief Set the millisecond counter
+ * @param ms New count
+ */
+void TIM_SetMillis(uint32_t ms)
+{
+    uint8_t sreg = SREG;
+    cli();
+    _timer1_millis = ms;
+    SREG = sreg;
+}
+
+/**
+ * @brief Get raw Timer1 ticks
+ * @return Ticks (4 us) since initialization
+ * @note If the compare match fired but its ISR has not run yet (interrupts
+ *       disabled, or the match happened inside this critical section),
+ *       TCNT1 has already wrapped while the millisecond count has not, so
+ *       the pending period is added here.
+ */
+uint32_t TIM_GetTicks(void)
+{
+    uint32_t m;
+    uint16_t t;
+    uint8_t sreg = SREG;
+    cli();
+    m = _timer1_millis;
+    t = TCNT1;
+    // A counter at TOP has matched but not cleared yet: not wrapped
+    if ((TIFR1 & (1 << OCF1A)) && t < TIM_TICKS_PER_MS - 1)
+        m++;
+    SREG = sreg;
+    return m * TIM_TICKS_PER_MS + t;
+}
+
+/**
+ * @brief Get microseconds since initialization
+ * @return Microseconds (4 us resolution)
+ */
+uint32_t TIM_GetMicros(void)
+{
+    return TIM_GetTicks() * TIM_TICK_US;
+}
+
+/**
+ * @brief Timer1 compare match B interrupt handler
+ * @note One-shot wake-up source armed by TIM_WakeAt()
+ */
+ISR(TIMER1_COMPB_vect)
+{
+    TIMSK1 &= ~(1 << OCIE1B);
+}
+
+/**
+ * @brief Arm the compare-B wake-up inside the current period
+ * @param ticks Absolute target tick
+ * @return 1 if armed
+ */
+uint8_t TIM_WakeAt(uint32_t ticks)
+{
+    uint8_t armed = 0;
+    uint8_t sreg = SREG;
+    cli();
+    uint16_t t = TCNT1;
+    // A pending compare-A wakes the CPU at once, nothing to arm
+    if (!(TIFR1 & (1 << OCF1A))) {
+        int32_t delta = (int32_t)(ticks - (_timer1_millis * TIM_TICKS_PER_MS + t));
+        if (delta > 0 && t + delta < TIM_TICKS_PER_MS) {
+            OCR1B = t + (uint16_t)delta;
+            TIFR1 = (1 << OCF1B);     // Drop a stale match
+            TIMSK1 |= (1 << OCIE1B);
+            armed = 1;
+        }
+    }
+    SREG = sreg;
+    return armed;
+}
+
 /**
  * @brief Blocking delay for specified milliseconds
  * @param ms Number of milliseconds to wait
@@ -72,4 +154,6 @@ void TIM_Delay(uint32_t ms)
     while ((TIM_GetMillis() - start) < ms) {
         // Wait until specified time has elapsed
     }
-}
\ No newline at end of file
+}
+
+#endif /* __AVR__ */
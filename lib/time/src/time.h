@@ -1,9 +1,9 @@
 /**
- * @file Time.h
- * @brief Timer1-based millisecond counter and delay functions
+ * @file time.h
+ * @brief Timer1-based millisecond / microsecond timebase and delay functions
  * @author Embedded Systems Engineer
  * @date 2023-11-15
- * @version v1.0.0
+ * @version v1.1.0
  */
 
 #ifndef TIME_H
@@ -15,6 +15,9 @@
 extern "C" {
 #endif
 
+#define TIM_TICK_US       4     ///< Timer1 tick length (us), 16 MHz / 64
+#define TIM_TICKS_PER_MS  250   ///< Timer1 ticks per compare period
+
 /**
  * @brief Initialize Timer1 millisecond counter
  * @note Must be called before using other TIM functions
@@ -27,14 +30,57 @@ void TIM_InitMillis(void);
  */
 uint32_t TIM_GetMillis(void);
 
+/**
+ * @brief Set the millisecond counter, e.g. to continue a timeline after a warm restart
+ * @param ms New count
+ * @note Ticks and microseconds follow; unsigned differences across the
+ *       call are meaningless
+ */
+void TIM_SetMillis(uint32_t ms);
+
+/**
+ * @brief Get raw Timer1 ticks (4 us) since TIM_InitMillis()
+ * @return Tick count, wraps after ~4.77 h
+ * @note Safe from ISRs and critical sections; restores the previous SREG.
+ *       With interrupts disabled the count keeps up for at most one
+ *       missed compare period (1 ms).
+ */
+uint32_t TIM_GetTicks(void);
+
+/**
+ * @brief Get microseconds since TIM_InitMillis() (4 us resolution)
+ * @return Microseconds, wraps after ~71.6 min; use unsigned differences
+ */
+uint32_t TIM_GetMicros(void);
+
+/**
+ * @brief Arm a one-shot Timer1 compare-B interrupt at an absolute tick
+ * @param ticks Target in TIM_GetTicks() units
+ * @return 1 if armed, 0 if the target is not inside the current 1 ms
+ *         period (the regular compare-A tick wakes the CPU first)
+ * @note Only purpose is to wake the CPU from sleep on time; the ISR does
+ *       nothing but disarm itself.
+ */
+uint8_t TIM_WakeAt(uint32_t ticks);
+
 /**
  * @brief Blocking delay function
  * @param ms Delay duration in milliseconds
  */
 void TIM_Delay(uint32_t ms);
 
+#if !defined(__AVR__)
+/**
+ * @brief Host build: move the simulated clock forward
+ * @param us Microseconds, rounded down to whole ticks
+ * @note The host clock also advances by one tick on every read, so a
+ *       polling loop with a timeout always ends
+ */
+void TIM_HostAdvance(uint32_t us);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
 
-#endif /* TIME_H */
\ No newline at end of file
+#endif /* TIME_H */
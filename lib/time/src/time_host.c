@@ -0,0 +1,60 @@
+/**
+ * @file time_host.c
+ * @brief Host backend of the timebase: a simulated Timer1 tick count
+ * @author Nate Hunter
+ * @date 2025-08-20
+ * @version v1.0.0
+ *
+ * Time only moves when the code looks at it (one tick per read), when it
+ * waits (TIM_Delay) or when a test calls TIM_HostAdvance(). Runs are
+ * repeatable, and every timeout loop of the drivers ends.
+ */
+
+#include "time.h"
+
+#if !defined(__AVR__)
+
+static uint32_t timHostTicks;
+
+void TIM_InitMillis(void)
+{
+  timHostTicks = 0;
+}
+
+uint32_t TIM_GetMillis(void)
+{
+  return TIM_GetTicks() / TIM_TICKS_PER_MS;
+}
+
+void TIM_SetMillis(uint32_t ms)
+{
+  timHostTicks = ms * TIM_TICKS_PER_MS;
+}
+
+uint32_t TIM_GetTicks(void)
+{
+  return timHostTicks++;
+}
+
+uint32_t TIM_GetMicros(void)
+{
+  return TIM_GetTicks() * TIM_TICK_US;
+}
+
+uint8_t TIM_WakeAt(uint32_t ticks)
+{
+  (void)ticks;
+  return 0;
+}
+
+void TIM_Delay(uint32_t ms)
+{
+  timHostTicks += ms * TIM_TICKS_PER_MS;
+}
+
+void TIM_HostAdvance(uint32_t us)
+{
+  timHostTicks += us / TIM_TICK_US;
+}
+
+#endif /* !__AVR__ */
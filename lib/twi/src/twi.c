@@ -7,211 +7,159 @@
  */
 
 #include "twi.h"
+#include "bustrace.h"
+
+#define IIC_STATUS_MASK     0xF8   ///< TWSR without the prescaler bits
+#define IIC_START           0x08   ///< START transmitted
+#define IIC_REP_START       0x10   ///< Repeated START transmitted
+#define IIC_MT_SLA_ACK      0x18   ///< SLA+W transmitted, ACK received
+#define IIC_MT_DATA_ACK     0x28   ///< Data transmitted, ACK received
+#define IIC_MR_SLA_ACK      0x40   ///< SLA+R transmitted, ACK received
+#define IIC_MR_DATA_ACK     0x50   ///< Data received, ACK returned
+#define IIC_MR_DATA_NACK    0x58   ///< Data received, NACK returned
 
 /**
- * @brief Internal function to request multiple bytes from a register
- * @param addr I2C device address
- * @param reg Register address to start reading from
- * @param num Number of bytes to request
- * @return Status code (IIC_SUCCESS, IIC_ERROR, or IIC_TIMEOUT)
+ * @brief Run one bus step and check its outcome
+ * @param twcr TWCR value that starts the step (TWINT | TWEN | ...)
+ * @param expect TWSR status of a successful step
+ * @return IIC_SUCCESS, IIC_TIMEOUT if TWINT never sets, or IIC_ERROR with
+ *         a STOP sent if the status differs (NACK, arbitration lost)
  */
-static uint8_t IIC_Request(uint8_t addr, uint8_t reg, uint8_t num);
-
-/* Public function implementations */
-
-void IIC_Init(void)
+static uint8_t IIC_Step(uint8_t twcr, uint8_t expect)
 {
-    /* Set SCL frequency to 100kHz assuming 16MHz clock */
-    TWSR = 0x00;         /* Prescaler set to 1 */
-    TWBR = 72;           /* SCL frequency = F_CPU / (16 + 2 * TWBR * Prescaler) */
-    TWCR = (1 << TWEN);  /* Enable TWI */
+    uint16_t timeout = IIC_TIMEOUT_VALUE;
+
+    HAL_WRITE(TWCR, twcr);
+    while (!(HAL_READ(TWCR) & (1 << TWINT)) && --timeout);
+    if (!timeout) return IIC_TIMEOUT;
+    if ((TWSR & IIC_STATUS_MASK) != expect) {
+        HAL_WRITE(TWCR, (1 << TWSTO) | (1 << TWEN) | (1 << TWINT));
+        return IIC_ERROR;
+    }
+    return IIC_SUCCESS;
 }
 
-uint8_t IIC_WriteByte(uint8_t addr, uint8_t reg, uint8_t data)
+/**
+ * @brief Address a device for writing and select a register
+ * @return Status code (IIC_SUCCESS, IIC_ERROR, or IIC_TIMEOUT)
+ */
+static uint8_t IIC_Select(uint8_t addr, uint8_t reg)
 {
-    uint16_t timeout = IIC_TIMEOUT_VALUE;
-    
+    uint8_t st;
+
     /* Start condition */
-    TWCR = (1 << TWSTA) | (1 << TWEN) | (1 << TWINT);
-    while (!(TWCR & (1 << TWINT)) && --timeout);
-    if (!timeout) return IIC_TIMEOUT;
+    if ((st = IIC_Step((1 << TWSTA) | (1 << TWEN) | (1 << TWINT), IIC_START))) return st;
 
     /* Device address with write bit */
-    TWDR = (addr << 1);
-    TWCR = (1 << TWEN) | (1 << TWINT);
-    timeout = IIC_TIMEOUT_VALUE;
-    while (!(TWCR & (1 << TWINT)) && --timeout);
-    if (!timeout) return IIC_TIMEOUT;
+    HAL_WRITE(TWDR, (addr << 1));
+    if ((st = IIC_Step((1 << TWEN) | (1 << TWINT), IIC_MT_SLA_ACK))) return st;
 
     /* Register address */
-    TWDR = reg;
-    TWCR = (1 << TWEN) | (1 << TWINT);
-    timeout = IIC_TIMEOUT_VALUE;
-    while (!(TWCR & (1 << TWINT)) && --timeout);
-    if (!timeout) return IIC_TIMEOUT;
+    HAL_WRITE(TWDR, reg);
+    return IIC_Step((1 << TWEN) | (1 << TWINT), IIC_MT_DATA_ACK);
+}
 
-    /* Data to write */
-    TWDR = data;
-    TWCR = (1 << TWEN) | (1 << TWINT);
-    timeout = IIC_TIMEOUT_VALUE;
-    while (!(TWCR & (1 << TWINT)) && --timeout);
-    if (!timeout) return IIC_TIMEOUT;
+/**
+ * @brief Internal function to request multiple bytes from a register
+ * @param addr I2C device address
+ * @param reg Register address to start reading from
+ * @return Status code (IIC_SUCCESS, IIC_ERROR, or IIC_TIMEOUT)
+ */
+static uint8_t IIC_Request(uint8_t addr, uint8_t reg)
+{
+    uint8_t st;
 
-    /* Stop condition */
-    TWCR = (1 << TWSTO) | (1 << TWEN) | (1 << TWINT);
-    return IIC_SUCCESS;
+    if ((st = IIC_Select(addr, reg))) return st;
+
+    /* Repeated start */
+    if ((st = IIC_Step((1 << TWSTA) | (1 << TWEN) | (1 << TWINT), IIC_REP_START))) return st;
+
+    /* Device address with read bit */
+    HAL_WRITE(TWDR, (addr << 1) | 1);
+    return IIC_Step((1 << TWEN) | (1 << TWINT), IIC_MR_SLA_ACK);
 }
 
-uint8_t IIC_WriteBytes(uint8_t addr, uint8_t reg, const uint8_t* data, uint8_t num)
+/* Transfer implementations; the public wrappers add bus tracing */
+
+void IIC_Init(void)
 {
-    uint16_t timeout = IIC_TIMEOUT_VALUE;
-    
-    /* Start condition */
-    TWCR = (1 << TWSTA) | (1 << TWEN) | (1 << TWINT);
-    while (!(TWCR & (1 << TWINT)) && --timeout);
-    if (!timeout) return IIC_TIMEOUT;
+    /* Set SCL frequency to 100kHz assuming 16MHz clock */
+    TWSR = 0x00;         /* Prescaler set to 1 */
+    TWBR = 72;           /* SCL frequency = F_CPU / (16 + 2 * TWBR * Prescaler) */
+    HAL_WRITE(TWCR, (1 << TWEN));  /* Enable TWI */
+}
 
-    /* Device address with write bit */
-    TWDR = (addr << 1);
-    TWCR = (1 << TWEN) | (1 << TWINT);
-    timeout = IIC_TIMEOUT_VALUE;
-    while (!(TWCR & (1 << TWINT)) && --timeout);
-    if (!timeout) return IIC_TIMEOUT;
+static inline uint8_t IIC_WriteBytesRaw(uint8_t addr, uint8_t reg, const uint8_t* data, uint8_t num)
+{
+    uint8_t st;
 
-    /* Starting register address */
-    TWDR = reg;
-    TWCR = (1 << TWEN) | (1 << TWINT);
-    timeout = IIC_TIMEOUT_VALUE;
-    while (!(TWCR & (1 << TWINT)) && --timeout);
-    if (!timeout) return IIC_TIMEOUT;
+    if ((st = IIC_Select(addr, reg))) return st;
 
     for (uint8_t i = 0; i < num; i++) {
         /* Data byte to write */
-        TWDR = data[i];
-        TWCR = (1 << TWEN) | (1 << TWINT);
-        timeout = IIC_TIMEOUT_VALUE;
-        while (!(TWCR & (1 << TWINT)) && --timeout);
-        if (!timeout) return IIC_TIMEOUT;
+        HAL_WRITE(TWDR, data[i]);
+        if ((st = IIC_Step((1 << TWEN) | (1 << TWINT), IIC_MT_DATA_ACK))) return st;
     }
 
     /* Stop condition */
-    TWCR = (1 << TWSTO) | (1 << TWEN) | (1 << TWINT);
+    HAL_WRITE(TWCR, (1 << TWSTO) | (1 << TWEN) | (1 << TWINT));
     return IIC_SUCCESS;
 }
 
-uint8_t IIC_ReadByte(uint8_t addr, uint8_t reg, uint8_t* data)
+static inline uint8_t IIC_ReadBytesRaw(uint8_t addr, uint8_t reg, uint8_t* buffer, uint8_t num)
 {
-    uint16_t timeout = IIC_TIMEOUT_VALUE;
-    
-    /* Start condition */
-    TWCR = (1 << TWSTA) | (1 << TWEN) | (1 << TWINT);
-    while (!(TWCR & (1 << TWINT)) && --timeout);
-    if (!timeout) return IIC_TIMEOUT;
-
-    /* Device address with write bit */
-    TWDR = (addr << 1);
-    TWCR = (1 << TWEN) | (1 << TWINT);
-    timeout = IIC_TIMEOUT_VALUE;
-    while (!(TWCR & (1 << TWINT)) && --timeout);
-    if (!timeout) return IIC_TIMEOUT;
+    uint8_t st;
 
-    /* Register address */
-    TWDR = reg;
-    TWCR = (1 << TWEN) | (1 << TWINT);
-    timeout = IIC_TIMEOUT_VALUE;
-    while (!(TWCR & (1 << TWINT)) && --timeout);
-    if (!timeout) return IIC_TIMEOUT;
-
-    /* Repeated start */
-    TWCR = (1 << TWSTA) | (1 << TWEN) | (1 << TWINT);
-    timeout = IIC_TIMEOUT_VALUE;
-    while (!(TWCR & (1 << TWINT)) && --timeout);
-    if (!timeout) return IIC_TIMEOUT;
+    if ((st = IIC_Request(addr, reg))) return st;
 
-    /* Device address with read bit */
-    TWDR = (addr << 1) | 1;
-    TWCR = (1 << TWEN) | (1 << TWINT);
-    timeout = IIC_TIMEOUT_VALUE;
-    while (!(TWCR & (1 << TWINT)) && --timeout);
-    if (!timeout) return IIC_TIMEOUT;
-
-    /* Read without ACK */
-    TWCR = (1 << TWEN) | (1 << TWINT);
-    timeout = IIC_TIMEOUT_VALUE;
-    while (!(TWCR & (1 << TWINT)) && --timeout);
-    if (!timeout) return IIC_TIMEOUT;
-    
-    *data = TWDR;
-
-    /* Stop condition */
-    TWCR = (1 << TWSTO) | (1 << TWEN) | (1 << TWINT);
-    return IIC_SUCCESS;
-}
-
-uint8_t IIC_ReadBytes(uint8_t addr, uint8_t reg, uint8_t* buffer, uint8_t num)
-{
-    uint16_t timeout;
-    
-    if (IIC_Request(addr, reg, num)) return IIC_TIMEOUT;
-    
     for (uint8_t i = 0; i < num; i++) {
         if (i < num - 1) {
             /* Read with ACK */
-            TWCR = (1 << TWEN) | (1 << TWINT) | (1 << TWEA);
+            st = IIC_Step((1 << TWEN) | (1 << TWINT) | (1 << TWEA), IIC_MR_DATA_ACK);
         } else {
             /* Read without ACK (last byte) */
-            TWCR = (1 << TWEN) | (1 << TWINT);
+            st = IIC_Step((1 << TWEN) | (1 << TWINT), IIC_MR_DATA_NACK);
         }
-        
-        timeout = IIC_TIMEOUT_VALUE;
-        while (!(TWCR & (1 << TWINT)) && --timeout);
-        if (!timeout) return IIC_TIMEOUT;
-        
-        buffer[i] = TWDR;
+        if (st) return st;
+
+        buffer[i] = HAL_READ(TWDR);
     }
-  
+
     /* Stop condition */
-    TWCR = (1 << TWSTO) | (1 << TWEN) | (1 << TWINT);
+    HAL_WRITE(TWCR, (1 << TWSTO) | (1 << TWEN) | (1 << TWINT));
     return IIC_SUCCESS;
 }
 
-/* Private function implementations */
+/* Public function implementations */
 
-static uint8_t IIC_Request(uint8_t addr, uint8_t reg, uint8_t num)
+uint8_t IIC_WriteByte(uint8_t addr, uint8_t reg, uint8_t data)
 {
-    uint16_t timeout = IIC_TIMEOUT_VALUE;
-    
-    /* Start condition */
-    TWCR = (1 << TWSTA) | (1 << TWEN) | (1 << TWINT);
-    while (!(TWCR & (1 << TWINT)) && --timeout);
-    if (!timeout) return IIC_TIMEOUT;
-
-    /* Device address with write bit */
-    TWDR = (addr << 1);
-    TWCR = (1 << TWEN) | (1 << TWINT);
-    timeout = IIC_TIMEOUT_VALUE;
-    while (!(TWCR & (1 << TWINT)) && --timeout);
-    if (!timeout) return IIC_TIMEOUT;
-
-    /* Register address */
-    TWDR = reg;
-    TWCR = (1 << TWEN) | (1 << TWINT);
-    timeout = IIC_TIMEOUT_VALUE;
-    while (!(TWCR & (1 << TWINT)) && --timeout);
-    if (!timeout) return IIC_TIMEOUT;
+    BUSTRACE_BEGIN();
+    uint8_t st = IIC_WriteBytesRaw(addr, reg, &data, 1);
+    BUSTRACE_END(BUSTRACE_TWI | addr, reg, 1, st);
+    return st;
+}
 
-    /* Repeated start */
-    TWCR = (1 << TWSTA) | (1 << TWEN) | (1 << TWINT);
-    timeout = IIC_TIMEOUT_VALUE;
-    while (!(TWCR & (1 << TWINT)) && --timeout);
-    if (!timeout) return IIC_TIMEOUT;
+uint8_t IIC_WriteBytes(uint8_t addr, uint8_t reg, const uint8_t* data, uint8_t num)
+{
+    BUSTRACE_BEGIN();
+    uint8_t st = IIC_WriteBytesRaw(addr, reg, data, num);
+    BUSTRACE_END(BUSTRACE_TWI | addr, reg, num, st);
+    return st;
+}
 
-    /* Device address with read bit */
-    TWDR = (addr << 1) | 1;
-    TWCR = (1 << TWEN) | (1 << TWINT);
-    timeout = IIC_TIMEOUT_VALUE;
-    while (!(TWCR & (1 << TWINT)) && --timeout);
-    if (!timeout) return IIC_TIMEOUT;
+uint8_t IIC_ReadByte(uint8_t addr, uint8_t reg, uint8_t* data)
+{
+    BUSTRACE_BEGIN();
+    uint8_t st = IIC_ReadBytesRaw(addr, reg, data, 1);
+    BUSTRACE_END(BUSTRACE_TWI | addr, reg, 1, st);
+    return st;
+}
 
-    return IIC_SUCCESS;
-}
\ No newline at end of file
+uint8_t IIC_ReadBytes(uint8_t addr, uint8_t reg, uint8_t* buffer, uint8_t num)
+{
+    BUSTRACE_BEGIN();
+    uint8_t st = IIC_ReadBytesRaw(addr, reg, buffer, num);
+    BUSTRACE_END(BUSTRACE_TWI | addr, reg, num, st);
+    return st;
+}
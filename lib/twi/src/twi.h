@@ -9,8 +9,7 @@
 #ifndef IICFUNCS_H
 #define IICFUNCS_H
 
-#include <avr/io.h>
-#include <util/twi.h>
+#include "hal.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -18,7 +17,7 @@ extern "C" {
 
 /* Status codes */
 #define IIC_SUCCESS     0   ///< Operation completed successfully
-#define IIC_ERROR      1   ///< Operation failed (general error)
+#define IIC_ERROR      1   ///< Operation failed (NACK, arbitration lost, bus error)
 #define IIC_TIMEOUT    2   ///< Operation timed out
 
 /* Configuration */
@@ -4,42 +4,167 @@
  */
 
 #include "uart.h"
+
+#if defined(__AVR__)
+
 #include <avr/io.h>
+#include <avr/interrupt.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
+
+#define UART_TX_MASK (UART_TX_BUFFER_SIZE - 1)
+
+#if (UART_TX_BUFFER_SIZE & UART_TX_MASK) || UART_TX_BUFFER_SIZE > 256
+#error "UART_TX_BUFFER_SIZE must be a power of two <= 256"
+#endif
+
+/* Private variables */
+static uint8_t txBuffer[UART_TX_BUFFER_SIZE];  ///< Transmit ring storage
+static volatile uint8_t txHead;                ///< Next write index (main context)
+static volatile uint8_t txTail;                ///< Next read index (ISR)
+static uint16_t txOverflows;                   ///< Bytes that found the ring full
+static uint8_t txPolicy = UART_TX_OVERFLOW_POLICY;
+static int16_t baudError;                      ///< Selected baud error (0.01 %)
+
+/**
+ * @brief Clear TXC0 (write one) without touching U2X0/MPCM0.
+ */
+static inline void UART_ClearTxComplete(void) {
+  UCSR0A = (UCSR0A & ((1 << U2X0) | (1 << MPCM0))) | (1 << TXC0);
+}
+
+/**
+ * @brief Baud rate error of a divider setting in 0.01 % units.
+ */
+static int16_t UART_BaudError(uint32_t baud, uint16_t ubrr, uint8_t div) {
+  uint32_t actual = F_CPU / ((uint32_t)div * (ubrr + 1));
+  return (int16_t)(((int32_t)actual - (int32_t)baud) * 100L / (int32_t)(baud / 100));
+}
 
 /**
  * @brief Initialize UART with specified baud rate.
  * 
- * @param uart Pointer to UART structure.
+ * Both normal (F_CPU/16) and double-speed (U2X, F_CPU/8) dividers are
+ * evaluated with rounding; the one with the smaller error is used.
+ * 
+ * @param baud Baud rate (e.g. 115200, 250000, 500000, 1000000).
+ * @return UART_OK, or UART_BAUD_ERROR if the best error exceeds
+ *         UART_MAX_BAUD_ERROR (the UART is still configured).
  */
-void UART_Init(uint32_t baud) {
-  uint16_t ubrr = (F_CPU / 16 / baud);
+uint8_t UART_Init(uint32_t baud) {
+  uint16_t ubrr16 = (uint16_t)((F_CPU + 8UL * baud) / (16UL * baud) - 1);
+  uint16_t ubrr8 = (uint16_t)((F_CPU + 4UL * baud) / (8UL * baud) - 1);
+  int16_t err16 = UART_BaudError(baud, ubrr16, 16);
+  int16_t err8 = UART_BaudError(baud, ubrr8, 8);
+  uint8_t u2x = abs(err8) < abs(err16);
+  uint16_t ubrr = u2x ? ubrr8 : ubrr16;
+
+  baudError = u2x ? err8 : err16;
+  txHead = txTail = 0;
+  txOverflows = 0;
 
-  /* Set baud rate */
+  /* Set baud rate and speed mode */
   UBRR0H = (uint8_t)(ubrr >> 8);
   UBRR0L = (uint8_t)ubrr;
+  UCSR0A = u2x ? (1 << U2X0) : 0;
 
   /* Enable transmitter and receiver */
   UCSR0B = (1 << RXEN0) | (1 << TXEN0);
 
   /* Set frame format: 8 data bits, 1 stop bit */
   UCSR0C = (1 << UCSZ01) | (1 << UCSZ00);
+
+  return abs(baudError) > UART_MAX_BAUD_ERROR ? UART_BAUD_ERROR : UART_OK;
 }
 
 /**
- * @brief Transmit a single byte via UART.
+ * @brief Get the baud rate error selected by UART_Init().
+ * 
+ * @return Signed error in 0.01 % units (e.g. 212 = +2.12 %).
+ */
+int16_t UART_GetBaudError(void) {
+  return baudError;
+}
+
+/**
+ * @brief Data register empty interrupt: feed the next queued byte.
+ */
+ISR(USART_UDRE_vect) {
+  uint8_t tail = txTail;
+
+  if (tail == txHead) {
+    /* Ring drained, stop interrupts until new data is queued */
+    UCSR0B &= ~(1 << UDRIE0);
+    return;
+  }
+
+  UDR0 = txBuffer[tail];
+  UART_ClearTxComplete();
+  txTail = (tail + 1) & UART_TX_MASK;
+}
+
+/**
+ * @brief Queue a single byte for transmission.
+ *
+ * Returns as soon as the byte is copied into the ring. When the ring is
+ * full the configured overflow policy decides what happens.
  * 
- * @param uart Pointer to UART structure.
  * @param data Byte to send.
  */
 void UART_Transmit(uint8_t data) {
-  /* Wait for empty transmit buffer */
+  uint8_t head = txHead;
+  uint8_t next = (head + 1) & UART_TX_MASK;
+
+  if (next == txTail) {
+    if (txOverflows != 0xFFFF)
+      txOverflows++;
+
+    switch (txPolicy) {
+      case UART_TX_DROP_NEWEST:
+        return;
+
+      case UART_TX_DROP_OLDEST: {
+        uint8_t sreg = SREG;
+        cli();
+        if (next == txTail)
+          txTail = (txTail + 1) & UART_TX_MASK;
+        SREG = sreg;
+        break;
+      }
+
+      default: /* UART_TX_BLOCK */
+        while (next == txTail) {
+          /* With interrupts off the ISR cannot drain, so drain by polling */
+          if (!(SREG & (1 << SREG_I)) && (UCSR0A & (1 << UDRE0))) {
+            UDR0 = txBuffer[txTail];
+            UART_ClearTxComplete();
+            txTail = (txTail + 1) & UART_TX_MASK;
+          }
+        }
+        break;
+    }
+  }
+
+  txBuffer[head] = data;
+  txHead = next;
+  UCSR0B |= (1 << UDRIE0);
+}
+
+/**
+ * @brief Send a single byte straight through the data register.
+ *
+ * Waits for the register instead of queueing, which keeps the per-byte
+ * cost low enough for bulk transfers at 1-2 Mbaud. Call UART_Flush()
+ * first; do not mix with UART_Transmit() until the last byte is out.
+ * 
+ * @param data Byte to send.
+ */
+void UART_TransmitDirect(uint8_t data) {
   while (!(UCSR0A & (1 << UDRE0)))
     ;
-
-  /* Put data into buffer, send the data */
   UDR0 = data;
+  UART_ClearTxComplete();
 }
 
 /**
@@ -57,6 +182,15 @@ uint8_t UART_Receive() {
   return UDR0;
 }
 
+/**
+ * @brief Check whether a received byte is waiting.
+ * 
+ * @return 1 if UART_Receive() will not block, 0 otherwise.
+ */
+uint8_t UART_Available(void) {
+  return (UCSR0A & (1 << RXC0)) ? 1 : 0;
+}
+
 /**
  * @brief Transmit a string via UART.
  * 
@@ -70,6 +204,59 @@ void UART_TransmitString(const char *str) {
   }
 }
 
+/**
+ * @brief Select what UART_Transmit() does when the ring is full.
+ * 
+ * @param policy UART_TX_DROP_NEWEST, UART_TX_DROP_OLDEST or UART_TX_BLOCK.
+ */
+void UART_SetOverflowPolicy(uint8_t policy) {
+  txPolicy = policy;
+}
+
+/**
+ * @brief Get the number of bytes that found the transmit ring full.
+ * 
+ * Counts dropped bytes for the drop policies and blocking waits for
+ * UART_TX_BLOCK.
+ * 
+ * @return Overflow count since UART_Init() (saturates at 65535).
+ */
+uint16_t UART_GetOverflowCount(void) {
+  return txOverflows;
+}
+
+/**
+ * @brief Get the number of bytes still queued for transmission.
+ * 
+ * @return Queued byte count.
+ */
+uint8_t UART_TxPending(void) {
+  return (txHead - txTail) & UART_TX_MASK;
+}
+
+/**
+ * @brief Wait until every queued byte has left the shift register.
+ */
+void UART_Flush(void) {
+  /* The ISR disables UDRIE0 once the last byte has moved to the shifter */
+  while (txHead != txTail || (UCSR0B & (1 << UDRIE0))) {
+    /* With interrupts off the ISR cannot drain, so drain by polling */
+    if (!(SREG & (1 << SREG_I)) && (UCSR0A & (1 << UDRE0))) {
+      if (txHead == txTail) {
+        UCSR0B &= ~(1 << UDRIE0);
+      } else {
+        UDR0 = txBuffer[txTail];
+        UART_ClearTxComplete();
+        txTail = (txTail + 1) & UART_TX_MASK;
+      }
+    }
+  }
+  /* TXC0 is cleared on every write, so it now marks the last stop bit */
+  if (UCSR0B & (1 << TXEN0))
+    while (!(UCSR0A & (1 << TXC0)))
+      ;
+}
+
 
 /**
  * @brief Custom putchar function for printf redirection.
@@ -91,3 +278,5 @@ void UART_EnablePrintf(void) {
   static FILE uart_stdout = FDEV_SETUP_STREAM(UART_PutChar, NULL, _FDEV_SETUP_WRITE);
   stdout = &uart_stdout;
 }
+
+#endif /* __AVR__ */
@@ -8,15 +8,51 @@
 
 #include <stdint.h>
 
+/* Status codes */
+#define UART_OK             0               ///< Baud rate within tolerance
+#define UART_BAUD_ERROR     1               ///< Baud rate error above UART_MAX_BAUD_ERROR
+
+/* Baud rate tolerance */
+#ifndef UART_MAX_BAUD_ERROR
+#define UART_MAX_BAUD_ERROR 250             ///< Max |error| in 0.01 % (8N1 tolerates ~2.5 % total)
+#endif
+
+/* Transmit ring configuration */
+#ifndef UART_TX_BUFFER_SIZE
+#define UART_TX_BUFFER_SIZE 128             ///< Transmit ring size (power of two, <= 256)
+#endif
+
+/* Overflow policies for a full transmit ring */
+#define UART_TX_DROP_NEWEST 0               ///< Discard the byte being written
+#define UART_TX_DROP_OLDEST 1               ///< Discard the oldest queued byte
+#define UART_TX_BLOCK       2               ///< Wait for space (nothing is lost)
+
+#ifndef UART_TX_OVERFLOW_POLICY
+#define UART_TX_OVERFLOW_POLICY UART_TX_BLOCK ///< Policy after UART_Init()
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-  void UART_Init(uint32_t baud);
+  uint8_t UART_Init(uint32_t baud);
+  int16_t UART_GetBaudError(void);
   void UART_Transmit(uint8_t data);
+  void UART_TransmitDirect(uint8_t data);
   uint8_t UART_Receive();
+  uint8_t UART_Available(void);
   void UART_TransmitString(const char *str);
   void UART_EnablePrintf(void);
+  void UART_SetOverflowPolicy(uint8_t policy);
+  uint16_t UART_GetOverflowCount(void);
+  uint8_t UART_TxPending(void);
+  void UART_Flush(void);
+
+#if !defined(__AVR__)
+  /* Host build: transmitted bytes are captured, received bytes injected */
+  uint16_t UART_HostTake(uint8_t *buf, uint16_t size);
+  void UART_HostInject(const uint8_t *data, uint8_t len);
+#endif
 
 #ifdef __cplusplus
 }
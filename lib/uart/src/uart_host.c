@@ -0,0 +1,108 @@
+/**
+ * @file uart_host.c
+ * @brief Host backend of the UART: transmit capture and receive injection
+ * @author Nate Hunter
+ * @date 2025-08-20
+ * @version v1.0.0
+ *
+ * Every byte is sent at once into a capture buffer that a test drains with
+ * UART_HostTake(); received bytes come from UART_HostInject(). A full
+ * capture buffer drops the byte and counts it as an overflow.
+ */
+
+#include "uart.h"
+
+#if !defined(__AVR__)
+
+#ifndef UART_HOST_CAPTURE
+#define UART_HOST_CAPTURE 1024    ///< Capture buffer size (bytes)
+#endif
+#define UART_HOST_RX      64      ///< Receive buffer size (bytes)
+
+static uint8_t hostTx[UART_HOST_CAPTURE];
+static uint16_t hostTxLen;
+static uint8_t hostRx[UART_HOST_RX];
+static uint8_t hostRxHead;
+static uint8_t hostRxTail;
+static uint16_t hostOverflows;
+
+uint8_t UART_Init(uint32_t baud) {
+  (void)baud;
+  hostTxLen = 0;
+  hostRxHead = hostRxTail = 0;
+  hostOverflows = 0;
+  return UART_OK;
+}
+
+int16_t UART_GetBaudError(void) {
+  return 0;
+}
+
+void UART_Transmit(uint8_t data) {
+  if (hostTxLen < UART_HOST_CAPTURE)
+    hostTx[hostTxLen++] = data;
+  else
+    hostOverflows++;
+}
+
+void UART_TransmitDirect(uint8_t data) {
+  UART_Transmit(data);
+}
+
+uint8_t UART_Receive() {
+  if (hostRxTail == hostRxHead)
+    return 0;
+  uint8_t data = hostRx[hostRxTail];
+  hostRxTail = (uint8_t)((hostRxTail + 1) % UART_HOST_RX);
+  return data;
+}
+
+uint8_t UART_Available(void) {
+  return (uint8_t)((hostRxHead + UART_HOST_RX - hostRxTail) % UART_HOST_RX);
+}
+
+void UART_TransmitString(const char *str) {
+  while (*str)
+    UART_Transmit((uint8_t)*str++);
+}
+
+void UART_EnablePrintf(void) {
+  // printf keeps going to the host's stdout
+}
+
+void UART_SetOverflowPolicy(uint8_t policy) {
+  (void)policy;
+}
+
+uint16_t UART_GetOverflowCount(void) {
+  return hostOverflows;
+}
+
+uint8_t UART_TxPending(void) {
+  return 0;
+}
+
+void UART_Flush(void) {
+}
+
+uint16_t UART_HostTake(uint8_t *buf, uint16_t size) {
+  uint16_t n = hostTxLen < size ? hostTxLen : size;
+  for (uint16_t i = 0; i < n; i++)
+    buf[i] = hostTx[i];
+  for (uint16_t i = n; i < hostTxLen; i++)
+    hostTx[i - n] = hostTx[i];
+  hostTxLen -= n;
+  return n;
+}
+
+void UART_HostInject(const uint8_t *data, uint8_t len) {
+  while (len--) {
+    uint8_t next = (uint8_t)((hostRxHead + 1) % UART_HOST_RX);
+    if (next == hostRxTail)
+      return;
+    hostRx[hostRxHead] = *data++;
+    hostRxHead = next;
+  }
+}
+
+#endif /* !__AVR__ */
@@ -10,12 +10,38 @@
 #include "bmp280.h"     ///< BMP280 barometric pressure sensor driver
 #include "lsm6ds3.h"    ///< LSM6DS3 IMU sensor driver
 #include "rgb_led.h"    ///< RGB LED control
+#include "led.h"        ///< LED pattern engine
 #include "uart.h"       ///< UART communication
 #include "twi.h"        ///< I2C (TWI) communication
 #include "time.h"       ///< Timing utilities
 #include "Arduino.h"    ///< Arduino core functions
 #include "spi_driver.h"   ///< Custom SPI driver
 #include "lora.h"         ///< LoRa radio driver
+#include "flight.h"       ///< Flight-phase state machine
+#include "pretrig.h"      ///< Pre-trigger ring buffer
+#include "calib.h"        ///< Persisted sensor calibration
+#include "kalman.h"       ///< Vertical-state filter
+#include "fft.h"          ///< Vibration spectrum
+#include "frame.h"        ///< Binary framed output
+#include "fmt.h"          ///< printf-free text formatting
+#include "sched.h"        ///< Cooperative task scheduler
+#include "prof.h"         ///< Hot-path profiling (PROF_ENABLE)
+#include "bustrace.h"     ///< TWI / SPI transaction trace (BUSTRACE_ENABLE)
+#include "bite.h"         ///< Power-on self-test
+#include "boot.h"         ///< Overlapped boot pipeline
+#include "restart.h"      ///< Warm-restart checkpoint
+#include "sd.h"           ///< microSD card driver
+#include "fat32.h"        ///< Preallocated log file
+#include "logq.h"         ///< Log queue in front of the card
+#include "logblk.h"       ///< Self-describing log blocks
+#include "rice.h"         ///< Sample compression
+#include "offload.h"      ///< Bulk log offload over the UART
+#include "ina226.h"       ///< Battery voltage / current monitor
+#include "power.h"        ///< Charge estimate and power-saving level
+#include "health.h"       ///< Per-sensor health and re-probing
+#include <avr/pgmspace.h>
+#include <avr/wdt.h>
+#include <stddef.h>
 
 // BMP280 sensor handle structure
 BMP280_HandleTypeDef bmp;
@@ -23,9 +49,52 @@ BMP280_HandleTypeDef bmp;
 // LSM6DS3 sensor handle structure
 LSM6DS3_Handle lsm;
 
+/**
+ * @brief IMU events polled every sample: wake-up (launch) above
+ *        FDR_WAKE_THS x full scale / 64 (8 x 16 g / 64 = 2 g), free-fall
+ *        (burnout) below FDR_FF_THS for FDR_FF_DUR ODR periods.
+ */
+#ifndef FDR_WAKE_THS
+#define FDR_WAKE_THS 8
+#endif
+#ifndef FDR_FF_THS
+#define FDR_FF_THS   LSM6DS3_FF_312MG
+#endif
+#ifndef FDR_FF_DUR
+#define FDR_FF_DUR   6
+#endif
+
 // LoRa handle
 static LoRa_Handle_t lora;
 
+// microSD log card, sharing the SPI bus with the radio, and the encoded
+// frames waiting for it
+static SD_Handle sd;
+static LOGQ_Handle logq;
+static LOGBLK_Handle logblk;
+
+// Devices found by the power-on self-test
+static uint8_t bmpOk, lsmOk, loraOk, sdOk, inaOk;
+
+// The altitude zero is a live pad reading, not the stored fallback
+static uint8_t baroZeroLive;
+
+/**
+ * @brief Sensors with a runtime health state (HEALTH record order)
+ */
+enum DeviceId {
+  DEV_BARO = 0,        ///< BMP280
+  DEV_IMU,             ///< LSM6DS3
+  DEV_POWER,           ///< INA226
+  DEV_COUNT
+};
+
+static HEALTH_Device health[DEV_COUNT];
+static const char devNameBaro[] PROGMEM = "baro";
+static const char devNameImu[] PROGMEM = "imu";
+static const char devNamePower[] PROGMEM = "power";
+static const char *const devNames[DEV_COUNT] PROGMEM = { devNameBaro, devNameImu, devNamePower };
+
 // LoRa config
 static LoRa_Config_t loraCfg = {
     433000000UL, // frequency
@@ -42,6 +111,261 @@ static LoRa_Config_t loraCfg = {
     0x01         // txPower
 };
 
+/**
+ * @brief Battery monitor: INA226 address and shunt, battery capacity and
+ *        the filtered voltages that select the power-saving levels. The
+ *        ALERT function latches a bus voltage below FDR_POWER_CRITICAL_MV
+ *        between two reads, so a dip under load is not missed.
+ */
+#ifndef FDR_INA226_ADDR
+#define FDR_INA226_ADDR       0x40
+#endif
+#ifndef FDR_SHUNT_MOHM
+#define FDR_SHUNT_MOHM        10     ///< Shunt resistor (mOhm)
+#endif
+#ifndef FDR_CURRENT_LSB_UA
+#define FDR_CURRENT_LSB_UA    100    ///< Current resolution, 3.2 A full scale (uA/LSB)
+#endif
+#ifndef FDR_BATTERY_MAH
+#define FDR_BATTERY_MAH       1000
+#endif
+#ifndef FDR_POWER_SAVE_MV
+#define FDR_POWER_SAVE_MV     3600
+#endif
+#ifndef FDR_POWER_CRITICAL_MV
+#define FDR_POWER_CRITICAL_MV 3450
+#endif
+#ifndef FDR_POWER_PERIOD_MS
+#define FDR_POWER_PERIOD_MS   1000   ///< Battery read, governor and POWER record interval
+#endif
+
+static INA226_Handle ina;
+static POWER_Handle power;
+static uint8_t powerStarted;   ///< Charge estimate running
+
+// LED brightness per power-saving level
+static const uint8_t powerBrightness[POWER_LEVEL_COUNT] PROGMEM = { 255, 64, 16 };
+
+// Flight-phase state machine and its active acquisition profile
+static FLIGHT_Handle flight;
+static FLIGHT_Profile profile;
+
+// Fused altitude / vertical velocity estimate
+static KF_Handle kf;
+
+/**
+ * @brief RAM shared between boot and flight. The card work at boot (POST
+ *        mount, log file allocation) needs a 512-byte block buffer; the
+ *        pre-trigger ring and the FFT window are idle until sampling starts
+ *        (PRETRIG_Init and the first FFT_Reset follow the boot), so the
+ *        buffer lives on top of them rather than on the stack.
+ */
+static union {
+  struct {
+    PRETRIG_Handle pretrig;
+    FFT_Handle fft;
+  } live;
+  struct {
+    uint8_t buf[SD_BLOCK_SIZE];
+    FAT32_Volume vol;
+    FAT32_Create op;
+    FAT32_File file;
+  } boot;
+} shared;
+
+// Vibration spectrum of the Z accelerometer, one window every FFT_PERIOD_MS
+static FFT_Handle &fft = shared.live.fft;
+static FFT_Summary vib;
+static uint8_t fftActive;   ///< IMU FIFO is collecting a window
+
+#ifndef FFT_PERIOD_MS
+#define FFT_PERIOD_MS 1000  ///< Interval between vibration windows (ms)
+#endif
+#define FFT_DRAIN_CHUNK 8   ///< FIFO samples popped per loop pass
+
+/**
+ * @brief Compact LoRa telemetry packet (18 bytes)
+ */
+typedef struct {
+  uint32_t pressure;   ///< Pressure (Pa)
+  int16_t altitude;    ///< Filtered altitude (m)
+  int16_t velocity;    ///< Filtered vertical velocity (dm/s)
+  uint8_t phase;       ///< FLIGHT_Phase
+  uint8_t vibPeak;     ///< Strongest vibration bin of the last window
+  uint8_t vib[FFT_BANDS]; ///< Vibration band powers of the last window
+} TelemetryPacket;
+
+static TelemetryPacket telemetry;
+
+// Sensor calibration loaded from EEPROM
+static CALIB_Data calib;
+
+// Records captured on the pad, flushed ahead of the live stream at launch
+static PRETRIG_Handle &pretrig = shared.live.pretrig;
+
+/**
+ * @brief Console baud rate and initial output format.
+ *        Binary framing ('b'/'t' console commands switch at runtime)
+ *        is meant for rates such as 500000 or 1000000.
+ */
+#ifndef FDR_UART_BAUD
+#define FDR_UART_BAUD 115200
+#endif
+#ifndef FDR_OUTPUT_BINARY
+#define FDR_OUTPUT_BINARY 0
+#endif
+
+static uint8_t outputBinary = FDR_OUTPUT_BINARY;
+
+/**
+ * @brief Minimum time between automatic bus-trace dumps (ms), so an
+ *        error storm is sampled instead of flooding the log.
+ */
+#ifndef BUSTRACE_REARM_MS
+#define BUSTRACE_REARM_MS 1000
+#endif
+
+/**
+ * @brief Watchdog period. Must cover the longest task (LoRa TX at SF9,
+ *        ~200 ms) and the console calibration commands (~600 ms).
+ */
+#ifndef FDR_WDT_TIMEOUT
+#define FDR_WDT_TIMEOUT WDTO_1S
+#endif
+
+/**
+ * @brief Size of the log file preallocated on the card at every cold boot
+ *        (MB), and the number of blocks written by the boot write benchmark.
+ */
+#ifndef FDR_LOG_MB
+#define FDR_LOG_MB 64
+#endif
+#ifndef FDR_SD_BENCH_BLOCKS
+#define FDR_SD_BENCH_BLOCKS 32
+#endif
+
+/**
+ * @brief Log position in the EEPROM checkpoint: refreshed every
+ *        FDR_CHECKPOINT_BLOCKS blocks besides every phase change. A resume
+ *        skips the blocks written since by reading their headers, at most
+ *        FDR_RESUME_SCAN_BLOCKS (~1 ms each), so nothing is overwritten.
+ */
+#ifndef FDR_CHECKPOINT_BLOCKS
+#define FDR_CHECKPOINT_BLOCKS 64
+#endif
+#ifndef FDR_RESUME_SCAN_BLOCKS
+#define FDR_RESUME_SCAN_BLOCKS (2 * FDR_CHECKPOINT_BLOCKS)
+#endif
+
+/**
+ * @brief Log block schema: version of the frame types and record layouts
+ *        below. Bump on any change; tools/fdr_recover.py refuses unknown ones.
+ */
+#define FDR_LOG_SCHEMA 4
+
+/**
+ * @brief Set to 0 to store every live sample as a full SAMPLE frame.
+ *        Otherwise a SAMPLE frame is a key and the samples after it are
+ *        SAMPLE_DELTA frames (reference sequence byte + residuals coded by
+ *        lib/rice) until the next key. A key starts every log block, so
+ *        each block still decodes on its own.
+ */
+#ifndef FDR_LOG_COMPRESS
+#define FDR_LOG_COMPRESS 1
+#endif
+
+// Flight state carried across watchdog / brown-out resets
+static RESTART_State restartState;
+static uint8_t restartSource;   ///< RESTART_Source of this boot
+static uint32_t bootStartMs;    ///< Timeline position at boot (ms)
+
+/**
+ * @brief Scheduler task indices
+ */
+enum TaskId {
+  TASK_SAMPLE = 0,     ///< Sensor read, fusion, flight state, logging
+  TASK_VIB,            ///< Vibration FIFO drain and FFT
+  TASK_CONSOLE,        ///< UART commands
+  TASK_TELEMETRY,      ///< LoRa telemetry
+  TASK_LED,            ///< Status LED
+  TASK_POWER,          ///< Battery monitor and rate governor
+  TASK_COUNT
+};
+
+/**
+ * @brief Binary record payloads (little endian, no padding on AVR)
+ */
+typedef struct {
+  uint32_t accelScale;   ///< Accelerometer scale (ug/LSB)
+  uint32_t gyroScale;    ///< Gyroscope scale (udps/LSB)
+  uint32_t zeroLvlPress; ///< Baro reference (Pa)
+} InfoRecord;
+
+typedef struct {
+  uint32_t timestamp;    ///< us
+  int16_t temperature;   ///< 0.01 C
+  uint32_t pressure;     ///< Pa
+  int32_t altitude;      ///< Baro altitude (cm)
+  int32_t kfAltitude;    ///< Filtered altitude (cm)
+  int32_t kfVelocity;    ///< Filtered vertical velocity (cm/s)
+  int16_t accel[3];      ///< Calibrated accelerometer (LSB)
+  int16_t gyro[3];       ///< Calibrated gyroscope (LSB)
+  uint8_t phase;         ///< FLIGHT_Phase
+} SampleRecord;
+
+typedef struct {
+  uint32_t timestamp;    ///< us
+  uint8_t phase;         ///< New FLIGHT_Phase
+  uint16_t uartOverflows;///< UART ring overflow count
+} EventRecord;
+
+typedef struct {
+  uint32_t timestamp;    ///< us
+  FFT_Summary summary;   ///< Spectrum summary
+} VibRecord;
+
+typedef struct {
+  uint32_t timestamp;    ///< us, first instant after the restart
+  uint8_t cause;         ///< MCUSR at reset
+  uint8_t source;        ///< RESTART_Source
+  uint8_t restarts;      ///< Warm restarts since the cold boot
+  uint8_t phase;         ///< Resumed FLIGHT_Phase
+} GapRecord;
+
+typedef struct {
+  uint32_t firstLba;     ///< Log file start block
+  uint32_t sectors;      ///< Log file length (blocks)
+  uint16_t benchKBps;    ///< Boot benchmark write rate (KB/s)
+  uint16_t maxBusyUs;    ///< Longest card busy during the benchmark (us)
+  uint8_t status;        ///< FAT32_Status of the preallocation
+} StorageRecord;
+
+static StorageRecord storage;
+
+typedef struct {
+  uint32_t timestamp;    ///< us
+  uint16_t dropped[LOGQ_PRIO_COUNT]; ///< Records dropped so far: low, normal, high
+  uint8_t maxUsed;       ///< Log queue high-water mark (bytes)
+  uint16_t maxWaitMs;    ///< Longest card busy the queue waited out (ms)
+} DropRecord;
+
+typedef struct {
+  uint32_t timestamp;    ///< us
+  uint16_t busMv;        ///< Battery voltage (mV)
+  int16_t currentMa;     ///< Battery current (mA, positive = discharge)
+  uint16_t powerMw;      ///< Power (mW)
+  uint8_t charge;        ///< Remaining charge (%)
+  uint8_t level;         ///< POWER_Level
+  uint16_t enduranceMin; ///< Time left at the averaged current (min), 0xFFFF = not discharging
+  uint8_t alert;         ///< Under-voltage alert latched since the last record
+} PowerRecord;
+
+typedef struct {
+  uint32_t timestamp;    ///< us
+  uint8_t state[DEV_COUNT];   ///< HEALTH_State: baro, IMU, power monitor
+  uint16_t errors[DEV_COUNT]; ///< Errors and failed re-probes since boot
+} HealthRecord;
+
 static SPI_HandleTypeDef spiHandle = {
     .config = {
         .spiMode = SPI_MODE0,      // SPI mode 0
@@ -51,10 +375,1481 @@ static SPI_HandleTypeDef spiHandle = {
 };
 
 /**
- * @brief Helper macro to split float into int and 2-digit fractional part
- * @param x Floating point value
+ * @brief Text line buffer size; the longest sample line is ~180 chars.
  */
-#define PRINT_FLOAT(x) ((int)(x)), (abs((int)((x)*100)) % 100)
+#define FDR_LINE_MAX 192
+
+/**
+ * @brief Set to 1 to time the text sample line through printf and FMT at boot.
+ *        Pulls vfprintf back into the image, so leave it off for size builds.
+ *        No speed or size figures are claimed for FMT until measured this
+ *        way on the target (flash: `pio run -t size` with and without it).
+ */
+#ifndef FDR_FMT_BENCH
+#define FDR_FMT_BENCH 0
+#endif
+
+// Accelerometer (ug/LSB) and gyroscope (udps/LSB) scales for text fields
+static uint32_t fmtScales[2];
+#define FMT_SCALE_ACCEL 0
+#define FMT_SCALE_GYRO  1
+
+// Text layout of SampleRecord
+static const FMT_Field sampleFields[] PROGMEM = {
+  { "t:",    "",     offsetof(SampleRecord, timestamp),   FMT_U32, 0 },
+  { "T:",    "C",    offsetof(SampleRecord, temperature), FMT_I16, 2 },
+  { "P:",    "Pa",   offsetof(SampleRecord, pressure),    FMT_U32, 0 },
+  { "Alt:",  "cm",   offsetof(SampleRecord, altitude),    FMT_I32, 0 },
+  { "KAlt:", "cm",   offsetof(SampleRecord, kfAltitude),  FMT_I32, 0 },
+  { "KVel:", "cm/s", offsetof(SampleRecord, kfVelocity),  FMT_I32, 0 },
+  { "Ax:",   "",     offsetof(SampleRecord, accel[0]),    FMT_I16_SCALED, FMT_SCALE_ACCEL },
+  { "Ay:",   "",     offsetof(SampleRecord, accel[1]),    FMT_I16_SCALED, FMT_SCALE_ACCEL },
+  { "Az:",   "",     offsetof(SampleRecord, accel[2]),    FMT_I16_SCALED, FMT_SCALE_ACCEL },
+  { "Gx:",   "",     offsetof(SampleRecord, gyro[0]),     FMT_I16_SCALED, FMT_SCALE_GYRO },
+  { "Gy:",   "",     offsetof(SampleRecord, gyro[1]),     FMT_I16_SCALED, FMT_SCALE_GYRO },
+  { "Gz:",   "",     offsetof(SampleRecord, gyro[2]),     FMT_I16_SCALED, FMT_SCALE_GYRO },
+};
+
+// Text layout of PRETRIG_Sample (prefixed with "PRE:")
+static const FMT_Field pretrigFields[] PROGMEM = {
+  { "",      "",     offsetof(PRETRIG_Sample, timestamp), FMT_U32, 0 },
+  { "P:",    "Pa",   offsetof(PRETRIG_Sample, pressure),  FMT_U32, 0 },
+  { "Ax:",   "",     offsetof(PRETRIG_Sample, accel[0]),  FMT_I16_SCALED, FMT_SCALE_ACCEL },
+  { "Ay:",   "",     offsetof(PRETRIG_Sample, accel[1]),  FMT_I16_SCALED, FMT_SCALE_ACCEL },
+  { "Az:",   "",     offsetof(PRETRIG_Sample, accel[2]),  FMT_I16_SCALED, FMT_SCALE_ACCEL },
+  { "Gx:",   "",     offsetof(PRETRIG_Sample, gyro[0]),   FMT_I16_SCALED, FMT_SCALE_GYRO },
+  { "Gy:",   "",     offsetof(PRETRIG_Sample, gyro[1]),   FMT_I16_SCALED, FMT_SCALE_GYRO },
+  { "Gz:",   "",     offsetof(PRETRIG_Sample, gyro[2]),   FMT_I16_SCALED, FMT_SCALE_GYRO },
+};
+
+static const char prefixPre[] PROGMEM = "PRE:";
+
+#if FDR_LOG_COMPRESS
+// Predicted channels of SampleRecord and their Rice parameter after a key
+static const RICE_Channel sampleChannels[] PROGMEM = {
+  { offsetof(SampleRecord, timestamp),   RICE_T32, 6 },
+  { offsetof(SampleRecord, temperature), RICE_I16, 1 },
+  { offsetof(SampleRecord, pressure),    RICE_U32, 3 },
+  { offsetof(SampleRecord, altitude),    RICE_I32, 4 },
+  { offsetof(SampleRecord, kfAltitude),  RICE_I32, 3 },
+  { offsetof(SampleRecord, kfVelocity),  RICE_I32, 3 },
+  { offsetof(SampleRecord, accel[0]),    RICE_I16, 5 },
+  { offsetof(SampleRecord, accel[1]),    RICE_I16, 5 },
+  { offsetof(SampleRecord, accel[2]),    RICE_I16, 5 },
+  { offsetof(SampleRecord, gyro[0]),     RICE_I16, 4 },
+  { offsetof(SampleRecord, gyro[1]),     RICE_I16, 4 },
+  { offsetof(SampleRecord, gyro[2]),     RICE_I16, 4 },
+  { offsetof(SampleRecord, phase),       RICE_U8,  0 },
+};
+
+static RICE_Handle sampleRice;
+static uint32_t sampleBlock;     ///< Log block the reference frame starts in
+static uint16_t sampleDropped;   ///< Normal-priority drops at the last sample
+static uint8_t sampleRef;        ///< Low byte of the reference frame's sequence
+#endif
+
+/**
+ * @brief Drop priority of a record type when the card lags: samples before
+ *        the rare records needed to read them, diagnostics first.
+ */
+static uint8_t StoragePriority(uint8_t type) {
+  switch (type) {
+    case FRAME_TYPE_SAMPLE:
+    case FRAME_TYPE_SAMPLE_DELTA:
+    case FRAME_TYPE_PRETRIG:
+    case FRAME_TYPE_POWER:
+      return LOGQ_PRIO_NORMAL;
+    case FRAME_TYPE_VIB:
+    case FRAME_TYPE_TRACE:
+      return LOGQ_PRIO_LOW;
+    default:
+      return LOGQ_PRIO_HIGH;
+  }
+}
+
+/**
+ * @brief Log consumer: move one contiguous run of queued bytes into the SD
+ *        stream. Never writes past the open block and never opens one while
+ *        the card is busy, so it cannot stall the caller. A write error or
+ *        the end of the log file stops SD logging.
+ * @return 1 if bytes were written
+ */
+static uint8_t StorageDrain(void) {
+  const uint8_t *data;
+  uint8_t n = LOGQ_Peek(&logq, &data);
+  if (!n || !sdOk || !SD_StreamReady(&sd))
+    return 0;
+
+  uint16_t room = LOGBLK_Room(&logblk);
+  if (n > room)
+    n = (uint8_t)room;
+  if (LOGBLK_Write(&logblk, data, n) != SD_OK) {
+    sdOk = 0;
+    FRAME_SetStore(NULL);
+    LOGQ_Init(&logq);
+    return 0;
+  }
+  LOGQ_Consume(&logq, n);
+  return 1;
+}
+
+/**
+ * @brief Frame storage sink (producer). Makes room inline as long as the
+ *        card takes data without waiting; while it is busy the record is
+ *        queued or dropped by priority.
+ */
+static void StoreFrame(uint8_t type, const uint8_t *data, uint8_t len) {
+  uint8_t prio = StoragePriority(type);
+  while (!LOGQ_Fits(&logq, len, prio) && StorageDrain())
+    ;
+  LOGQ_Push(&logq, data, len, prio);
+}
+
+/**
+ * @brief Release the SPI bus for the radio. The queue holds whole frames
+ *        only, so once it is written out the open block ends on a frame
+ *        boundary and can be zero-padded.
+ */
+static void StoragePause(void) {
+  if (!sdOk)
+    return;
+  while (sd.open && StorageDrain())
+    ;
+  LOGBLK_Pad(&logblk);
+}
+
+/**
+ * @brief Apply the acquisition profile of the current flight phase.
+ *        Switches IMU ODR, baro oversampling and LoRa spreading factor.
+ *        On the pad, under the parachute and after landing each power-saving
+ *        level halves the log and telemetry rates and dims the LED; under the
+ *        parachute and after landing it halves the IMU ODR as well. The pad
+ *        keeps its IMU and sample rate so that neither launch detection nor
+ *        the pre-trigger history waits on the battery; boost to apogee always
+ *        run at full rate.
+ */
+static void ApplyFlightProfile(void) {
+  FLIGHT_GetProfile(flight.phase, &profile);
+
+  uint8_t level = 0;
+  if (flight.phase == FLIGHT_IDLE || flight.phase >= FLIGHT_DESCENT)
+    level = power.level;
+  if (flight.phase != FLIGHT_IDLE)
+    profile.imuODR = profile.imuODR > LSM6DS3_ODR_12HZ5 + level ? profile.imuODR - level : LSM6DS3_ODR_12HZ5;
+  profile.logPeriodMs <<= level;
+  profile.loraPeriodMs <<= level;
+  LED_SetBrightness(pgm_read_byte(&powerBrightness[level]));
+
+  // A window must not mix two sample rates
+  if (fftActive) {
+    LSM6DS3_FifoStop(&lsm);
+    fftActive = 0;
+  }
+  // A failed sensor gets the settings when it is probed again
+  if (health[DEV_IMU].state != HEALTH_FAILED)
+    LSM6DS3_SetODR(&lsm, (LSM6DS3_ODR)profile.imuODR, (LSM6DS3_ODR)profile.imuODR);
+  lsm.accelODR = lsm.gyroODR = (LSM6DS3_ODR)profile.imuODR;
+
+  bmp.config.oversampling = (BMP280_Oversampling)profile.baroOversampling;
+  if (health[DEV_BARO].state != HEALTH_FAILED)
+    BMP280_SetConfig(&bmp, &bmp.config);
+
+  if (loraOk && lora.config.spreadingFactor != profile.loraSF) {
+    lora.config.spreadingFactor = profile.loraSF;
+    StoragePause();      ///< The card holds the bus while a block is open
+    LoRa_SetConfig(&lora, &lora.config);
+  }
+
+  // Status pattern: heartbeat on the pad, strobe in flight, beacon after landing
+  if (flight.phase == FLIGHT_IDLE)
+    LED_Play(LED_PAT_HEARTBEAT);
+  else if (flight.phase == FLIGHT_LANDED)
+    LED_Play(LED_PAT_LANDED);
+  else
+    LED_Play(LED_PAT_FLIGHT);
+
+  // On the pad sample fast into the pre-trigger ring, in flight at the log rate
+  uint16_t samplePeriod = flight.phase == FLIGHT_IDLE ? PRETRIG_PERIOD_MS : profile.logPeriodMs;
+  SCHED_SetPeriod(TASK_SAMPLE, samplePeriod * 1000UL);
+  // Without a radio (POST code 5) the blocking TX-done wait would never end
+  SCHED_SetPeriod(TASK_TELEMETRY, loraOk ? profile.loraPeriodMs * 1000UL : 0);
+}
+
+/**
+ * @brief Emit the scale/reference record binary hosts need to decode samples.
+ *        Always stored; on the UART in binary mode only.
+ */
+static void LogInfo(void) {
+  fmtScales[FMT_SCALE_ACCEL] = (uint32_t)(lsm.accelScale * 1e6f + 0.5f);
+  fmtScales[FMT_SCALE_GYRO] = (uint32_t)(lsm.gyroScale * 1e6f + 0.5f);
+  InfoRecord rec;
+  rec.accelScale = fmtScales[FMT_SCALE_ACCEL];
+  rec.gyroScale = fmtScales[FMT_SCALE_GYRO];
+  rec.zeroLvlPress = bmp.zeroLvlPress;
+  FRAME_Log(FRAME_TYPE_INFO, &rec, sizeof(rec), outputBinary);
+}
+
+/**
+ * @brief Fill a sample record from the current sensor and filter state.
+ */
+static void BuildSample(SampleRecord *rec, uint32_t t, const int16_t rawAccel[3], const int16_t rawGyro[3]) {
+  rec->timestamp = t;
+  rec->temperature = (int16_t)bmp.temperature;
+  rec->pressure = bmp.pressure;
+  rec->altitude = bmp.altitude;
+  rec->kfAltitude = KF_GetAltitude(&kf);
+  rec->kfVelocity = KF_GetVelocity(&kf);
+  for (uint8_t i = 0; i < 3; i++) {
+    rec->accel[i] = rawAccel[i];
+    rec->gyro[i] = rawGyro[i];
+  }
+  rec->phase = flight.phase;
+}
+
+/**
+ * @brief Code a live sample against the previous one for the card.
+ *        The sample becomes a key when there is no SD log (a UART host
+ *        may join at any time), when it would start a new log block, or
+ *        when a sample frame may have been dropped since the reference.
+ * @param rec Sample
+ * @param out Reference sequence byte + coded residuals (sizeof(*rec) bytes)
+ * @return Payload length, 0 to send the sample as a SAMPLE frame
+ */
+static uint8_t CompressSample(const SampleRecord *rec, uint8_t *out) {
+#if FDR_LOG_COMPRESS
+  if (!sdOk)
+    return 0;
+
+  // Block this frame starts in once the queue ahead of it is written
+  uint32_t block = logblk.seq + (logblk.used + LOGQ_Used(&logq)) / LOGBLK_PAYLOAD;
+  uint16_t dropped = logq.dropped[LOGQ_PRIO_NORMAL];
+  if (block != sampleBlock || dropped != sampleDropped)
+    RICE_Reset(&sampleRice);
+  sampleBlock = block;
+  sampleDropped = dropped;
+
+  uint8_t ref = sampleRef;
+  sampleRef = (uint8_t)FRAME_GetSequence();
+  uint8_t n = RICE_Encode(&sampleRice, rec, out + 1);
+  if (!n)
+    return 0;
+  out[0] = ref;
+  return n + 1;
+#else
+  (void)rec;
+  (void)out;
+  return 0;
+#endif
+}
+
+/**
+ * @brief Store one live sample and emit it as a text line or a binary frame.
+ *        The other Log* functions follow the same pattern: the frame always
+ *        goes to the SD log, the UART gets either the frame or the text.
+ */
+static void LogSample(uint32_t t, const int16_t rawAccel[3], const int16_t rawGyro[3]) {
+  SampleRecord rec;
+  BuildSample(&rec, t, rawAccel, rawGyro);
+
+  uint8_t packed[sizeof(rec)];
+  PROF_BEGIN(PROF_COMPRESS);
+  uint8_t n = CompressSample(&rec, packed);
+  PROF_END(PROF_COMPRESS);
+  if (n)
+    FRAME_Log(FRAME_TYPE_SAMPLE_DELTA, packed, n, outputBinary);
+  else
+    FRAME_Log(FRAME_TYPE_SAMPLE, &rec, sizeof(rec), outputBinary);
+  if (outputBinary)
+    return;
+
+  char line[FDR_LINE_MAX];
+  FMT_Record(line, NULL, &rec, sampleFields, sizeof(sampleFields) / sizeof(sampleFields[0]), fmtScales);
+  UART_TransmitString(line);
+}
+
+/**
+ * @brief Emit a flight-phase transition.
+ * @param t Timestamp of the sample that caused it (us)
+ */
+static void LogEvent(uint32_t t) {
+  EventRecord rec = { t, (uint8_t)flight.phase, UART_GetOverflowCount() };
+  FRAME_Log(FRAME_TYPE_EVENT, &rec, sizeof(rec), outputBinary);
+  if (outputBinary)
+    return;
+  char line[48];
+  char *p = FMT_StrP(line, PSTR("EVT:\t"));
+  p = FMT_UInt(p, t);
+  *p++ = '\t';
+  p = FMT_StrP(p, FLIGHT_PhaseName(flight.phase));
+  p = FMT_StrP(p, PSTR("\tovf:\t"));
+  p = FMT_UInt(p, UART_GetOverflowCount());
+  FMT_End(p);
+  UART_TransmitString(line);
+}
+
+/**
+ * @brief Mark a warm restart: records before this one are followed by an
+ *        outage of unknown length (at least the watchdog period after a
+ *        watchdog reset); timestamps continue from the last snapshot.
+ */
+static void LogGap(void) {
+  GapRecord rec = { TIM_GetMicros(), RESTART_GetCause(), restartSource,
+                    restartState.restarts, (uint8_t)flight.phase };
+  FRAME_Log(FRAME_TYPE_GAP, &rec, sizeof(rec), outputBinary);
+  if (outputBinary)
+    return;
+  char line[64];
+  char *p = FMT_StrP(line, PSTR("GAP:\t"));
+  p = FMT_UInt(p, rec.timestamp);
+  p = FMT_StrP(p, PSTR("\tcause\t0x"));
+  p = FMT_Hex8(p, rec.cause);
+  p = FMT_StrP(p, rec.source == RESTART_WARM_RAM ? PSTR("\tram\t") : PSTR("\teeprom\t"));
+  p = FMT_UInt(p, rec.restarts);
+  *p++ = '\t';
+  p = FMT_StrP(p, FLIGHT_PhaseName(flight.phase));
+  FMT_End(p);
+  UART_TransmitString(line);
+}
+
+/**
+ * @brief Log the overrun counters after the card lagged and records were
+ *        dropped; the frame sequence gap shows where.
+ */
+static void LogDrops(uint32_t t) {
+  DropRecord rec;
+  rec.timestamp = t;
+  for (uint8_t i = 0; i < LOGQ_PRIO_COUNT; i++)
+    rec.dropped[i] = logq.dropped[i];
+  rec.maxUsed = logq.maxUsed;
+  rec.maxWaitMs = sd.maxWaitMs;
+  FRAME_Log(FRAME_TYPE_DROP, &rec, sizeof(rec), outputBinary);
+  if (outputBinary)
+    return;
+  char line[48];
+  char *p = FMT_StrP(line, PSTR("DROP:\t"));
+  p = FMT_UInt(p, t);
+  for (uint8_t i = 0; i < LOGQ_PRIO_COUNT; i++) {
+    *p++ = '\t';
+    p = FMT_UInt(p, rec.dropped[i]);
+  }
+  *p++ = '\t';
+  p = FMT_UInt(p, rec.maxWaitMs);
+  p = FMT_StrP(p, PSTR("ms"));
+  FMT_End(p);
+  UART_TransmitString(line);
+}
+
+/**
+ * @brief Emit a battery record: measurement, charge, level and endurance.
+ */
+static void LogPower(uint32_t t, uint8_t alert) {
+  PowerRecord rec;
+  rec.timestamp = t;
+  rec.busMv = ina.busMv;
+  rec.currentMa = ina.currentMa;
+  rec.powerMw = ina.powerMw;
+  rec.charge = POWER_GetCharge(&power);
+  rec.level = power.level;
+  rec.enduranceMin = POWER_GetEndurance(&power);
+  rec.alert = alert;
+  FRAME_Log(FRAME_TYPE_POWER, &rec, sizeof(rec), outputBinary);
+  if (outputBinary)
+    return;
+  char line[64];
+  char *p = FMT_StrP(line, PSTR("PWR:\t"));
+  p = FMT_UInt(p, t);
+  *p++ = '\t';
+  p = FMT_UInt(p, rec.busMv);
+  p = FMT_StrP(p, PSTR("mV\t"));
+  p = FMT_Int(p, rec.currentMa);
+  p = FMT_StrP(p, PSTR("mA\t"));
+  p = FMT_UInt(p, rec.powerMw);
+  p = FMT_StrP(p, PSTR("mW\t"));
+  p = FMT_UInt(p, rec.charge);
+  p = FMT_StrP(p, PSTR("%\tlvl:\t"));
+  p = FMT_UInt(p, rec.level);
+  *p++ = '\t';
+  if (rec.enduranceMin != 0xFFFF) {
+    p = FMT_UInt(p, rec.enduranceMin);
+    p = FMT_StrP(p, PSTR("min"));
+  } else {
+    *p++ = '-';
+  }
+  if (alert)
+    p = FMT_StrP(p, PSTR("\tALERT"));
+  FMT_End(p);
+  UART_TransmitString(line);
+}
+
+/**
+ * @brief Emit the health of every sensor; logged at boot and on each change.
+ */
+static void LogHealth(uint32_t t) {
+  HealthRecord rec;
+  rec.timestamp = t;
+  for (uint8_t i = 0; i < DEV_COUNT; i++) {
+    rec.state[i] = health[i].state;
+    rec.errors[i] = health[i].errors;
+  }
+  FRAME_Log(FRAME_TYPE_HEALTH, &rec, sizeof(rec), outputBinary);
+  if (outputBinary)
+    return;
+  char line[80];
+  char *p = FMT_StrP(line, PSTR("HEALTH:\t"));
+  p = FMT_UInt(p, t);
+  for (uint8_t i = 0; i < DEV_COUNT; i++) {
+    *p++ = '\t';
+    p = FMT_StrP(p, (const char *)pgm_read_word(&devNames[i]));
+    *p++ = '\t';
+    p = FMT_StrP(p, HEALTH_StateName(rec.state[i]));
+    *p++ = '\t';
+    p = FMT_UInt(p, rec.errors[i]);
+  }
+  FMT_End(p);
+  UART_TransmitString(line);
+}
+
+/**
+ * @brief Record the outcome of a sensor access; a state change is logged.
+ */
+static void SensorReport(uint8_t id, uint8_t ok, uint32_t ms) {
+  if (HEALTH_Report(&health[id], ok, ms))
+    LogHealth(TIM_GetMicros());
+}
+
+/**
+ * @brief Arm the launch and burnout events; after every IMU (re)initialization.
+ */
+static uint8_t ArmImuEvents(void) {
+  return LSM6DS3_ConfigEvents(&lsm, FDR_WAKE_THS, FDR_FF_THS, FDR_FF_DUR);
+}
+
+/**
+ * @brief Decide whether to read a sensor this time. A failed one is skipped,
+ *        so it costs no bus timeouts, until its backoff expires; then it is
+ *        re-initialized with the current settings (never re-zeroed) and, if
+ *        that works, read on probation.
+ * @return 1 if the caller should read the sensor and report the outcome
+ */
+static uint8_t SensorReady(uint8_t id, uint32_t ms) {
+  if (!HEALTH_Due(&health[id], ms))
+    return 0;
+  if (health[id].state != HEALTH_FAILED)
+    return 1;
+
+  uint8_t found;
+  if (id == DEV_BARO) {
+    found = BMP280_Init(&bmp) == BMP280_OK;
+  } else if (id == DEV_IMU) {
+    found = LSM6DS3_Init(&lsm, LSM6DS3_XL_16G, LSM6DS3_GYRO_2000DPS);
+    if (found) {
+      LSM6DS3_SetCalibration(&lsm, calib.gyroBias, calib.accelOffset, calib.accelGain);
+      ArmImuEvents();
+    }
+  } else {
+    found = INA226_Init(&ina) == INA226_OK &&
+            INA226_SetAlert(&ina, INA226_ALERT_BUS_UNDER, FDR_POWER_CRITICAL_MV, 1) == INA226_OK;
+  }
+  SensorReport(id, found, ms);
+  return found;
+}
+
+/**
+ * @brief Emit a vibration spectrum summary.
+ */
+static void LogVib(uint32_t t) {
+  VibRecord rec;
+  rec.timestamp = t;
+  rec.summary = vib;
+  FRAME_Log(FRAME_TYPE_VIB, &rec, sizeof(rec), outputBinary);
+  if (outputBinary)
+    return;
+  char line[48 + 4 * FFT_BANDS];
+  char *p = FMT_StrP(line, PSTR("VIB:\t"));
+  p = FMT_UInt(p, t);
+  *p++ = '\t';
+  p = FMT_UInt(p, vib.sampleRate);
+  p = FMT_StrP(p, PSTR("Hz\t"));
+  p = FMT_UInt(p, vib.processUs);
+  p = FMT_StrP(p, PSTR("us\tpk:\t"));
+  p = FMT_UInt(p, vib.peakBin);
+  for (uint8_t b = 0; b < FFT_BANDS; b++) {
+    *p++ = '\t';
+    p = FMT_UInt(p, vib.band[b]);
+  }
+  FMT_End(p);
+  UART_TransmitString(line);
+}
+
+/**
+ * @brief Emit one pre-trigger record in the live layout.
+ * @param s Unpacked pre-trigger sample
+ */
+static void LogPretrigSample(const PRETRIG_Sample *s) {
+  FRAME_Log(FRAME_TYPE_PRETRIG, s, sizeof(*s), outputBinary);
+  if (outputBinary)
+    return;
+
+  char line[FDR_LINE_MAX];
+  FMT_Record(line, prefixPre, s, pretrigFields, sizeof(pretrigFields) / sizeof(pretrigFields[0]), fmtScales);
+  UART_TransmitString(line);
+}
+
+/**
+ * @brief Print one statistics line per scheduler task, the sleep duty
+ *        cycle and the SD log queue, then start a new measurement window.
+ *        Wrapped in delimiters in binary mode.
+ *        "LOG:\tq:\t<max>/<size>\tdrop:\t<low>/<normal>/<high>\tblk:\t<n>\t
+ *         err:\t<n>\twait:\t<max>ms\tzip:\t<coded>/<raw>"
+ *        zip counts live sample bytes since boot (FDR_LOG_COMPRESS builds).
+ */
+static void DumpSchedStats(void) {
+  char line[FDR_LINE_MAX];
+  if (outputBinary)
+    UART_Transmit(0x00);
+  for (uint8_t i = 0; i < SCHED_TaskCount(); i++) {
+    SCHED_FormatTask(i, line);
+    UART_TransmitString(line);
+  }
+  SCHED_FormatIdle(line);
+  UART_TransmitString(line);
+
+  char *p = FMT_StrP(line, PSTR("LOG:\tq:\t"));
+  p = FMT_UInt(p, logq.maxUsed);
+  *p++ = '/';
+  p = FMT_UInt(p, LOGQ_SIZE);
+  p = FMT_StrP(p, PSTR("\tdrop:"));
+  for (uint8_t i = 0; i < LOGQ_PRIO_COUNT; i++) {
+    *p++ = i ? '/' : '\t';
+    p = FMT_UInt(p, logq.dropped[i]);
+  }
+  p = FMT_StrP(p, PSTR("\tblk:\t"));
+  p = FMT_UInt(p, sd.blocks);
+  p = FMT_StrP(p, PSTR("\terr:\t"));
+  p = FMT_UInt(p, sd.errors);
+  p = FMT_StrP(p, PSTR("\twait:\t"));
+  p = FMT_UInt(p, sd.maxWaitMs);
+  p = FMT_StrP(p, PSTR("ms"));
+#if FDR_LOG_COMPRESS
+  p = FMT_StrP(p, PSTR("\tzip:\t"));
+  p = FMT_UInt(p, sampleRice.codedBytes);
+  *p++ = '/';
+  p = FMT_UInt(p, sampleRice.rawBytes);
+#endif
+  FMT_End(p);
+  UART_TransmitString(line);
+
+  if (outputBinary)
+    UART_Transmit(0x00);
+  SCHED_ResetStats();
+  logq.maxUsed = 0;
+}
+
+#if BUSTRACE_ENABLE
+/**
+ * @brief Store the bus trace (oldest first) and emit it as text lines or
+ *        TRACE frames, then clear it and resume recording.
+ */
+static void DumpBusTrace(void) {
+  BUSTRACE_Entry e;
+  char line[64];
+
+  for (uint8_t i = 0; BUSTRACE_Get(i, &e); i++) {
+    FRAME_Log(FRAME_TYPE_TRACE, &e, sizeof(e), outputBinary);
+    if (!outputBinary) {
+      BUSTRACE_Format(&e, line);
+      UART_TransmitString(line);
+    }
+  }
+  BUSTRACE_Unfreeze();
+}
+#endif
+
+#if PROF_ENABLE
+/**
+ * @brief Print the profiled regions (CPU cycles) and clear them.
+ */
+static void DumpProfile(void) {
+  char line[FDR_LINE_MAX];
+  if (outputBinary)
+    UART_Transmit(0x00);
+  for (uint8_t i = 0; i < PROF_COUNT; i++) {
+    PROF_Format(i, line);
+    UART_TransmitString(line);
+  }
+  if (outputBinary)
+    UART_Transmit(0x00);
+  PROF_Reset();
+}
+#endif
+
+/**
+ * @brief Serve a bulk log offload (tools/fdr_offload.py) until the host is
+ *        done. The log stream is stopped so the card can be read, then
+ *        continues at the next block; the open block is padded first.
+ */
+static void Offload(void) {
+  StoragePause();
+  SD_StreamStop(&sd);
+
+  OFFLOAD_Handle ol = { &sd, sdOk ? sd.lba : 0, sdOk ? sd.endLba : 0, restartState.bootId };
+  OFFLOAD_Run(&ol, FDR_UART_BAUD);
+
+  if (sdOk && SD_StreamStart(&sd, sd.lba, sd.endLba) != SD_OK) {
+    sdOk = 0;
+    FRAME_SetStore(NULL);
+    LOGQ_Init(&logq);
+  }
+}
+
+/**
+ * @brief Back on the pad after a re-arm: the landing site is the new
+ *        altitude zero and the pre-trigger history starts over.
+ */
+static void RearmPad(void) {
+  // An unhealthy baro is zeroed by the sample task once it recovers
+  baroZeroLive = health[DEV_BARO].state == HEALTH_OK;
+  if (baroZeroLive)
+    bmp.zeroLvlPress = bmp.pressure;
+  bmp.altitude = 0;
+  KF_Init(&kf, 1.0f, 0);
+  PRETRIG_Init(&pretrig);
+}
+
+/**
+ * @brief Handle a single-character console command.
+ *        'c' level calibration (rest, +Z up), 'x'/'X', 'y'/'Y', 'z'/'Z'
+ *        capture the axis pointing down/up for accelerometer gain.
+ *        Results are applied and saved to EEPROM immediately.
+ *        'b' / 't' switch the output to binary frames / text lines.
+ *        's' dumps and clears the scheduler task and sleep statistics,
+ *        'p' the profiled regions (PROF_ENABLE builds only), 'd' the bus
+ *        trace (BUSTRACE_ENABLE builds only).
+ *        'o' starts a bulk log offload.
+ *        'a' re-arms a landed recorder on the pad.
+ * @param cmd Received character
+ */
+static void HandleCommand(char cmd) {
+  CALIB_Status st;
+
+  switch (cmd) {
+    case 's':
+      DumpSchedStats();
+      return;
+#if BUSTRACE_ENABLE
+    case 'd':
+      DumpBusTrace();
+      return;
+#endif
+#if PROF_ENABLE
+    case 'p':
+      DumpProfile();
+      return;
+#endif
+    case 'b':
+      outputBinary = 1;
+      LogInfo();
+      return;
+    case 't':
+      outputBinary = 0;
+      return;
+    case 'o':
+      Offload();
+      return;
+    case 'a':
+      if (FLIGHT_Rearm(&flight, TIM_GetMillis())) {
+        RearmPad();
+        LogEvent(TIM_GetMicros());
+        ApplyFlightProfile();
+      }
+      return;
+    case 'c':
+      LED_Play(LED_PAT_BUSY);
+      LED_Update(TIM_GetMillis());
+      st = CALIB_MeasureLevel(&calib, &lsm, &bmp);
+      break;
+    case 'x': case 'X':
+    case 'y': case 'Y':
+    case 'z': case 'Z':
+      LED_Play(LED_PAT_BUSY);
+      LED_Update(TIM_GetMillis());
+      st = CALIB_MeasureAxis(&calib, &lsm, (cmd | 0x20) - 'x', cmd < 'a');
+      break;
+    default:
+      return;
+  }
+  LED_Play(LED_PAT_HEARTBEAT);
+
+  if (st == CALIB_OK) {
+    CALIB_Save(&calib);
+    CALIB_Apply(&calib, &lsm, &bmp);
+  }
+  // Text reply; in binary mode the surrounding delimiters make hosts drop it as one bad frame
+  char line[FDR_LINE_MAX];
+  char *p = FMT_StrP(line, PSTR("CAL:\t"));
+  *p++ = cmd;
+  *p++ = '\t';
+  p = FMT_Int(p, st);
+  const int16_t *groups[3] = { calib.gyroBias, calib.accelOffset, calib.accelGain };
+  for (uint8_t g = 0; g < 3; g++) {
+    *p++ = '\t';
+    *p++ = "GAK"[g];
+    *p++ = ':';
+    for (uint8_t i = 0; i < 3; i++) {
+      *p++ = '\t';
+      p = FMT_Int(p, groups[g][i]);
+    }
+  }
+  p = FMT_StrP(p, PSTR("\tP0:\t"));
+  p = FMT_UInt(p, calib.baroRef);
+  FMT_End(p);
+
+  if (outputBinary)
+    UART_Transmit(0x00);
+  UART_TransmitString(line);
+  if (outputBinary)
+    UART_Transmit(0x00);
+}
+
+/**
+ * @brief Print a boot status line "<label> <status>".
+ * @param label PROGMEM label
+ * @param status Status code
+ */
+static void PrintStatus(const char *label, int16_t status) {
+  char line[32];
+  char *p = FMT_StrP(line, label);
+  *p++ = ' ';
+  p = FMT_Int(p, status);
+  FMT_End(p);
+  UART_TransmitString(line);
+}
+
+#if FDR_FMT_BENCH
+/**
+ * @brief Time one text sample line through printf and through FMT.
+ *        Prints "FMT:\t<fmt cycles>\t<printf cycles>" (64 cycles per tick).
+ */
+static void BenchFormat(void) {
+  static const uint8_t runs = 16;
+  char line[FDR_LINE_MAX];
+  SampleRecord rec = { 123456789UL, -1234, 101325UL, -1234, 56789, -321,
+                       { 2048, -2048, 32767 }, { -1, 1000, -32768 }, 0 };
+
+  uint32_t t0 = TIM_GetTicks();
+  for (uint8_t i = 0; i < runs; i++)
+    FMT_Record(line, NULL, &rec, sampleFields, sizeof(sampleFields) / sizeof(sampleFields[0]), fmtScales);
+  uint32_t fmtTicks = TIM_GetTicks() - t0;
+
+  t0 = TIM_GetTicks();
+  for (uint8_t i = 0; i < runs; i++) {
+    float a[3], g[3];
+    for (uint8_t k = 0; k < 3; k++) {
+      a[k] = rec.accel[k] * lsm.accelScale;
+      g[k] = rec.gyro[k] * lsm.gyroScale;
+    }
+    snprintf(line, sizeof(line),
+      "t:\t%lu\tT:\t%d.%02dC\tP:\t%luPa\tAlt:\t%ldcm\tKAlt:\t%ldcm\tKVel:\t%ldcm/s\tAx:\t%d.%02d\tAy:\t%d.%02d\tAz:\t%d.%02d\tGx:\t%d.%02d\tGy:\t%d.%02d\tGz:\t%d.%02d\n",
+      rec.timestamp, rec.temperature / 100, abs(rec.temperature % 100),
+      rec.pressure, rec.altitude, rec.kfAltitude, rec.kfVelocity,
+      (int)a[0], abs((int)(a[0] * 100)) % 100, (int)a[1], abs((int)(a[1] * 100)) % 100,
+      (int)a[2], abs((int)(a[2] * 100)) % 100, (int)g[0], abs((int)(g[0] * 100)) % 100,
+      (int)g[1], abs((int)(g[1] * 100)) % 100, (int)g[2], abs((int)(g[2] * 100)) % 100);
+  }
+  uint32_t printfTicks = TIM_GetTicks() - t0;
+
+  printf("FMT:\t%lu\t%lu\n", fmtTicks * 64 / runs, printfTicks * 64 / runs);
+}
+#endif
+
+/**
+ * @name Boot pipeline limits
+ * @{
+ */
+#ifndef BOOT_SETTLE_WINDOW_MS
+#define BOOT_SETTLE_WINDOW_MS 50    ///< Baro comparison interval, ~1 conversion at x16
+#endif
+#ifndef BOOT_SETTLE_PA
+#define BOOT_SETTLE_PA        2     ///< Max pressure change per window when settled (Pa)
+#endif
+#ifndef BOOT_SETTLE_WINDOWS
+#define BOOT_SETTLE_WINDOWS   3     ///< Consecutive settled windows required
+#endif
+#ifndef BOOT_SETTLE_MAX_MS
+#define BOOT_SETTLE_MAX_MS    3000  ///< Use whatever the filter reached after this
+#endif
+#ifndef BOOT_IMU_WARMUP_MS
+#define BOOT_IMU_WARMUP_MS    80    ///< LSM6DS3 gyro turn-on time
+#endif
+/** @} */
+
+static BOOT_Report bootReport;
+
+/**
+ * @brief Wait for the BMP280 IIR filter to settle: done once the pressure
+ *        changes by at most BOOT_SETTLE_PA over BOOT_SETTLE_WINDOWS windows.
+ *        Runs on every cold boot, the settled pressure is the altitude zero.
+ */
+static uint8_t BootSettleBaro(uint16_t elapsedMs) {
+  static uint16_t windowMs;
+  static uint32_t refPress;
+  static uint8_t stable;
+
+  if (!bmpOk)
+    return BOOT_DONE;
+  if (refPress && (uint16_t)(elapsedMs - windowMs) < BOOT_SETTLE_WINDOW_MS)
+    return BOOT_BUSY;
+  windowMs = elapsedMs;
+
+  if (BMP280_ReadPressure(&bmp) != BMP280_OK)
+    return BOOT_BUSY;
+  uint32_t delta = bmp.pressure > refPress ? bmp.pressure - refPress : refPress - bmp.pressure;
+  stable = refPress && delta <= BOOT_SETTLE_PA ? stable + 1 : 0;
+  refPress = bmp.pressure;
+  return stable >= BOOT_SETTLE_WINDOWS ? BOOT_DONE : BOOT_BUSY;
+}
+
+/**
+ * @brief Arm the launch / burnout events, then let the gyro finish its
+ *        turn-on before the first sample.
+ */
+static uint8_t BootWarmImu(uint16_t elapsedMs) {
+  static uint8_t armed;
+
+  if (!lsmOk)
+    return BOOT_DONE;
+  if (!armed) {
+    ArmImuEvents();
+    armed = 1;
+  }
+  return elapsedMs >= BOOT_IMU_WARMUP_MS ? BOOT_DONE : BOOT_BUSY;
+}
+
+/**
+ * @brief Preallocate this boot's log file, time the card on its first
+ *        blocks and start the log stream behind them. Each poll scans or
+ *        chains one FAT sector (at most 2 block reads and 2 writes with two
+ *        FATs), so the other steps keep running and the budget holds; the
+ *        last one writes the directory entry and runs the benchmark (~30 ms).
+ */
+static uint8_t BootStorage(uint16_t elapsedMs) {
+  static uint8_t started;
+  FAT32_File *file = &shared.boot.file;
+
+  if (!sdOk)
+    return BOOT_DONE;
+  if (!started) {
+    char name[12];
+    strcpy_P(name, PSTR("FDR00000BIN"));
+    started = 1;
+    storage.status = FAT32_CreateBegin(&shared.boot.op, &shared.boot.vol, &sd, shared.boot.buf,
+                                       name, FDR_LOG_MB * 1048576UL, file);
+    if (storage.status == FAT32_OK)
+      return BOOT_BUSY;
+  } else {
+    storage.status = FAT32_CreateStep(&shared.boot.op, &shared.boot.vol, &sd, shared.boot.buf, file);
+    if (storage.status == FAT32_BUSY)
+      return BOOT_BUSY;
+  }
+  if (storage.status != FAT32_OK ||
+      SD_StreamStart(&sd, file->firstLba, file->firstLba + file->sectors) != SD_OK) {
+    sdOk = 0;
+    return BOOT_DONE;
+  }
+  storage.firstLba = file->firstLba;
+  storage.sectors = file->sectors;
+
+  // Sustained rate through the stream path, busy offload included; the
+  // zero blocks read as empty log
+  uint32_t t0 = TIM_GetMicros();
+  for (uint8_t i = 0; i < FDR_SD_BENCH_BLOCKS; i++)
+    SD_StreamFill(&sd, 0x00, SD_BLOCK_SIZE);
+  uint32_t us = TIM_GetMicros() - t0;
+  storage.benchKBps = (uint16_t)(FDR_SD_BENCH_BLOCKS * 500000UL / (us ? us : 1));
+  storage.maxBusyUs = sd.maxBusyUs;
+
+  // Block numbers count from the start of the file, benchmark included
+  LOGBLK_Init(&logblk, &sd, restartState.bootId, FDR_LOG_SCHEMA, FDR_SD_BENCH_BLOCKS);
+  FRAME_SetStore(StoreFrame);
+  return BOOT_DONE;
+}
+
+/**
+ * @brief Configure the radio found by the POST.
+ */
+static uint8_t BootRadio(uint16_t elapsedMs) {
+  if (loraOk)
+    loraOk = LoRa_Init(&lora);
+  return BOOT_DONE;
+}
+
+static const char bootNameBaro[] PROGMEM = "baro_settle";
+static const char bootNameImu[] PROGMEM = "imu_warmup";
+static const char bootNameRadio[] PROGMEM = "lora_config";
+static const char bootNameStorage[] PROGMEM = "sd_prealloc";
+
+static const BOOT_Step bootSteps[] PROGMEM = {
+  { BootSettleBaro, bootNameBaro,  BOOT_SETTLE_MAX_MS },
+  { BootWarmImu,    bootNameImu,   BOOT_IMU_WARMUP_MS + 20 },
+  { BootRadio,      bootNameRadio, 10 },
+  { BootStorage,    bootNameStorage, BOOT_SETTLE_MAX_MS },
+};
+#define BOOT_STEP_COUNT (sizeof(bootSteps) / sizeof(bootSteps[0]))
+
+/**
+ * @brief Log the boot pipeline timing; called with the first logged sample.
+ */
+static void LogBoot(void) {
+  FRAME_Log(FRAME_TYPE_BOOT, &bootReport, sizeof(bootReport), outputBinary);
+  if (outputBinary)
+    return;
+  char line[40];
+  for (uint8_t i = 0; i < bootReport.count; i++) {
+    BOOT_FormatStep(bootSteps, &bootReport, i, line);
+    UART_TransmitString(line);
+  }
+  BOOT_FormatSummary(&bootReport, line);
+  UART_TransmitString(line);
+}
+
+/**
+ * @brief Sensor task: read baro and IMU, fuse, advance the flight state
+ *        machine and log. On the pad it runs at PRETRIG_PERIOD_MS to fill
+ *        the pre-trigger ring, in flight at the profile log period.
+ */
+static void TaskSample(void) {
+  static uint32_t lastUs = TIM_GetMicros();   ///< Previous sample time
+  static uint32_t logMs = TIM_GetMillis();    ///< Last text log time
+
+  uint32_t us = TIM_GetMicros();
+  uint32_t dtUs = us - lastUs;
+  lastUs = us;
+  uint32_t ms = TIM_GetMillis();   ///< Flight-phase timing stays in ms
+
+  // A sensor that gave nothing leaves its last baro reading, or zero IMU
+  // fields and 1 g at rest for the filter and the state machine
+  uint8_t baroOk = 0, imuOk = 0;
+  PROF_BEGIN(PROF_BMP_READ);
+  if (SensorReady(DEV_BARO, ms)) {
+    baroOk = BMP280_ReadData(&bmp) == BMP280_OK;  ///< Read BMP280 sensor data
+    SensorReport(DEV_BARO, baroOk, ms);
+  }
+  PROF_END(PROF_BMP_READ);
+
+  int16_t rawAccel[3], rawGyro[3];
+  float accel[3] = { 0.0f, 0.0f, 1.0f };
+  PROF_BEGIN(PROF_IMU_READ);
+  if (SensorReady(DEV_IMU, ms)) {
+    imuOk = LSM6DS3_ReadRaw(&lsm, rawAccel, rawGyro); ///< Read IMU data
+    SensorReport(DEV_IMU, imuOk, ms);
+  }
+  PROF_END(PROF_IMU_READ);
+  for (uint8_t i = 0; i < 3; i++) {
+    if (!imuOk)
+      rawAccel[i] = rawGyro[i] = 0;
+    else
+      accel[i] = rawAccel[i] * lsm.accelScale;
+  }
+
+  // Translate latched IMU embedded-function flags into flight events
+  uint8_t src = 0, events = 0;
+  if (imuOk)
+    LSM6DS3_ReadEvents(&lsm, &src);
+  if (src & LSM6DS3_WU_SRC_WU_IA) events |= FLIGHT_EVT_WAKEUP;
+  if (src & LSM6DS3_WU_SRC_FF_IA) events |= FLIGHT_EVT_FREEFALL;
+
+  // Z axis is the vertical (rocket) axis; remove 1 g and fuse with baro
+  PROF_BEGIN(PROF_FUSION);
+  KF_Predict(&kf, (int32_t)((accel[2] - 1.0f) * 980.665f), dtUs);
+  if (baroOk)
+    KF_Correct(&kf, bmp.altitude, dtUs);
+  // A baro missing since boot gets its reference on the pad once it has
+  // proven itself; until then altitude runs on the stored one, if any
+  if (baroOk && !baroZeroLive && flight.phase == FLIGHT_IDLE &&
+      health[DEV_BARO].state == HEALTH_OK) {
+    bmp.zeroLvlPress = bmp.pressure;
+    baroZeroLive = 1;
+  }
+  PROF_END(PROF_FUSION);
+
+  float accelMagSq = accel[0] * accel[0] + accel[1] * accel[1] + accel[2] * accel[2];
+  uint8_t phaseChanged = FLIGHT_Update(&flight, ms, KF_GetAltitude(&kf), KF_GetVelocity(&kf), accelMagSq, events);
+  if (phaseChanged) {
+    if (flight.phase == FLIGHT_IDLE)
+      RearmPad();
+    LogEvent(us);
+    // Launch: emit the buffered pad history before the first live line
+    if (flight.phase == FLIGHT_BOOST)
+      PRETRIG_Flush(&pretrig, LogPretrigSample);
+    ApplyFlightProfile();
+  }
+  // Pushed after the update: the sample that triggers launch is logged
+  // live, not flushed a second time from the ring
+  if (flight.phase == FLIGHT_IDLE)
+    PRETRIG_Push(&pretrig, us, bmp.pressure, rawAccel, rawGyro);
+
+  // Binary output keeps up with every sample, text is throttled on the pad
+  if (outputBinary || flight.phase != FLIGHT_IDLE || ms - logMs >= profile.logPeriodMs) {
+    logMs = ms;
+    PROF_BEGIN(PROF_LOG_SAMPLE);
+    LogSample(us, rawAccel, rawGyro);
+    PROF_END(PROF_LOG_SAMPLE);
+  }
+
+  // The card lagged and the queue dropped records since the last report
+  static uint16_t dropsLogged;
+  uint16_t drops = logq.dropped[0] + logq.dropped[1] + logq.dropped[2];
+  if (drops != dropsLogged) {
+    dropsLogged = drops;
+    LogDrops(us);
+  }
+
+  // Time to first sample: the pre-trigger ring and the filter are live
+  if (!bootReport.firstSampleMs) {
+    bootReport.firstSampleMs = (uint16_t)(ms - bootStartMs);
+    LogBoot();
+  }
+
+  // Warm-restart snapshot: RAM every sample, EEPROM on phase changes and
+  // every FDR_CHECKPOINT_BLOCKS log blocks, nothing left to resume once landed
+  static uint32_t checkpointSeq;
+  restartState.phase = flight.phase;
+  restartState.timeMs = ms;
+  restartState.phaseStartMs = flight.phaseStartMs;
+  restartState.maxAltitude = flight.maxAltitude;
+  restartState.baroRef = bmp.zeroLvlPress;
+  restartState.frameSeq = FRAME_GetSequence();
+  restartState.logPos = sd.lba;    ///< An open block is lost with the reset
+  restartState.logEnd = sd.streaming ? sd.endLba : 0;
+  restartState.logSeq = logblk.seq;
+  if (phaseChanged && flight.phase == FLIGHT_LANDED) {
+    RESTART_Clear();
+  } else if (phaseChanged || logblk.seq - checkpointSeq >= FDR_CHECKPOINT_BLOCKS) {
+    checkpointSeq = logblk.seq;
+    RESTART_Checkpoint(&restartState);
+  } else {
+    RESTART_Update(&restartState);
+  }
+  RESTART_Service();
+}
+
+/**
+ * @brief Vibration task: the IMU FIFO samples at the exact ODR while this
+ *        task drains a few samples per run, so no acquisition is delayed.
+ */
+static void TaskVibration(void) {
+  static uint32_t fftMs = TIM_GetMillis();
+  // The sample task re-probes a failed IMU; a window it broke is abandoned
+  if (health[DEV_IMU].state == HEALTH_FAILED) {
+    fftActive = 0;
+    return;
+  }
+  if (!fftActive && TIM_GetMillis() - fftMs >= FFT_PERIOD_MS) {
+    fftMs = TIM_GetMillis();
+    FFT_Reset(&fft);
+    vib.sampleRate = LSM6DS3_ODRToHz(lsm.accelODR);
+    fftActive = LSM6DS3_FifoStart(&lsm, lsm.accelODR);
+  }
+  if (!fftActive)
+    return;
+
+  uint16_t avail = 0;
+  int16_t a[3];
+  LSM6DS3_FifoLevel(&lsm, &avail);
+  if (avail > FFT_DRAIN_CHUNK)
+    avail = FFT_DRAIN_CHUNK;
+  while (fftActive && avail-- && LSM6DS3_FifoReadAccel(&lsm, a)) {
+    if (FFT_Push(&fft, a[2])) {
+      LSM6DS3_FifoStop(&lsm);
+      fftActive = 0;
+
+      uint32_t t0 = TIM_GetMicros();
+      PROF_BEGIN(PROF_FFT);
+      FFT_Process(&fft, &vib);
+      PROF_END(PROF_FFT);
+      vib.processUs = (uint16_t)(TIM_GetMicros() - t0);
+
+      LogVib(TIM_GetMicros());
+    }
+  }
+}
+
+/**
+ * @brief Console task; commands (calibration) are only accepted on the pad,
+ *        after landing only the log offload and the re-arm. Also logs a bus trace frozen
+ *        by an error.
+ */
+static void TaskConsole(void) {
+  if ((flight.phase == FLIGHT_IDLE || flight.phase == FLIGHT_LANDED) && UART_Available()) {
+    char cmd = (char)UART_Receive();
+    if (flight.phase == FLIGHT_IDLE || cmd == 'o' || cmd == 'a')
+      HandleCommand(cmd);
+  }
+
+#if BUSTRACE_ENABLE
+  // A bus error froze the trace: put it into the log, in any phase
+  static uint32_t traceMs;
+  if (BUSTRACE_IsFrozen() && TIM_GetMillis() - traceMs >= BUSTRACE_REARM_MS) {
+    traceMs = TIM_GetMillis();
+    DumpBusTrace();
+  }
+#endif
+}
+
+/**
+ * @brief Telemetry task: compact state over LoRa at the phase rate.
+ */
+static void TaskTelemetry(void) {
+  telemetry.pressure = bmp.pressure;
+  telemetry.altitude = (int16_t)(KF_GetAltitude(&kf) / 100);
+  telemetry.velocity = (int16_t)(KF_GetVelocity(&kf) / 10);
+  telemetry.phase = flight.phase;
+  telemetry.vibPeak = vib.peakBin;
+  for (uint8_t b = 0; b < FFT_BANDS; b++)
+    telemetry.vib[b] = vib.band[b];
+  StoragePause();      ///< The card holds the bus while a block is open
+  PROF_BEGIN(PROF_LORA_TX);
+  LoRa_Transmit(&lora, &telemetry, sizeof(telemetry)); ///< Transmit compact state over LoRa
+  PROF_END(PROF_LORA_TX);
+}
+
+/**
+ * @brief LED task: advance the status pattern.
+ */
+static void TaskLed(void) {
+  LED_Update(TIM_GetMillis());
+}
+
+/**
+ * @brief Power task: read the battery, update charge and level, re-apply
+ *        the profile when the level changes and log the measurement.
+ */
+static void TaskPower(void) {
+  uint32_t ms = TIM_GetMillis();
+  if (!SensorReady(DEV_POWER, ms))
+    return;
+  uint8_t ok = INA226_Read(&ina) == INA226_OK;
+  SensorReport(DEV_POWER, ok, ms);
+  if (!ok || !ina.busMv)
+    return;
+  // The charge starts from the first reading (after boot, a warm restart or
+  // a monitor found late); a load-induced dip only means a pessimistic
+  // estimate until coulomb counting takes over
+  if (!powerStarted) {
+    POWER_Init(&power, ina.busMv, ms);
+    powerStarted = 1;
+  }
+  uint8_t alert = INA226_ReadAlert(&ina);
+  if (POWER_Update(&power, ina.busMv, ina.currentMa, alert, ms))
+    ApplyFlightProfile();
+  LogPower(TIM_GetMicros(), alert);
+}
+
+static const char taskNameSample[] PROGMEM = "sample";
+static const char taskNameVib[] PROGMEM = "vib";
+static const char taskNameConsole[] PROGMEM = "console";
+static const char taskNameTelemetry[] PROGMEM = "lora";
+static const char taskNameLed[] PROGMEM = "led";
+static const char taskNamePower[] PROGMEM = "power";
+
+// Task table, indexed by TaskId; sample and telemetry periods follow the flight profile
+static SCHED_Task tasks[TASK_COUNT] = {
+  SCHED_TASK(taskNameSample,    TaskSample,    PRETRIG_PERIOD_MS * 1000UL, 0,    0),
+  SCHED_TASK(taskNameVib,       TaskVibration, 2000UL,                     500,  1),
+  SCHED_TASK(taskNameConsole,   TaskConsole,   20000UL,                    1000, 2),
+  SCHED_TASK(taskNameTelemetry, TaskTelemetry, 2000000UL,                  1500, 3),
+  SCHED_TASK(taskNameLed,       TaskLed,       LED_TICK_MS * 1000UL,       250,  4),
+  SCHED_TASK(taskNamePower,     TaskPower,     FDR_POWER_PERIOD_MS * 1000UL, 750, 5),
+};
+
+/** @defgroup POST Power-on self-test limits
+ * @{
+ */
+#define POST_PRESS_MIN     30000UL  ///< Plausible pressure range (Pa)
+#define POST_PRESS_MAX     110000UL
+#define POST_TEMP_MIN      -4000    ///< Plausible temperature range (0.01 C)
+#define POST_TEMP_MAX      8500
+#define POST_ACCEL_MIN_MG  700      ///< |a| at rest (mg)
+#define POST_ACCEL_MAX_MG  1300
+#define POST_I2C_MAX_US    2000     ///< 6-byte register read at 100 kHz (~0.9 ms nominal)
+/** @} */
+
+static BITE_Report post;
+
+static uint8_t TestBaroId(uint32_t deadlineUs) {
+  bmpOk = BMP280_Init(&bmp) == BMP280_OK;
+  return bmpOk ? BITE_PASS : BITE_FAIL;
+}
+
+static uint8_t TestImuId(uint32_t deadlineUs) {
+  lsmOk = LSM6DS3_Init(&lsm, LSM6DS3_XL_16G, LSM6DS3_GYRO_2000DPS);
+  return lsmOk ? BITE_PASS : BITE_FAIL;
+}
+
+static uint8_t TestBaroRange(uint32_t deadlineUs) {
+  if (!bmpOk)
+    return BITE_SKIP;
+  // The first conversion after Init takes up to ~40 ms at x16 oversampling
+  do {
+    BMP280_ReadData(&bmp);
+    if (bmp.pressure >= POST_PRESS_MIN && bmp.pressure <= POST_PRESS_MAX &&
+        bmp.temperature >= POST_TEMP_MIN && bmp.temperature <= POST_TEMP_MAX)
+      return BITE_PASS;
+  } while (!BITE_Expired(deadlineUs));
+  return BITE_FAIL;
+}
+
+static uint8_t TestImuRange(uint32_t deadlineUs) {
+  if (!lsmOk)
+    return BITE_SKIP;
+  int16_t a[3], g[3];
+  uint32_t ug = (uint32_t)(lsm.accelScale * 1e6f + 0.5f);
+  do {
+    if (LSM6DS3_ReadRaw(&lsm, a, g)) {
+      int32_t magSq = 0;
+      for (uint8_t i = 0; i < 3; i++) {
+        int32_t mg = (int32_t)a[i] * (int32_t)ug / 1000L;
+        magSq += mg * mg;
+      }
+      if (magSq >= (int32_t)POST_ACCEL_MIN_MG * POST_ACCEL_MIN_MG &&
+          magSq <= (int32_t)POST_ACCEL_MAX_MG * POST_ACCEL_MAX_MG)
+        return BITE_PASS;
+    }
+  } while (!BITE_Expired(deadlineUs));
+  return BITE_FAIL;
+}
+
+static uint8_t TestRadio(uint32_t deadlineUs) {
+  loraOk = LoRa_Probe(&lora);  ///< Configured later by the boot pipeline
+  return loraOk ? BITE_PASS : BITE_FAIL;
+}
+
+static uint8_t TestStorage(uint32_t deadlineUs) {
+  sdOk = SD_Init(&sd) == SD_OK && FAT32_Mount(&shared.boot.vol, &sd, shared.boot.buf) == FAT32_OK;
+  return sdOk ? BITE_PASS : BITE_FAIL;
+}
+
+static uint8_t TestBusTiming(uint32_t deadlineUs) {
+  if (!bmpOk)
+    return BITE_SKIP;
+  uint8_t rx[6];
+  uint32_t t0 = TIM_GetMicros();
+  uint8_t st = IIC_ReadBytes(bmp.i2c.adr, BMP280_REG_PRESS_MSB, rx, sizeof(rx));
+  uint32_t us = TIM_GetMicros() - t0;
+  return st == IIC_SUCCESS && us <= POST_I2C_MAX_US ? BITE_PASS : BITE_FAIL;
+}
+
+/**
+ * @brief Battery monitor: probe and arm the under-voltage alert. The first
+ *        averaged result takes ~140 ms; the power task starts the charge
+ *        estimate from it.
+ */
+static uint8_t TestPower(uint32_t deadlineUs) {
+  inaOk = INA226_Init(&ina) == INA226_OK &&
+          INA226_SetAlert(&ina, INA226_ALERT_BUS_UNDER, FDR_POWER_CRITICAL_MV, 1) == INA226_OK;
+  return inaOk ? BITE_PASS : BITE_FAIL;
+}
+
+static const char postNameBaroId[] PROGMEM = "baro_id";
+static const char postNameImuId[] PROGMEM = "imu_id";
+static const char postNameBaroRange[] PROGMEM = "baro_range";
+static const char postNameImuRange[] PROGMEM = "imu_range";
+static const char postNameRadio[] PROGMEM = "lora";
+static const char postNameStorage[] PROGMEM = "sd";
+static const char postNameBus[] PROGMEM = "i2c_timing";
+static const char postNamePower[] PROGMEM = "power";
+
+// POST table; codes match the README table
+#define POST_CODE_SD 6
+static const BITE_Test postTests[] PROGMEM = {
+  { TestBaroId,    postNameBaroId,    10,  1, 0 },
+  { TestImuId,     postNameImuId,     10,  2, 0 },
+  { TestBaroRange, postNameBaroRange, 100, 3, 0 },
+  { TestImuRange,  postNameImuRange,  50,  4, 0 },
+  { TestRadio,     postNameRadio,     10,  5, 0 },
+  { TestStorage,   postNameStorage,   500, POST_CODE_SD, 0 },
+  { TestBusTiming, postNameBus,       5,   7, 0 },
+  { TestPower,     postNamePower,     10,  8, 0 },
+};
+#define POST_TEST_COUNT (sizeof(postTests) / sizeof(postTests[0]))
+
+/**
+ * @brief Log the POST results and start the matching LED / buzzer code.
+ *        OK: one green pulse. Non-fatal: yellow code shown three times.
+ *        Fatal: red code repeated forever.
+ */
+static void ReportPost(void) {
+  if (outputBinary) {
+    FRAME_Send(FRAME_TYPE_POST, &post, sizeof(post));
+  } else {
+    char line[48];
+    for (uint8_t i = 0; i < post.count; i++) {
+      BITE_FormatTest(postTests, &post, i, line);
+      UART_TransmitString(line);
+    }
+    BITE_FormatSummary(&post, line);
+    UART_TransmitString(line);
+  }
+
+  if (!post.code)
+    LED_PlayCode(0, 255, 0, 1, 1);
+  else if (!post.fatal)
+    LED_PlayCode(255, 160, 0, post.code, 3);
+  else
+    LED_PlayCode(255, 0, 0, post.code, 0);
+}
+
+/**
+ * @brief Log the SD log file and the boot write benchmark. The POST report
+ *        went out before the stream started, so a copy is stored here.
+ */
+static void LogStorage(void) {
+  FRAME_Log(FRAME_TYPE_POST, &post, sizeof(post), 0);
+  FRAME_Log(FRAME_TYPE_STORAGE, &storage, sizeof(storage), outputBinary);
+  if (outputBinary)
+    return;
+  char line[64];
+  char *p = FMT_StrP(line, PSTR("SD:\t"));
+  p = FMT_UInt(p, storage.status);
+  *p++ = '\t';
+  p = FMT_UInt(p, storage.firstLba);
+  *p++ = '\t';
+  p = FMT_UInt(p, storage.sectors);
+  *p++ = '\t';
+  p = FMT_UInt(p, storage.benchKBps);
+  p = FMT_StrP(p, PSTR("KB/s\t"));
+  p = FMT_UInt(p, storage.maxBusyUs);
+  p = FMT_StrP(p, PSTR("us"));
+  FMT_End(p);
+  UART_TransmitString(line);
+}
+
+/**
+ * @brief The card passed POST but got no log file (card or root directory
+ *        full, allocation over budget): fail its test after the fact and
+ *        repeat the report, so the recorder does not fly without a log
+ *        unnoticed.
+ */
+static void ReportStorageFailure(void) {
+  for (uint8_t i = 0; i < post.count; i++) {
+    if (pgm_read_byte(&postTests[i].code) != POST_CODE_SD || post.result[i] == BITE_FAIL)
+      continue;
+    post.result[i] = BITE_FAIL;
+    if (!post.code)
+      post.code = POST_CODE_SD;
+    PrintStatus(PSTR("SD log file..."), storage.status);
+    ReportPost();
+  }
+}
+
+/**
+ * @brief Full boot: POST, calibration and the overlapped settle pipeline.
+ */
+static void BootCold(void) {
+  restartState.bootId = RESTART_NewBoot();
+
+  // Self-test initializes the sensors and radio; a missing sensor only
+  // degrades the recorder, it keeps logging whatever works
+  BITE_Run(postTests, POST_TEST_COUNT, &post);
+  ReportPost();
+
+  // Stored IMU calibration; the baro is settled and zeroed live below
+  CALIB_Status calStatus = CALIB_Load(&calib);
+  PrintStatus(PSTR("CAL Load..."), calStatus);
+  if (calStatus != CALIB_OK)
+    calib.baroRef = 0;
+
+  // Baro settling, IMU turn-on, radio setup and log preallocation overlap
+  BOOT_Run(bootSteps, BOOT_STEP_COUNT, &bootReport);
+  if (sdOk && !sd.streaming)
+    sdOk = 0;                         ///< Allocation ran out of budget
+  if (!sdOk)
+    ReportStorageFailure();
+
+  // The settled live pressure is the altitude zero: the weather moves the
+  // stored pad pressure by several hPa (~8 m each) between sessions. The
+  // stored value is a plausibility check, and the fallback while the baro
+  // cannot be read
+  baroZeroLive = bmpOk && bmp.pressure;
+  if (baroZeroLive) {
+    bmp.zeroLvlPress = bmp.pressure;  ///< Settled baseline pressure
+    if (CALIB_CheckBaro(&calib, bmp.pressure) == CALIB_RANGE_ERROR)
+      PrintStatus(PSTR("CAL Baro ref..."), CALIB_RANGE_ERROR);
+  }
+  CALIB_Apply(&calib, &lsm, &bmp);
+  BMP280_ReadData(&bmp);              ///< Altitude against the reference
+
+  FLIGHT_Init(&flight, TIM_GetMillis());
+  KF_Init(&kf, 1.0f, bmp.altitude);
+}
+
+/**
+ * @brief Skip the log blocks written after the snapshot: this boot's blocks
+ *        from the snapshot sequence on. Needed after an EEPROM resume, whose
+ *        position can be FDR_CHECKPOINT_BLOCKS behind.
+ * @param[in,out] seq Sequence number at the snapshot, of the first free block on return
+ * @return First free block
+ */
+static uint32_t ResumeLogScan(uint32_t *seq) {
+  uint32_t lba = restartState.logPos;
+  LOGBLK_Header hdr;
+
+  for (uint16_t n = 0; n < FDR_RESUME_SCAN_BLOCKS && lba < restartState.logEnd; n++) {
+    if (SD_ReadBegin(&sd, lba) != SD_OK)
+      break;
+    for (uint16_t i = 0; i < SD_BLOCK_SIZE; i++) {
+      uint8_t b = SD_ReadByte(&sd);
+      if (i < sizeof(hdr))
+        ((uint8_t *)&hdr)[i] = b;
+    }
+    SD_ReadEnd(&sd);
+    if (hdr.magic != LOGBLK_MAGIC || hdr.boot != restartState.bootId ||
+        hdr.seq < restartState.logSeq)
+      break;
+    lba++;
+    *seq = hdr.seq + 1;
+  }
+  return lba;
+}
+
+/**
+ * @brief Warm restart: re-initialize the peripherals without POST or
+ *        settling and restore the flight state. The sensors kept running
+ *        through the MCU reset, so their output registers are current.
+ */
+static void ResumeWarm(void) {
+  TIM_SetMillis(restartState.timeMs);
+  bootStartMs = restartState.timeMs;
+  FRAME_SetSequence(restartState.frameSeq);
+
+  bmpOk = BMP280_Init(&bmp) == BMP280_OK;
+  lsmOk = LSM6DS3_Init(&lsm, LSM6DS3_XL_16G, LSM6DS3_GYRO_2000DPS);
+  loraOk = LoRa_Init(&lora);
+  inaOk = INA226_Init(&ina) == INA226_OK &&
+          INA226_SetAlert(&ina, INA226_ALERT_BUS_UNDER, FDR_POWER_CRITICAL_MV, 1) == INA226_OK;
+  // Continue the log stream behind the last block written before the reset
+  uint32_t seq = restartState.logSeq;
+  sdOk = restartState.logEnd && SD_Init(&sd) == SD_OK &&
+         SD_StreamStart(&sd, ResumeLogScan(&seq), restartState.logEnd) == SD_OK;
+  if (sdOk) {
+    LOGBLK_Init(&logblk, &sd, restartState.bootId, FDR_LOG_SCHEMA, seq);
+    FRAME_SetStore(StoreFrame);
+  }
+  if (lsmOk)
+    ArmImuEvents();
+
+  if (CALIB_Load(&calib) != CALIB_OK)
+    calib.baroRef = 0;
+  CALIB_Apply(&calib, &lsm, &bmp);
+  bmp.zeroLvlPress = restartState.baroRef;   ///< Never re-zero in the air
+  baroZeroLive = bmp.zeroLvlPress != 0;
+  BMP280_ReadData(&bmp);
+
+  FLIGHT_Init(&flight, restartState.phaseStartMs);
+  flight.phase = (FLIGHT_Phase)restartState.phase;
+  flight.maxAltitude = restartState.maxAltitude;
+  KF_Init(&kf, 1.0f, bmp.altitude);
+}
 
 /**
  * @brief Main application entry point.
@@ -66,8 +1861,9 @@ int main(void) {
   TIM_InitMillis();       ///< Initialize millisecond timer
   IIC_Init();             ///< Initialize I2C interface
   RGB_INIT();             ///< Initialize RGB LED
-  UART_Init(115200);      ///< Initialize UART at 115200 baud
-  UART_EnablePrintf();    ///< Enable printf over UART
+  uint8_t uartStatus = UART_Init(FDR_UART_BAUD); ///< Initialize UART (U2X picked if closer)
+  PrintStatus(PSTR("UART Init..."), uartStatus);
+  PrintStatus(PSTR("UART Baud error (0.01 %)..."), UART_GetBaudError());
 
   SPI_Init(&spiHandle);   ///< Initialize SPI hardware
   DDRB |= (1 << PB0);     ///< Set NSS (PB0) as output
@@ -77,7 +1873,13 @@ int main(void) {
   lora.nssPort = &PORTB;               ///< NSS port for LoRa
   lora.nssPin = PB0;                   ///< NSS pin for LoRa (PB0)
   lora.config = loraCfg;               ///< Set LoRa configuration
-  printf("LoRa Init... %d\n", LoRa_Init(&lora)); ///< Print initialization message
+
+  DDRB |= (1 << PB2);                  ///< SD card CS (PB2 / D10)
+  PORTB |= (1 << PB2);
+  sd.spi = &spiHandle;
+  sd.csPort = &PORTB;
+  sd.csPin = PB2;
+  sd.clockDiv = SPI_CLOCK_DIV2;        ///< 8 MHz once initialized
 
   // BMP280 sensor configuration
   bmp.i2c.adr = 0x76;                         ///< I2C address for BMP280
@@ -91,58 +1893,61 @@ int main(void) {
   lsm.accelODR = LSM6DS3_ODR_1660HZ;          ///< Accelerometer ODR 1660Hz
   lsm.gyroODR = LSM6DS3_ODR_1660HZ;           ///< Gyroscope ODR 1660Hz
 
-  // Initialize sensors and indicate error with blinking red LED if failed
-  if (BMP280_Init(&bmp) != BMP280_OK ||
-    !LSM6DS3_Init(&lsm, LSM6DS3_XL_16G, LSM6DS3_GYRO_2000DPS)) {
-    while (1) {
-      RGB_SET_COLOR(COLOR_RED);   ///< Set LED to red
-      _delay_ms(250);
-      RGB_SET_COLOR(COLOR_OFF);   ///< Turn off LED
-      _delay_ms(250);
-    }
-  }
-
-  // Discard first 100 BMP280 readings for sensor stabilization
-  for (uint8_t i = 0; i < 100; i++) {
-    BMP280_ReadData(&bmp);
-  }
-  bmp.zeroLvlPress = bmp.pressure;    ///< Store baseline pressure
-
-  uint16_t hue = 0;                   ///< Current hue for RGB LED
-  const float hueStep = 1;            ///< Hue increment step
-  uint8_t r, g, b;                    ///< RGB color values
+  // INA226 battery monitor configuration
+  ina.addr = FDR_INA226_ADDR;                 ///< I2C address for INA226
+  ina.shuntMilliOhm = FDR_SHUNT_MOHM;
+  ina.currentLsbUa = FDR_CURRENT_LSB_UA;
+  ina.averaging = INA226_AVG_64;              ///< 64 x (1.1 + 1.1 ms) = ~140 ms per result
+  ina.busCT = INA226_CT_1100US;
+  ina.shuntCT = INA226_CT_1100US;
+  power.capacityMah = FDR_BATTERY_MAH;
+  power.saveMv = FDR_POWER_SAVE_MV;
+  power.criticalMv = FDR_POWER_CRITICAL_MV;
 
-  // Main loop: read sensors, print data, and animate RGB LED
-  while (1) {
-    static uint32_t ms = TIM_GetMillis();    ///< Last sensor read time
-    static uint32_t ledMs = TIM_GetMillis(); ///< Last LED update time
+  LOGQ_Init(&logq);
+#if FDR_LOG_COMPRESS
+  RICE_Init(&sampleRice, sampleChannels, sizeof(sampleChannels) / sizeof(sampleChannels[0]),
+            sizeof(SampleRecord));
+#endif
 
-    // Sensor read and UART print every 50 ms
-    if (TIM_GetMillis() - ms >= 50) {
-      ms = TIM_GetMillis();
+  // After a watchdog / brown-out reset continue the interrupted log
+  restartSource = RESTART_Load(&restartState);
+  if (restartSource != RESTART_COLD) {
+    ResumeWarm();
+  } else {
+    BootCold();
+  }
 
-      BMP280_ReadData(&bmp);    ///< Read BMP280 sensor data
+  // Sensors missing now are re-probed in flight
+  HEALTH_Init(&health[DEV_BARO], bmpOk, TIM_GetMillis());
+  HEALTH_Init(&health[DEV_IMU], lsmOk, TIM_GetMillis());
+  HEALTH_Init(&health[DEV_POWER], inaOk, TIM_GetMillis());
 
-      float accel[3], gyro[3];
-      LSM6DS3_ReadData(&lsm, accel, gyro); ///< Read IMU data
+  PRETRIG_Init(&pretrig);
+  SCHED_Init(tasks, TASK_COUNT);
+  ApplyFlightProfile();
+  LogInfo();
+  LogHealth(TIM_GetMicros());
+  if (restartSource != RESTART_COLD)
+    LogGap();
+  else if (sdOk)
+    LogStorage();
+#if FDR_FMT_BENCH
+  UART_EnablePrintf();
+  BenchFormat();
+#endif
 
-      printf("T:\t%ld.%02ldC\tP:\t%luPa\tAlt:\t%ldcm\tAx:\t%d.%02d\tAy:\t%d.%02d\tAz:\t%d.%02d\tGx:\t%d.%02d\tGy:\t%d.%02d\tGz:\t%d.%02d\n",
-        bmp.temperature / 100, abs(bmp.temperature % 100),
-        bmp.pressure, bmp.altitude,
-        PRINT_FLOAT(accel[0]), PRINT_FLOAT(accel[1]), PRINT_FLOAT(accel[2]),
-        PRINT_FLOAT(gyro[0]), PRINT_FLOAT(gyro[1]), PRINT_FLOAT(gyro[2])
-      );
-      LoRa_Transmit(&lora, &bmp.pressure, sizeof(bmp.pressure)); ///< Transmit pressure data over LoRa
-    }
+  // Boot work above is not part of the task budget
+  SCHED_ResetStats();
+  wdt_enable(FDR_WDT_TIMEOUT);
 
-    // RGB LED color animation update every 2 ms
-    if (TIM_GetMillis() - ledMs >= 2) {
-      ledMs = TIM_GetMillis();
-      hsv_to_rgb(hue, 255, 255, &r, &g, &b); ///< Convert HSV to RGB
-      RGB_SET(r, g, b);                       ///< Set RGB LED color
-      hue += hueStep;
-      if (hue >= 360)
-        hue = 0;
-    }
+  // Main loop: everything periodic runs from the task table, the log
+  // queue drains into the card in between. The CPU sleeps only with the
+  // queue empty: while the card is busy it is polled, so the queue moves
+  // the moment the card can take it rather than a tick later
+  while (1) {
+    wdt_reset();
+    if (!SCHED_Run() && !StorageDrain() && !(sdOk && LOGQ_Used(&logq)))
+      SCHED_Idle();
   }
 }
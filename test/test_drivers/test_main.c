@@ -0,0 +1,284 @@
+/**
+ * @file test_main.c
+ * @brief Driver tests against the host bus models of lib/hal
+ * @author Nate Hunter
+ * @date 2025-08-20
+ * @version v1.0.0
+ *
+ * The BMP280 and LSM6DS3 are register files on the TWI bus, the BMP280
+ * loaded with the datasheet calibration example; the LoRa radio answers the
+ * version register on SPI.
+ */
+
+#include <string.h>
+#include <unity.h>
+#include "hal.h"
+#include "twi.h"
+#include "bmp280.h"
+#include "lsm6ds3.h"
+#include "health.h"
+#include "spi_driver.h"
+#include "lora.h"
+
+#define TEST_BMP280_ADDR  0x76
+#define TEST_BMP280_ID    0x58
+#define TEST_LSM6DS3_ADDR 0x6A
+#define TEST_LORA_VERSION 0x12
+#define TEST_LORA_NSS     PB0
+
+/** @brief Register-file I2C target: first byte sets the pointer, then auto-increment */
+typedef struct {
+  uint8_t regs[256];
+  uint8_t ptr;
+} TestChip;
+
+/** @brief SPI radio: address byte, then the register contents */
+typedef struct {
+  uint8_t regs[128];
+  uint8_t addr;
+  uint8_t count;      ///< Bytes since chip select
+} TestRadio;
+
+static TestChip bmpChip;
+static TestChip imuChip;
+static TestRadio radio;
+
+static uint8_t TestChipWrite(void *ctx, uint8_t data, uint8_t first)
+{
+  TestChip *chip = (TestChip *)ctx;
+  if (first)
+    chip->ptr = data;
+  else
+    chip->regs[chip->ptr++] = data;
+  return 1;
+}
+
+static uint8_t TestChipRead(void *ctx)
+{
+  TestChip *chip = (TestChip *)ctx;
+  return chip->regs[chip->ptr++];
+}
+
+static uint8_t TestRadioExchange(void *ctx, uint8_t mosi)
+{
+  TestRadio *r = (TestRadio *)ctx;
+  if (PORTB & (1 << TEST_LORA_NSS))
+    return 0xFF;
+  if (!r->count++) {
+    r->addr = mosi & 0x7F;
+    return 0;
+  }
+  return r->regs[r->addr];
+}
+
+static const HAL_TwiDevice twiBus[] = {
+  { TEST_BMP280_ADDR, TestChipWrite, TestChipRead, &bmpChip },
+  { TEST_LSM6DS3_ADDR, TestChipWrite, TestChipRead, &imuChip }
+};
+
+/** @brief Datasheet section 3.12 example: 25.08 degC, 100653 Pa */
+static void TestLoadBmp280(void)
+{
+  static const uint16_t calib[12] = {
+    27504, 26435, (uint16_t)-1000, 36477, (uint16_t)-10685, 3024,
+    2855, 140, (uint16_t)-7, 15500, (uint16_t)-14600, 6000
+  };
+  const uint32_t adcP = 415148, adcT = 519888;
+
+  memset(&bmpChip, 0, sizeof(bmpChip));
+  bmpChip.regs[0xD0] = TEST_BMP280_ID;
+  for (uint8_t i = 0; i < 12; i++) {
+    bmpChip.regs[0x88 + 2 * i] = (uint8_t)calib[i];
+    bmpChip.regs[0x89 + 2 * i] = (uint8_t)(calib[i] >> 8);
+  }
+  bmpChip.regs[0xF7] = (uint8_t)(adcP >> 12);
+  bmpChip.regs[0xF8] = (uint8_t)(adcP >> 4);
+  bmpChip.regs[0xF9] = (uint8_t)((adcP & 0x0F) << 4);
+  bmpChip.regs[0xFA] = (uint8_t)(adcT >> 12);
+  bmpChip.regs[0xFB] = (uint8_t)(adcT >> 4);
+  bmpChip.regs[0xFC] = (uint8_t)((adcT & 0x0F) << 4);
+}
+
+static void TestBmpHandle(BMP280_HandleTypeDef *bmp)
+{
+  memset(bmp, 0, sizeof(*bmp));
+  bmp->i2c.adr = TEST_BMP280_ADDR;
+  bmp->i2c.id = TEST_BMP280_ID;
+  bmp->config.mode = BMP280_MODE_NORMAL;
+}
+
+static void TestImuHandle(LSM6DS3_Handle *imu)
+{
+  memset(imu, 0, sizeof(*imu));
+  imu->i2c_addr = TEST_LSM6DS3_ADDR;
+  imu->accelODR = LSM6DS3_ODR_104HZ;
+  imu->gyroODR = LSM6DS3_ODR_104HZ;
+}
+
+void setUp(void)
+{
+  HAL_HostReset();
+  TestLoadBmp280();
+  memset(&imuChip, 0, sizeof(imuChip));
+  imuChip.regs[LSM6DS3_REG_WHO_AM_I] = LSM6DS3_WHO_AM_I;
+  HAL_HostTwiAttach(twiBus, 2);
+  IIC_Init();
+
+  memset(&radio, 0, sizeof(radio));
+  radio.regs[0x42] = TEST_LORA_VERSION;
+  HAL_HostSpiAttach(TestRadioExchange, &radio);
+  DDRB |= 1 << TEST_LORA_NSS;
+  PORTB |= 1 << TEST_LORA_NSS;
+}
+
+void tearDown(void)
+{
+}
+
+static void test_bmp280_init_configures_normal_mode(void)
+{
+  BMP280_HandleTypeDef bmp;
+  TestBmpHandle(&bmp);
+  TEST_ASSERT_EQUAL(BMP280_OK, BMP280_Init(&bmp));
+  TEST_ASSERT_EQUAL_HEX8(BMP280_MODE_NORMAL, bmpChip.regs[0xF4] & 0x03);
+}
+
+static void test_bmp280_reads_datasheet_example(void)
+{
+  BMP280_HandleTypeDef bmp;
+  TestBmpHandle(&bmp);
+  TEST_ASSERT_EQUAL(BMP280_OK, BMP280_Init(&bmp));
+  bmp.zeroLvlPress = 101325;
+  TEST_ASSERT_EQUAL(BMP280_OK, BMP280_ReadData(&bmp));
+  TEST_ASSERT_EQUAL_INT32(2508, bmp.temperature);
+  TEST_ASSERT_UINT32_WITHIN(5, 100653, bmp.pressure);
+  // 672 Pa below the zero level is about 56 m
+  TEST_ASSERT_INT32_WITHIN(100, 5600, bmp.altitude);
+}
+
+static void test_bmp280_wrong_id_fails_init(void)
+{
+  BMP280_HandleTypeDef bmp;
+  TestBmpHandle(&bmp);
+  bmpChip.regs[0xD0] = 0x60;     // BME280
+  TEST_ASSERT_EQUAL(BMP280_ERROR, BMP280_Init(&bmp));
+}
+
+static void test_bmp280_absent_fails_init(void)
+{
+  BMP280_HandleTypeDef bmp;
+  TestBmpHandle(&bmp);
+  HAL_HostTwiAttach(twiBus, 0);
+  uint8_t id = 0;
+  TEST_ASSERT_EQUAL(IIC_ERROR, IIC_ReadByte(TEST_BMP280_ADDR, 0xD0, &id));
+  TEST_ASSERT_EQUAL(IIC_ERROR, IIC_WriteByte(TEST_BMP280_ADDR, 0xF4, 0));
+  TEST_ASSERT_EQUAL(BMP280_ERROR, BMP280_Init(&bmp));
+}
+
+static void test_bmp280_detached_keeps_readings(void)
+{
+  BMP280_HandleTypeDef bmp;
+  TestBmpHandle(&bmp);
+  TEST_ASSERT_EQUAL(BMP280_OK, BMP280_Init(&bmp));
+  bmp.zeroLvlPress = 101325;
+  TEST_ASSERT_EQUAL(BMP280_OK, BMP280_ReadData(&bmp));
+  const int32_t temperature = bmp.temperature, altitude = bmp.altitude;
+  const uint32_t pressure = bmp.pressure;
+
+  HAL_HostTwiAttach(twiBus, 0);
+  uint8_t id = 0;
+  TEST_ASSERT_EQUAL(IIC_ERROR, IIC_ReadByte(TEST_BMP280_ADDR, 0xD0, &id));
+  TEST_ASSERT_EQUAL(BMP280_ERROR, BMP280_ReadData(&bmp));
+  TEST_ASSERT_EQUAL_INT32(temperature, bmp.temperature);
+  TEST_ASSERT_EQUAL_UINT32(pressure, bmp.pressure);
+  TEST_ASSERT_EQUAL_INT32(altitude, bmp.altitude);
+
+  // Plugged back in, it reads again without a new init
+  HAL_HostTwiAttach(twiBus, 2);
+  TEST_ASSERT_EQUAL(BMP280_OK, BMP280_ReadData(&bmp));
+}
+
+static void test_twi_stalled_bus_times_out(void)
+{
+  BMP280_HandleTypeDef bmp;
+  TestBmpHandle(&bmp);
+  TEST_ASSERT_EQUAL(BMP280_OK, BMP280_Init(&bmp));
+  HAL_HostTwiStall(1);
+  uint8_t id = 0;
+  TEST_ASSERT_EQUAL(IIC_TIMEOUT, IIC_ReadByte(TEST_BMP280_ADDR, 0xD0, &id));
+  TEST_ASSERT_EQUAL(BMP280_ERROR, BMP280_ReadData(&bmp));
+  HAL_HostTwiStall(0);
+  TEST_ASSERT_EQUAL(BMP280_OK, BMP280_ReadData(&bmp));
+}
+
+static void test_detached_sensors_fail_health(void)
+{
+  BMP280_HandleTypeDef bmp;
+  LSM6DS3_Handle imu;
+  HEALTH_Device baroHealth, imuHealth;
+  float accel[3], gyro[3];
+  uint32_t ms = 0;
+
+  TestBmpHandle(&bmp);
+  TestImuHandle(&imu);
+  TEST_ASSERT_EQUAL(BMP280_OK, BMP280_Init(&bmp));
+  TEST_ASSERT_TRUE(LSM6DS3_Init(&imu, LSM6DS3_XL_16G, LSM6DS3_GYRO_2000DPS));
+  HEALTH_Init(&baroHealth, 1, ms);
+  HEALTH_Init(&imuHealth, 1, ms);
+
+  // Both chips come off the bus: every address byte is NACKed
+  HAL_HostTwiAttach(twiBus, 0);
+  for (uint8_t i = 0; i < HEALTH_FAIL_ERRORS; i++, ms += 10) {
+    HEALTH_Report(&baroHealth, BMP280_ReadData(&bmp) == BMP280_OK, ms);
+    HEALTH_Report(&imuHealth, LSM6DS3_ReadData(&imu, accel, gyro), ms);
+    if (!i) {
+      TEST_ASSERT_EQUAL(HEALTH_DEGRADED, baroHealth.state);
+      TEST_ASSERT_EQUAL(HEALTH_DEGRADED, imuHealth.state);
+    }
+  }
+  TEST_ASSERT_EQUAL(HEALTH_FAILED, baroHealth.state);
+  TEST_ASSERT_EQUAL(HEALTH_FAILED, imuHealth.state);
+}
+
+static void test_lora_probe_reads_version(void)
+{
+  SPI_HandleTypeDef spi = { { SPI_MODE0, SPI_CLOCK_DIV16, 0 } };
+  LoRa_Handle_t lora;
+  memset(&lora, 0, sizeof(lora));
+  lora.spiHandle = &spi;
+  lora.nssPort = &PORTB;
+  lora.nssPin = TEST_LORA_NSS;
+  SPI_Init(&spi);
+
+  TEST_ASSERT_TRUE(LoRa_Probe(&lora));
+  TEST_ASSERT_TRUE(PORTB & (1 << TEST_LORA_NSS));   // Deselected again
+}
+
+static void test_lora_probe_without_radio_fails(void)
+{
+  SPI_HandleTypeDef spi = { { SPI_MODE0, SPI_CLOCK_DIV16, 0 } };
+  LoRa_Handle_t lora;
+  memset(&lora, 0, sizeof(lora));
+  lora.spiHandle = &spi;
+  lora.nssPort = &PORTB;
+  lora.nssPin = TEST_LORA_NSS;
+  SPI_Init(&spi);
+  HAL_HostSpiAttach(NULL, NULL);     // MISO floats high
+
+  TEST_ASSERT_FALSE(LoRa_Probe(&lora));
+}
+
+int main(void)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_bmp280_init_configures_normal_mode);
+  RUN_TEST(test_bmp280_reads_datasheet_example);
+  RUN_TEST(test_bmp280_wrong_id_fails_init);
+  RUN_TEST(test_bmp280_absent_fails_init);
+  RUN_TEST(test_bmp280_detached_keeps_readings);
+  RUN_TEST(test_twi_stalled_bus_times_out);
+  RUN_TEST(test_detached_sensors_fail_health);
+  RUN_TEST(test_lora_probe_reads_version);
+  RUN_TEST(test_lora_probe_without_radio_fails);
+  return UNITY_END();
+}
@@ -0,0 +1,202 @@
+/**
+ * @file test_main.c
+ * @brief Kalman filter and flight-phase state machine on simulated flights
+ * @author Nate Hunter
+ * @date 2025-08-20
+ * @version v1.0.0
+ *
+ * The flight: 2 s at 4 g net thrust, ballistic coast to apogee (~390 m),
+ * 5 m/s under the parachute, then at rest. Baro and accelerometer are
+ * sampled at 100 Hz and fed through KF_* into FLIGHT_Update() the way
+ * TaskSample does.
+ */
+
+#include <unity.h>
+#include "kalman.h"
+#include "flight.h"
+
+#define TEST_DT_MS       10
+#define TEST_G           980.665f   ///< cm/s^2
+#define TEST_THRUST      (4.0f * TEST_G)
+#define TEST_BURN_MS     2000UL
+#define TEST_CHUTE_CMS   500.0f
+#define TEST_END_MS      200000UL
+
+/** @brief Simulated vehicle: true altitude / velocity and what the sensors report */
+typedef struct {
+  float h;          ///< cm
+  float v;          ///< cm/s
+  float a;          ///< cm/s^2, gravity removed
+  uint8_t chute;
+} TestRocket;
+
+static void TestRocketStep(TestRocket *r, uint32_t ms)
+{
+  const float dt = TEST_DT_MS / 1000.0f;
+
+  if (ms < 5000UL) {
+    r->a = 0;                                   // On the pad
+  } else if (ms < 5000UL + TEST_BURN_MS) {
+    r->a = TEST_THRUST;
+  } else if (!r->chute) {
+    r->a = -TEST_G;                             // Coast and fall, no drag
+    if (r->v < -TEST_CHUTE_CMS)
+      r->chute = 1;
+  }
+  if (r->chute) {
+    r->a = 0;
+    r->v = r->h > 0 ? -TEST_CHUTE_CMS : 0;
+  }
+  r->v += r->a * dt;
+  r->h += r->v * dt;
+  if (r->h <= 0 && ms >= 5000UL + TEST_BURN_MS) {
+    r->h = 0;
+    r->v = 0;
+  }
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static void test_kalman_holds_rest(void)
+{
+  KF_Handle kf;
+  KF_Init(&kf, 1.0f, 1000);
+  for (uint16_t i = 0; i < 1000; i++) {
+    KF_Predict(&kf, 0, TEST_DT_MS * 1000UL);
+    KF_Correct(&kf, 1000, TEST_DT_MS * 1000UL);
+  }
+  TEST_ASSERT_INT32_WITHIN(2, 1000, KF_GetAltitude(&kf));
+  TEST_ASSERT_INT32_WITHIN(2, 0, KF_GetVelocity(&kf));
+}
+
+static void test_kalman_tracks_constant_acceleration(void)
+{
+  KF_Handle kf;
+  float h = 0, v = 0;
+  const float a = 1000.0f;
+  KF_Init(&kf, 1.0f, 0);
+  for (uint16_t i = 0; i < 300; i++) {
+    v += a * TEST_DT_MS / 1000.0f;
+    h += v * TEST_DT_MS / 1000.0f;
+    KF_Predict(&kf, (int32_t)a, TEST_DT_MS * 1000UL);
+    KF_Correct(&kf, (int32_t)h, TEST_DT_MS * 1000UL);
+  }
+  TEST_ASSERT_INT32_WITHIN(60, (int32_t)v, KF_GetVelocity(&kf));
+  TEST_ASSERT_INT32_WITHIN(20, (int32_t)h, KF_GetAltitude(&kf));
+}
+
+static void test_kalman_removes_accel_bias(void)
+{
+  KF_Handle kf;
+  KF_Init(&kf, 1.0f, 0);
+  // The accelerometer reads 50 cm/s^2 high while the baro says at rest
+  for (uint16_t i = 0; i < 3000; i++) {
+    KF_Predict(&kf, 50, TEST_DT_MS * 1000UL);
+    KF_Correct(&kf, 0, TEST_DT_MS * 1000UL);
+  }
+  TEST_ASSERT_INT32_WITHIN(5, 0, KF_GetVelocity(&kf));
+  TEST_ASSERT_INT32_WITHIN(5, 0, KF_GetAccel(&kf));
+}
+
+static void test_flight_phases_follow_the_flight(void)
+{
+  TestRocket r = { 0, 0, 0, 0 };
+  KF_Handle kf;
+  FLIGHT_Handle fl;
+  uint32_t enteredMs[FLIGHT_PHASE_COUNT] = { 0 };
+  uint32_t apogeeMs = 0;
+  float apogeeCm = 0;
+  uint8_t order = FLIGHT_IDLE;
+
+  KF_Init(&kf, 1.0f, 0);
+  FLIGHT_Init(&fl, 0);
+  for (uint32_t ms = TEST_DT_MS; ms <= TEST_END_MS; ms += TEST_DT_MS) {
+    TestRocketStep(&r, ms);
+    if (r.h > apogeeCm) {
+      apogeeCm = r.h;
+      apogeeMs = ms;
+    }
+
+    // The accelerometer feels thrust plus gravity, nothing in free fall
+    float felt = (r.a + TEST_G) / TEST_G;
+    KF_Predict(&kf, (int32_t)r.a, TEST_DT_MS * 1000UL);
+    KF_Correct(&kf, (int32_t)r.h, TEST_DT_MS * 1000UL);
+    if (FLIGHT_Update(&fl, ms, KF_GetAltitude(&kf), KF_GetVelocity(&kf), felt * felt, 0)) {
+      TEST_ASSERT_EQUAL(order + 1, fl.phase);
+      order = fl.phase;
+      enteredMs[fl.phase] = ms;
+    }
+  }
+
+  TEST_ASSERT_EQUAL(FLIGHT_LANDED, fl.phase);
+  // Launch within the confirmation samples, burnout right at motor cut-off
+  TEST_ASSERT_UINT32_WITHIN(FLIGHT_LAUNCH_CONFIRM * TEST_DT_MS, 5000UL, enteredMs[FLIGHT_BOOST]);
+  TEST_ASSERT_UINT32_WITHIN(2 * TEST_DT_MS, 5000UL + TEST_BURN_MS, enteredMs[FLIGHT_COAST]);
+  TEST_ASSERT_UINT32_WITHIN(200, apogeeMs, enteredMs[FLIGHT_APOGEE]);
+  TEST_ASSERT_EQUAL_UINT32(enteredMs[FLIGHT_APOGEE] + FLIGHT_APOGEE_HOLD_MS, enteredMs[FLIGHT_DESCENT]);
+  TEST_ASSERT_TRUE(enteredMs[FLIGHT_LANDED] > enteredMs[FLIGHT_DESCENT] + FLIGHT_LANDED_MS);
+  TEST_ASSERT_INT32_WITHIN(100, (int32_t)apogeeCm, fl.maxAltitude);
+}
+
+static void test_flight_ignores_pad_bumps(void)
+{
+  FLIGHT_Handle fl;
+  FLIGHT_Init(&fl, 0);
+  // A wake-up shorter than the confirmation count is a knock, not a launch
+  for (uint8_t i = 0; i < FLIGHT_LAUNCH_CONFIRM - 1; i++)
+    TEST_ASSERT_FALSE(FLIGHT_Update(&fl, i * TEST_DT_MS, 0, 0, 1.0f, FLIGHT_EVT_WAKEUP));
+  TEST_ASSERT_FALSE(FLIGHT_Update(&fl, 100, 0, 0, 1.0f, 0));
+  TEST_ASSERT_EQUAL(FLIGHT_IDLE, fl.phase);
+}
+
+static void test_flight_baro_backup_detects_launch(void)
+{
+  FLIGHT_Handle fl;
+  FLIGHT_Init(&fl, 0);
+  TEST_ASSERT_TRUE(FLIGHT_Update(&fl, 10, FLIGHT_LAUNCH_ALT_CM + 1, 0, 1.0f, 0));
+  TEST_ASSERT_EQUAL(FLIGHT_BOOST, fl.phase);
+}
+
+static void test_flight_rearms_after_rest(void)
+{
+  FLIGHT_Handle fl;
+  FLIGHT_Init(&fl, 0);
+  fl.phase = FLIGHT_LANDED;
+  fl.stableAltitude = 0;
+  fl.stableSinceMs = 0;
+
+  // Carried around: every wake-up restarts the wait
+  TEST_ASSERT_FALSE(FLIGHT_Update(&fl, FLIGHT_REARM_MS - 1000, 0, 0, 1.0f, FLIGHT_EVT_WAKEUP));
+  TEST_ASSERT_FALSE(FLIGHT_Update(&fl, FLIGHT_REARM_MS + 1000, 0, 0, 1.0f, 0));
+  TEST_ASSERT_EQUAL(FLIGHT_LANDED, fl.phase);
+
+  TEST_ASSERT_TRUE(FLIGHT_Update(&fl, 2 * FLIGHT_REARM_MS, 0, 0, 1.0f, 0));
+  TEST_ASSERT_EQUAL(FLIGHT_IDLE, fl.phase);
+  TEST_ASSERT_FALSE(FLIGHT_Rearm(&fl, 2 * FLIGHT_REARM_MS));   // Only from LANDED
+}
+
+static void test_flight_phase_names(void)
+{
+  TEST_ASSERT_EQUAL_STRING("APOGEE", FLIGHT_PhaseName(FLIGHT_APOGEE));
+  TEST_ASSERT_EQUAL_STRING("?", FLIGHT_PhaseName(FLIGHT_PHASE_COUNT));
+}
+
+int main(void)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_kalman_holds_rest);
+  RUN_TEST(test_kalman_tracks_constant_acceleration);
+  RUN_TEST(test_kalman_removes_accel_bias);
+  RUN_TEST(test_flight_phases_follow_the_flight);
+  RUN_TEST(test_flight_ignores_pad_bumps);
+  RUN_TEST(test_flight_baro_backup_detects_launch);
+  RUN_TEST(test_flight_rearms_after_rest);
+  RUN_TEST(test_flight_phase_names);
+  return UNITY_END();
+}
@@ -0,0 +1,109 @@
+/**
+ * @file test_main.c
+ * @brief Frame encoding tests, read back through the host UART capture
+ * @author Nate Hunter
+ * @date 2025-08-20
+ * @version v1.0.0
+ */
+
+#include <string.h>
+#include <unity.h>
+#include "frame.h"
+#include "crc16.h"
+#include "uart.h"
+
+static uint8_t stored[FRAME_MAX_PAYLOAD + 8];
+static uint8_t storedLen;
+static uint8_t storedType;
+
+static void TestStore(uint8_t type, const uint8_t *data, uint8_t len)
+{
+  storedType = type;
+  storedLen = len;
+  memcpy(stored, data, len);
+}
+
+/** @brief COBS-decode one frame ending in 0x00 @return Decoded length, 0 if malformed */
+static uint8_t TestCobsDecode(const uint8_t *in, uint8_t len, uint8_t *out)
+{
+  uint8_t n = 0, i = 0;
+  while (i < len && in[i]) {
+    uint8_t code = in[i++];
+    for (uint8_t k = 1; k < code; k++) {
+      if (i >= len || !in[i])
+        return 0;
+      out[n++] = in[i++];
+    }
+    if (i < len && in[i])
+      out[n++] = 0;
+  }
+  return i == len - 1 ? n : 0;
+}
+
+void setUp(void)
+{
+  UART_Init(115200);
+  FRAME_SetSequence(0);
+  FRAME_SetStore(TestStore);
+  storedLen = 0;
+}
+
+void tearDown(void)
+{
+  FRAME_SetStore(NULL);
+}
+
+static void test_frame_layout_and_crc(void)
+{
+  const uint8_t payload[] = { 0x00, 0x11, 0x00, 0x00, 0x22 };
+  uint8_t wire[32], frame[32];
+
+  FRAME_SetSequence(0x1234);
+  TEST_ASSERT_TRUE(FRAME_Send(FRAME_TYPE_EVENT, payload, sizeof(payload)));
+  uint16_t n = UART_HostTake(wire, sizeof(wire));
+  TEST_ASSERT_EQUAL(0x00, wire[n - 1]);
+  for (uint16_t i = 0; i < n - 1; i++)
+    TEST_ASSERT_TRUE(wire[i] != 0);
+
+  uint8_t len = TestCobsDecode(wire, (uint8_t)n, frame);
+  TEST_ASSERT_EQUAL(1 + 2 + sizeof(payload) + 2, len);
+  TEST_ASSERT_EQUAL_HEX8(FRAME_TYPE_EVENT, frame[0]);
+  TEST_ASSERT_EQUAL_HEX16(0x1234, frame[1] | (frame[2] << 8));
+  TEST_ASSERT_EQUAL_MEMORY(payload, &frame[3], sizeof(payload));
+  TEST_ASSERT_EQUAL_HEX16(CRC16_Compute(frame, len - 2), frame[len - 2] | (frame[len - 1] << 8));
+  TEST_ASSERT_EQUAL(0x1235, FRAME_GetSequence());
+}
+
+static void test_frame_log_stores_without_uart(void)
+{
+  const uint32_t value = 0xDEADBEEFUL;
+  uint8_t wire[32];
+
+  TEST_ASSERT_TRUE(FRAME_Log(FRAME_TYPE_INFO, &value, sizeof(value), 0));
+  TEST_ASSERT_EQUAL(0, UART_HostTake(wire, sizeof(wire)));
+  TEST_ASSERT_EQUAL(FRAME_TYPE_INFO, storedType);
+  TEST_ASSERT_EQUAL(0x00, stored[storedLen - 1]);
+
+  // The UART copy is the same byte stream
+  TEST_ASSERT_TRUE(FRAME_Log(FRAME_TYPE_INFO, &value, sizeof(value), 1));
+  TEST_ASSERT_EQUAL(storedLen, UART_HostTake(wire, sizeof(wire)));
+  TEST_ASSERT_EQUAL_MEMORY(stored, wire, storedLen);
+}
+
+static void test_frame_rejects_oversized_payload(void)
+{
+  uint8_t big[FRAME_MAX_PAYLOAD + 1] = { 0 };
+  uint8_t wire[8];
+  TEST_ASSERT_FALSE(FRAME_Send(FRAME_TYPE_SAMPLE, big, sizeof(big)));
+  TEST_ASSERT_EQUAL(0, UART_HostTake(wire, sizeof(wire)));
+  TEST_ASSERT_EQUAL(0, FRAME_GetSequence());
+}
+
+int main(void)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_frame_layout_and_crc);
+  RUN_TEST(test_frame_log_stores_without_uart);
+  RUN_TEST(test_frame_rejects_oversized_payload);
+  return UNITY_END();
+}
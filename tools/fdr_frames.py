@@ -0,0 +1,280 @@
+#!/usr/bin/env python3
+"""Decode the FeatherFDR binary frame stream (see lib/frame/src/frame.h).
+
+Reads COBS frames from a serial port or a capture file, checks CRC-16 and
+sequence numbers and prints one CSV line per record. SD log files are
+block-structured; read them with fdr_recover.py, which uses decode().
+
+    fdr_frames.py /dev/ttyUSB0 --baud 1000000 > flight.csv
+    fdr_frames.py capture.bin > flight.csv
+"""
+
+import argparse
+import binascii
+import struct
+import sys
+
+FLIGHT_PHASES = ["IDLE", "BOOST", "COAST", "APOGEE", "DESCENT", "LANDED"]
+
+# FDR_LOG_SCHEMA in main.cpp: bump together with any change to RECORDS
+SCHEMA = 4
+
+# type id -> (name, struct layout, field names); must match main.cpp records
+RECORDS = {
+    0x01: ("INFO", "<III", ["accel_ug_lsb", "gyro_udps_lsb", "zero_press"]),
+    0x02: ("SAMPLE", "<IhIiii3h3hB",
+           ["t_us", "temp", "press", "alt", "kf_alt", "kf_vel",
+            "ax", "ay", "az", "gx", "gy", "gz", "phase"]),
+    0x03: ("PRETRIG", "<II3h3h", ["t_us", "press", "ax", "ay", "az", "gx", "gy", "gz"]),
+    0x04: ("EVENT", "<IBH", ["t_us", "phase", "uart_ovf"]),
+    0x05: ("VIB", "<I8BBHH", ["t_us"] + ["b%d" % i for i in range(8)] + ["peak", "rate", "us"]),
+    0x06: ("TRACE", "<IHBBBB", ["t_tick", "dur_tick", "dev", "reg", "len", "status"]),
+    0x07: ("POST", "<BBBH8B8H", ["code", "fatal", "count", "total_ms"] +
+           ["r%d" % i for i in range(8)] + ["ms%d" % i for i in range(8)]),
+    0x08: ("BOOT", "<BBHH4H", ["count", "timed_out", "total_ms", "first_sample_ms"] +
+           ["done_ms%d" % i for i in range(4)]),
+    0x09: ("GAP", "<IBBBB", ["t_us", "reset_cause", "source", "restarts", "phase"]),
+    0x0A: ("STORAGE", "<IIHHB", ["first_lba", "sectors", "bench_kbps", "max_busy_us", "status"]),
+    0x0B: ("DROP", "<I3HBH", ["t_us", "dropped_low", "dropped_normal", "dropped_high",
+                              "queue_max", "max_wait_ms"]),
+    0x0D: ("POWER", "<IHhHBBHB", ["t_us", "bus_mv", "current_ma", "power_mw", "charge_pct",
+                                  "level", "endurance_min", "alert"]),
+    0x0E: ("HEALTH", "<I3B3H", ["t_us", "baro", "imu", "power",
+                                "baro_errors", "imu_errors", "power_errors"]),
+}
+
+# SAMPLE_DELTA frames: reference sequence byte + sample coded by lib/rice
+SAMPLE_DELTA = 0x0C
+
+# lib/rice channel types
+RICE_U8, RICE_I16, RICE_I32, RICE_U32, RICE_T32 = range(5)
+RICE_ESCAPE = 16
+RICE_WIDTH = {RICE_U8: (1, False), RICE_I16: (2, True), RICE_I32: (4, True),
+              RICE_U32: (4, False), RICE_T32: (4, False)}
+
+# (offset, type, k after a key); must match sampleChannels in main.cpp
+SAMPLE_CHANNELS = [
+    (0, RICE_T32, 6), (4, RICE_I16, 1), (6, RICE_U32, 3), (10, RICE_I32, 4),
+    (14, RICE_I32, 3), (18, RICE_I32, 3),
+    (22, RICE_I16, 5), (24, RICE_I16, 5), (26, RICE_I16, 5),
+    (28, RICE_I16, 4), (30, RICE_I16, 4), (32, RICE_I16, 4),
+    (34, RICE_U8, 0),
+]
+
+TICK_US = 4  # Timer1 tick, lib/time
+
+
+class RiceDecoder:
+    """Inverse of RICE_Encode for one record layout (see lib/rice/src/rice.h)."""
+
+    def __init__(self, channels):
+        self.channels = channels
+        self.prev = None
+
+    def key(self, record):
+        self.prev = bytes(record)
+        self.k = [c[2] for c in self.channels]
+        self.step = 0
+
+    def decode(self, data):
+        """Record coded against the reference, or None if it does not decode."""
+        if self.prev is None:
+            return None
+        bits = int.from_bytes(data, "big")
+        left = len(data) * 8
+        rec = bytearray(self.prev)
+        k = list(self.k)
+        step = self.step
+
+        def take(n):
+            nonlocal left
+            if n > left:
+                raise ValueError
+            left -= n
+            return (bits >> left) & ((1 << n) - 1)
+
+        try:
+            for c, (off, typ, _) in enumerate(self.channels):
+                width, signed = RICE_WIDTH[typ]
+                q = 0
+                while q < RICE_ESCAPE and take(1):
+                    q += 1
+                if q == RICE_ESCAPE:
+                    u = take(32)
+                    k[c] = u.bit_length() - 1
+                else:
+                    u = (q << k[c]) | take(k[c])
+                    if q > 1:
+                        k[c] += 1
+                    elif not q and k[c] and u < 1 << (k[c] - 1):
+                        k[c] -= 1
+                r = (u >> 1) ^ -(u & 1)
+                prev = int.from_bytes(self.prev[off:off + width], "little", signed=signed)
+                pred = prev + step if typ == RICE_T32 else prev
+                value = (pred + r) & 0xFFFFFFFF
+                if typ == RICE_T32:
+                    step = (value - prev) & 0xFFFFFFFF
+                    step -= (step & 0x80000000) << 1
+                rec[off:off + width] = (value & ((1 << 8 * width) - 1)).to_bytes(width, "little")
+        except ValueError:
+            return None
+        # Whole bytes only: at most 7 padding bits may remain
+        if left >= 8:
+            return None
+        self.prev = bytes(rec)
+        self.k = k
+        self.step = step
+        return self.prev
+
+
+def bus_summary(entries, out):
+    """Per-device transaction count, error count and duration stats (us)."""
+    stats = {}
+    for dev, dur, status in entries:
+        s = stats.setdefault(dev, [0, 0, 0, 0])
+        s[0] += 1
+        s[1] += status != 0
+        s[2] += dur
+        s[3] = max(s[3], dur)
+    out.write("bus,dev,count,errors,mean_us,max_us\n")
+    for dev in sorted(stats):
+        n, err, total, worst = stats[dev]
+        bus = "SPI" if dev & 0x80 else "TWI"
+        out.write("%s,0x%02X,%d,%d,%d,%d\n" % (bus, dev & 0x7F, n, err,
+                                              total * TICK_US // n, worst * TICK_US))
+
+
+def crc16(data):
+    """CRC-16/CCITT-FALSE, same as lib/crc16."""
+    return binascii.crc_hqx(data, 0xFFFF)
+
+
+def cobs_decode(buf):
+    out = bytearray()
+    i = 0
+    while i < len(buf):
+        code = buf[i]
+        if code == 0 or i + code > len(buf) + 1:
+            return None
+        out += buf[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(buf):
+            out.append(0)
+    return bytes(out)
+
+
+def frames(stream):
+    """Yield raw zero-delimited chunks from a byte stream."""
+    pending = bytearray()
+    while True:
+        chunk = stream.read(4096)
+        if not chunk:
+            break
+        pending += chunk
+        while True:
+            end = pending.find(b"\x00")
+            if end < 0:
+                break
+            yield bytes(pending[:end])
+            del pending[:end + 1]
+
+
+def decode(stream, out, bus_summary_only=False, stats=None):
+    """Decode a frame stream into CSV lines; returns (bad, lost) frame counts.
+
+    SAMPLE_DELTA frames are expanded and printed as SAMPLE lines; one whose
+    reference is missing counts as bad. If given, stats gets the live
+    sample count ("keys", "deltas") and their payload bytes ("coded")."""
+    expected = None
+    bad = lost = 0
+    trace = []
+    rice = RiceDecoder(SAMPLE_CHANNELS)
+    ref = None
+    if stats is None:
+        stats = {}
+    for key in ("keys", "deltas", "coded"):
+        stats.setdefault(key, 0)
+    for raw in frames(stream):
+        # Empty chunks are zero padding of SD blocks
+        if not raw:
+            continue
+        frame = cobs_decode(raw)
+        if not frame or len(frame) < 5 or crc16(frame[:-2]) != struct.unpack_from("<H", frame, len(frame) - 2)[0]:
+            bad += 1
+            continue
+        rtype, seq = frame[0], struct.unpack_from("<H", frame, 1)[0]
+        if expected is not None and seq != expected:
+            lost += (seq - expected) & 0xFFFF
+        expected = (seq + 1) & 0xFFFF
+
+        payload = frame[3:-2]
+        if rtype == SAMPLE_DELTA:
+            sample = rice.decode(payload[1:]) if payload and payload[0] == ref else None
+            if sample is None:
+                rice.prev = None
+                bad += 1
+                continue
+            stats["deltas"] += 1
+            stats["coded"] += len(payload)
+            rtype, payload = 0x02, sample
+        elif rtype == 0x02:
+            rice.key(payload)
+            stats["keys"] += 1
+            stats["coded"] += len(payload)
+        if rtype == 0x02:
+            ref = seq & 0xFF
+
+        rec = RECORDS.get(rtype)
+        if rec is None:
+            continue
+        name, fmt, fields = rec
+        if len(payload) != struct.calcsize(fmt):
+            bad += 1
+            continue
+        values = list(struct.unpack(fmt, payload))
+        if name == "TRACE":
+            trace.append((values[2], values[1], values[5]))
+        if bus_summary_only:
+            continue
+        if "phase" in fields:
+            p = fields.index("phase")
+            values[p] = FLIGHT_PHASES[values[p]] if values[p] < len(FLIGHT_PHASES) else values[p]
+        out.write(",".join([name, str(seq)] + [str(v) for v in values]) + "\n")
+
+    if bus_summary_only:
+        bus_summary(trace, out)
+    return bad, lost
+
+
+def zip_summary(stats):
+    """One line on sample compression from decode() stats."""
+    samples = stats["keys"] + stats["deltas"]
+    if not samples:
+        return ""
+    raw = samples * struct.calcsize(RECORDS[0x02][1])
+    return "samples: %d (%d keys), payload bytes: %d coded / %d raw = %.1f%%\n" % (
+        samples, stats["keys"], stats["coded"], raw, 100.0 * stats["coded"] / raw)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("source", help="serial port or capture file")
+    ap.add_argument("--baud", type=int, default=115200)
+    ap.add_argument("--bus-summary", action="store_true",
+                    help="print per-device bus statistics from TRACE records instead of CSV")
+    args = ap.parse_args()
+
+    if args.source.startswith(("/dev/", "COM")):
+        import serial  # pyserial, only needed for live capture
+        stream = serial.Serial(args.source, args.baud, timeout=1)
+    else:
+        stream = open(args.source, "rb")
+
+    stats = {}
+    bad, lost = decode(stream, sys.stdout, args.bus_summary, stats)
+    sys.stderr.write("bad frames: %d, lost frames: %d\n" % (bad, lost))
+    sys.stderr.write(zip_summary(stats))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,260 @@
+#!/usr/bin/env python3
+"""Copy FeatherFDR log files off the SD card over the USB serial link.
+
+Puts the recorder into offload mode (console command 'o', accepted on the
+pad and after landing), switches to the rate it announces and reads the
+card block by block (see lib/offload/src/offload.h). Every block carries
+a CRC and is requested again if it is corrupted or missing. The output
+only ever grows by whole, checked blocks, so an interrupted copy resumes
+where it stopped when run again. The FAT is read here; the recorder only
+serves raw blocks.
+
+    fdr_offload.py /dev/ttyUSB0 --list
+    fdr_offload.py /dev/ttyUSB0                     # newest log -> FDRnnnnn.BIN
+    fdr_offload.py /dev/ttyUSB0 --file FDR00003.BIN --out flight.bin
+    fdr_recover.py flight.bin > flight.csv
+"""
+
+import argparse
+import os
+import struct
+import sys
+import time
+
+import fdr_frames
+import fdr_recover
+
+BLOCK = 512
+SYNC = 0xA5
+REQUEST = struct.Struct("<cIH")
+INFO = struct.Struct("<BBIIIH")         # version, card type, baud, write lba, end lba, boot
+REPLY_SIZE = {b"I": INFO.size, b"B": 4 + BLOCK, b"E": 5}
+VERSION = 1
+
+
+class OffloadError(Exception):
+    pass
+
+
+class Link:
+    """Request / reply link to a recorder in offload mode."""
+
+    def __init__(self, port, baud, chunk, retries):
+        import serial  # pyserial
+        self.port = serial.Serial(port, baud, timeout=0.5)
+        self.chunk = chunk
+        self.retries = retries
+        self.resent = 0
+        self.active = False
+
+    def request(self, op, lba=0, count=0):
+        body = REQUEST.pack(op, lba, count)
+        self.port.write(body + struct.pack("<H", fdr_frames.crc16(body)))
+
+    def reply(self):
+        """(kind, body) of the next intact reply, None on timeout or CRC error."""
+        while True:
+            b = self.port.read(1)
+            if not b:
+                return None
+            if b[0] != SYNC:
+                continue
+            kind = self.port.read(1)
+            if kind not in REPLY_SIZE:
+                continue
+            body = self.port.read(REPLY_SIZE[kind] + 2)
+            if len(body) < REPLY_SIZE[kind] + 2:
+                return None
+            crc = struct.unpack_from("<H", body, len(body) - 2)[0]
+            if fdr_frames.crc16(bytes([SYNC]) + kind + body[:-2]) != crc:
+                return None
+            return kind, body[:-2]
+
+    def resync(self):
+        """Stop a range in progress and drop whatever is still on its way."""
+        self.port.write(b"\x00")
+        time.sleep(0.05)
+        self.port.reset_input_buffer()
+
+    def enter(self):
+        """Start offload mode, follow the announced baud rate; returns the info fields."""
+        self.port.reset_input_buffer()
+        self.port.write(b"o")
+        deadline = time.time() + 3
+        info = None
+        while info is None and time.time() < deadline:
+            r = self.reply()
+            if r and r[0] == b"I":
+                info = INFO.unpack(r[1])
+        if info is None:
+            raise OffloadError("no answer; the recorder takes 'o' only on the pad or after landing")
+        if info[0] != VERSION:
+            raise OffloadError("protocol version %d, this tool speaks %d" % (info[0], VERSION))
+        if not info[1]:
+            raise OffloadError("no SD card in the recorder")
+        time.sleep(0.05)
+        self.port.baudrate = info[2]
+        self.active = True
+        for _ in range(self.retries):
+            self.request(b"I")
+            r = self.reply()
+            if r and r[0] == b"I":
+                return INFO.unpack(r[1])
+            self.resync()
+        raise OffloadError("no answer at %d baud" % info[2])
+
+    def leave(self):
+        # Never at the console rate: request bytes could be console commands
+        if self.active:
+            self.request(b"Q")
+            self.port.flush()
+
+    def blocks(self, lba, count):
+        """Yield (lba, data) for count blocks, requesting again after any failure."""
+        end = lba + count
+        failures = 0
+        while lba < end:
+            n = min(self.chunk, end - lba)
+            self.request(b"R", lba, n)
+            got = 0
+            while got < n:
+                r = self.reply()
+                if r is None or r[0] != b"B" or struct.unpack_from("<I", r[1])[0] != lba:
+                    if r and r[0] == b"E" and failures + 1 >= self.retries:
+                        raise OffloadError("card read error %d at block %d" % (r[1][4], lba))
+                    break
+                yield lba, r[1][4:]
+                lba += 1
+                got += 1
+                failures = 0
+            if got < n:
+                failures += 1
+                self.resent += 1
+                if failures >= self.retries:
+                    raise OffloadError("block %d failed %d times" % (lba, failures))
+                self.resync()
+
+    def read(self, lba, count=1):
+        return b"".join(data for _, data in self.blocks(lba, count))
+
+
+class Volume:
+    """Just enough FAT32 to find the contiguous log files (lib/fat32)."""
+
+    def __init__(self, link):
+        self.link = link
+        sec = link.read(0)
+        part = 0
+        if sec[0] not in (0xEB, 0xE9):
+            if sec[446 + 4] not in (0x0B, 0x0C):
+                raise OffloadError("no FAT32 volume on the card")
+            part = struct.unpack_from("<I", sec, 446 + 8)[0]
+            sec = link.read(part)
+        bps, self.spc, reserved, fats = struct.unpack_from("<HBHB", sec, 11)
+        fat_sectors, self.root = struct.unpack_from("<I4xI", sec, 36)
+        if bps != BLOCK or not self.spc or not fat_sectors:
+            raise OffloadError("unsupported FAT32 layout")
+        self.fat = part + reserved
+        self.data = self.fat + fats * fat_sectors
+
+    def cluster_lba(self, cluster):
+        return self.data + (cluster - 2) * self.spc
+
+    def files(self):
+        """[(name, first lba, blocks)] of the FDR*.BIN files in the root directory."""
+        out = []
+        cluster = self.root
+        while 2 <= cluster < 0x0FFFFFF8:
+            data = self.link.read(self.cluster_lba(cluster), self.spc)
+            for i in range(0, len(data), 32):
+                ent = data[i:i + 32]
+                if ent[0] == 0:
+                    return out
+                if ent[0] == 0xE5 or ent[11] == 0x0F:
+                    continue
+                name = "%s.%s" % (ent[:8].decode("ascii", "replace").rstrip(),
+                                  ent[8:11].decode("ascii", "replace").rstrip())
+                first = struct.unpack_from("<H", ent, 20)[0] << 16 | struct.unpack_from("<H", ent, 26)[0]
+                size = struct.unpack_from("<I", ent, 28)[0]
+                if name.startswith("FDR") and name.endswith(".BIN") and first >= 2:
+                    out.append((name, self.cluster_lba(first), (size + BLOCK - 1) // BLOCK))
+            entry = self.link.read(self.fat + cluster * 4 // BLOCK)
+            cluster = struct.unpack_from("<I", entry, cluster * 4 % BLOCK)[0] & 0x0FFFFFFF
+        return out
+
+
+def is_log_block(data):
+    if data[:4] != fdr_recover.MAGIC_BYTES:
+        return False
+    return fdr_frames.crc16(data[:-2]) == struct.unpack_from("<H", data, BLOCK - 2)[0]
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("port", help="serial port of the recorder")
+    ap.add_argument("--baud", type=int, default=115200, help="console baud rate (FDR_UART_BAUD)")
+    ap.add_argument("--list", action="store_true", help="list the log files and exit")
+    ap.add_argument("--file", help="log file to copy (default: the newest)")
+    ap.add_argument("--out", help="output file (default: the log file name); resumed if it exists")
+    ap.add_argument("--full", action="store_true",
+                    help="copy the whole preallocated file, not just up to the end of the log")
+    ap.add_argument("--chunk", type=int, default=64, help="blocks per request")
+    ap.add_argument("--retries", type=int, default=10, help="attempts per block")
+    args = ap.parse_args()
+
+    link = Link(args.port, args.baud, args.chunk, args.retries)
+    try:
+        _, _, baud, write_lba, end_lba, boot = link.enter()
+        files = Volume(link).files()
+        live = [f for f in files if f[1] <= write_lba < f[1] + f[2]]
+        if args.list:
+            sys.stdout.write("file,first_lba,blocks,live\n")
+            for name, first, blocks in files:
+                sys.stdout.write("%s,%d,%d,%s\n" % (name, first, blocks,
+                                                    "boot %d" % boot if (name, first, blocks) in live else ""))
+            return
+        if not files:
+            raise OffloadError("no FDR*.BIN files on the card")
+        pick = [f for f in files if f[0] == args.file.upper()] if args.file else [max(files)]
+        if not pick:
+            raise OffloadError("%s not found" % args.file)
+        name, first, blocks = pick[0]
+        # The live file ends at the write position; older ones where the log blocks stop
+        if pick[0] in live and not args.full:
+            blocks = write_lba - first
+
+        out_path = args.out or name
+        done = os.path.getsize(out_path) // BLOCK if os.path.exists(out_path) else 0
+        if done:
+            sys.stderr.write("%s: resuming at block %d\n" % (out_path, done))
+        seen_log = done > 0
+        misses = 0
+        t0 = time.time()
+        copied = 0
+        with open(out_path, "r+b" if done else "wb") as out:
+            out.seek(done * BLOCK)
+            out.truncate()
+            for lba, data in link.blocks(first + done, blocks - done):
+                out.write(data)
+                copied += 1
+                if not args.full and pick[0] not in live:
+                    if is_log_block(data):
+                        seen_log, misses = True, 0
+                    elif seen_log:
+                        misses += 1
+                        if misses >= 8:
+                            break
+                if copied % 256 == 0:
+                    sys.stderr.write("\r%d / %d blocks" % (done + copied, blocks))
+        elapsed = max(time.time() - t0, 1e-6)
+        sys.stderr.write("\r%s: %d blocks (%d KB) in %.1f s = %.1f KB/s at %d baud, %d re-requests\n" % (
+            out_path, copied, copied * BLOCK // 1024, elapsed, copied * BLOCK / 1024 / elapsed,
+            baud, link.resent))
+    except OffloadError as e:
+        sys.exit(str(e))
+    finally:
+        link.leave()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,126 @@
+#!/usr/bin/env python3
+"""Recover FeatherFDR logs from an SD log file or a raw card image.
+
+Scans for 512-byte log blocks (see lib/logblk/src/logblk.h), keeps those
+with an intact CRC, orders them by sequence number per cold boot and
+decodes the frames in them to CSV like fdr_frames.py. Torn, stale or
+never-written blocks are skipped; a frame that spanned one is counted as
+bad and the decoder resyncs on the next block.
+
+    fdr_recover.py FDR00003.BIN > flight.csv
+    fdr_recover.py --list /dev/sdb
+    fdr_recover.py --boot 17 card.img > flight.csv
+"""
+
+import argparse
+import io
+import mmap
+import os
+import struct
+import sys
+
+import fdr_frames
+
+BLOCK = 512
+HEADER = struct.Struct("<IBBHII")     # magic, schema, reserved, boot, seq, t_first_ms
+TRAILER = struct.Struct("<IHH")       # t_last_ms, used, crc
+PAYLOAD = BLOCK - HEADER.size - TRAILER.size
+MAGIC = 0x4C524446
+MAGIC_BYTES = struct.pack("<I", MAGIC)
+
+
+def scan(data):
+    """Yield (boot, seq, schema, t_first, t_last, payload) for every valid block."""
+    pos = data.find(MAGIC_BYTES)
+    while pos >= 0:
+        if pos % BLOCK:
+            pos = data.find(MAGIC_BYTES, pos - pos % BLOCK + BLOCK)
+            continue
+        block = data[pos:pos + BLOCK]
+        if len(block) == BLOCK:
+            t_last, used, crc = TRAILER.unpack_from(block, BLOCK - TRAILER.size)
+            if used <= PAYLOAD and fdr_frames.crc16(block[:-2]) == crc:
+                _, schema, _, boot, seq, t_first = HEADER.unpack_from(block)
+                yield boot, seq, schema, t_first, t_last, block[HEADER.size:HEADER.size + used]
+        pos = data.find(MAGIC_BYTES, pos + BLOCK)
+
+
+def collect(data):
+    """Group valid blocks: {boot: {seq: block}}; a repeated seq keeps the newest write."""
+    boots = {}
+    for blk in scan(data):
+        seqs = boots.setdefault(blk[0], {})
+        old = seqs.get(blk[1])
+        if old is None or blk[4] >= old[4]:
+            seqs[blk[1]] = blk
+    return boots
+
+
+def runs(seqs):
+    """Consecutive sequence ranges [(first, last), ...] of a sorted list."""
+    out = []
+    for s in seqs:
+        if out and s == out[-1][1] + 1:
+            out[-1][1] = s
+        else:
+            out.append([s, s])
+    return out
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("source", help="log file, card image or block device")
+    ap.add_argument("--boot", type=int, help="cold boot to export (default: the newest)")
+    ap.add_argument("--list", action="store_true", help="list the boots found and exit")
+    ap.add_argument("--raw", metavar="FILE", help="also write the recovered frame stream")
+    args = ap.parse_args()
+
+    with open(args.source, "rb") as f:
+        size = os.fstat(f.fileno()).st_size or f.seek(0, os.SEEK_END)
+        data = mmap.mmap(f.fileno(), size, access=mmap.ACCESS_READ)
+        boots = collect(data)
+
+    if not boots:
+        sys.exit("no log blocks found")
+
+    if args.list:
+        sys.stdout.write("boot,schema,blocks,first_seq,last_seq,gaps,t_first_ms,t_last_ms\n")
+        for boot in sorted(boots):
+            seqs = sorted(boots[boot])
+            first, last = boots[boot][seqs[0]], boots[boot][seqs[-1]]
+            sys.stdout.write("%d,%d,%d,%d,%d,%d,%d,%d\n" % (
+                boot, first[2], len(seqs), seqs[0], seqs[-1], len(runs(seqs)) - 1, first[3], last[4]))
+        return
+
+    boot = args.boot if args.boot is not None else max(boots)
+    if boot not in boots:
+        sys.exit("boot %d not found" % boot)
+    blocks = boots[boot]
+    seqs = sorted(blocks)
+    schema = blocks[seqs[0]][2]
+    if schema != fdr_frames.SCHEMA:
+        sys.exit("boot %d uses schema %d, this tool decodes schema %d" % (boot, schema, fdr_frames.SCHEMA))
+
+    # Missing blocks become a delimiter so the frame decoder resyncs
+    stream = bytearray()
+    prev = None
+    for s in seqs:
+        if prev is not None and s != prev + 1:
+            stream.append(0)
+        stream += blocks[s][5]
+        prev = s
+    if args.raw:
+        with open(args.raw, "wb") as f:
+            f.write(stream)
+
+    stats = {}
+    bad, lost = fdr_frames.decode(io.BytesIO(bytes(stream)), sys.stdout, stats=stats)
+    ranges = runs(seqs)
+    longest = max(ranges, key=lambda r: r[1] - r[0])
+    sys.stderr.write("boot %d: %d blocks in %d run(s), longest %d-%d; bad frames: %d, lost frames: %d\n" % (
+        boot, len(seqs), len(ranges), longest[0], longest[1], bad, lost))
+    sys.stderr.write(fdr_frames.zip_summary(stats))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,254 @@
+/**
+ * @file fdr_ricebench.c
+ * @brief Host harness for the live sample coder (lib/rice)
+ * @author Nate Hunter
+ * @date 2025-08-14
+ * @version v1.0.0
+ *
+ * Codes SAMPLE records with the channel table of main.cpp and the key rule
+ * of CompressSample(): a sample that starts a new 488-byte block payload is
+ * a key. Only sample frames are counted, so on the board, where events and
+ * reports share the blocks, keys come a little more often.
+ *
+ * Input is either the CSV of fdr_recover.py / fdr_frames.py (SAMPLE lines,
+ * everything else is skipped) or a synthetic flight: 5 s on the pad, a 2 s
+ * boost, then coast and fall, with sensor noise.
+ *
+ * Reports the coded/raw byte ratio and the encode time per sample on the
+ * host, in ns and, on x86, time stamp counter cycles. The host time says nothing about the ATmega328P; there the
+ * PROF_COMPRESS region (PROF_ENABLE builds, `s` command) gives the cycles.
+ * With -x every record and its code go to stdout as hex, for
+ * fdr_ricecheck.py to decode with the Python decoder.
+ *
+ *   cc -O2 -Ilib/hal/host -Ilib/rice/src tools/fdr_ricebench.c lib/rice/src/rice.c -o ricebench
+ *   tools/fdr_recover.py FDR00003.BIN | ./ricebench
+ *   ./ricebench -s 30 -x | tools/fdr_ricecheck.py
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "rice.h"
+#include <avr/pgmspace.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_TSC 1              ///< Time stamp counter available
+#endif
+
+#define BENCH_PAYLOAD   488      ///< LOGBLK_PAYLOAD
+#define BENCH_RATE_HZ   100      ///< Synthetic sample rate
+#define BENCH_MAX       65536    ///< Most records per run
+#define BENCH_REPEAT_NS 200000000ULL   ///< Time the coder for at least 0.2 s
+
+/** @brief SAMPLE payload, "<IhIiii3h3hB" in tools/fdr_frames.py */
+typedef struct __attribute__((packed)) {
+  uint32_t timestamp;
+  int16_t temperature;
+  uint32_t pressure;
+  int32_t altitude;
+  int32_t kfAltitude;
+  int32_t kfVelocity;
+  int16_t accel[3];
+  int16_t gyro[3];
+  uint8_t phase;
+} SampleRecord;
+
+/* Same as sampleChannels in main.cpp */
+static const RICE_Channel sampleChannels[] PROGMEM = {
+  { offsetof(SampleRecord, timestamp),   RICE_T32, 6 },
+  { offsetof(SampleRecord, temperature), RICE_I16, 1 },
+  { offsetof(SampleRecord, pressure),    RICE_U32, 3 },
+  { offsetof(SampleRecord, altitude),    RICE_I32, 4 },
+  { offsetof(SampleRecord, kfAltitude),  RICE_I32, 3 },
+  { offsetof(SampleRecord, kfVelocity),  RICE_I32, 3 },
+  { offsetof(SampleRecord, accel[0]),    RICE_I16, 5 },
+  { offsetof(SampleRecord, accel[1]),    RICE_I16, 5 },
+  { offsetof(SampleRecord, accel[2]),    RICE_I16, 5 },
+  { offsetof(SampleRecord, gyro[0]),     RICE_I16, 4 },
+  { offsetof(SampleRecord, gyro[1]),     RICE_I16, 4 },
+  { offsetof(SampleRecord, gyro[2]),     RICE_I16, 4 },
+  { offsetof(SampleRecord, phase),       RICE_U8,  0 },
+};
+
+static const char *const phaseNames[] = { "IDLE", "BOOST", "COAST", "APOGEE", "DESCENT", "LANDED" };
+
+static SampleRecord records[BENCH_MAX];
+
+/* Private helpers */
+
+static uint64_t NowNs(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/** @brief Sum of 12 uniforms: roughly Gaussian noise of deviation @p sd */
+static double Noise(double sd)
+{
+  double u = 0;
+  for (uint8_t i = 0; i < 12; i++)
+    u += rand() / (double)RAND_MAX;
+  return (u - 6.0) * sd;
+}
+
+static size_t Synthesize(uint32_t seconds)
+{
+  size_t n = (size_t)seconds * BENCH_RATE_HZ;
+  double alt = 0, vel = 0;
+  uint32_t t = 0xFFF00000UL;     // Wraps during the run
+
+  if (n > BENCH_MAX)
+    n = BENCH_MAX;
+  srand(1);
+  for (size_t i = 0; i < n; i++) {
+    SampleRecord *s = &records[i];
+    double tt = (double)i / BENCH_RATE_HZ;
+    double acc = tt > 5 && tt < 7 ? 150.0 : (tt >= 7 ? -9.8 : 0.0);
+    double shake = acc > 100 ? 1.0 : 0.0;
+
+    vel += acc / BENCH_RATE_HZ;
+    alt += vel / BENCH_RATE_HZ;
+    if (alt < 0)
+      alt = vel = 0;
+
+    t += 1000000UL / BENCH_RATE_HZ + (int32_t)Noise(20);
+    s->timestamp = t;
+    s->temperature = (int16_t)(2150 + Noise(2));
+    s->pressure = (uint32_t)(101325 - alt * 12 + Noise(3));
+    s->altitude = (int32_t)(alt * 100 + Noise(30));
+    s->kfAltitude = (int32_t)(alt * 100 + Noise(3));
+    s->kfVelocity = (int32_t)(vel * 100 + Noise(3));
+    s->accel[0] = (int16_t)Noise(8);
+    s->accel[1] = (int16_t)Noise(8);
+    s->accel[2] = (int16_t)((acc + 9.8) / 9.8 * 2048 + Noise(10 + 200 * shake));
+    s->gyro[0] = (int16_t)Noise(6);
+    s->gyro[1] = (int16_t)Noise(6);
+    s->gyro[2] = (int16_t)Noise(6 + 80 * shake);
+    s->phase = tt < 5 ? 0 : (tt < 7 ? 1 : 2);
+  }
+  return n;
+}
+
+static size_t ReadCsv(FILE *in)
+{
+  char line[256], phase[16];
+  size_t n = 0;
+
+  while (n < BENCH_MAX && fgets(line, sizeof(line), in)) {
+    SampleRecord *s = &records[n];
+    unsigned long t, p;
+    long alt, ka, kv;
+    int temp, a[3], g[3];
+    if (strncmp(line, "SAMPLE,", 7) ||
+        sscanf(line + 7, "%*u,%lu,%d,%lu,%ld,%ld,%ld,%d,%d,%d,%d,%d,%d,%15[^,\r\n]",
+               &t, &temp, &p, &alt, &ka, &kv, &a[0], &a[1], &a[2],
+               &g[0], &g[1], &g[2], phase) != 13)
+      continue;
+    s->timestamp = (uint32_t)t;
+    s->temperature = (int16_t)temp;
+    s->pressure = (uint32_t)p;
+    s->altitude = (int32_t)alt;
+    s->kfAltitude = (int32_t)ka;
+    s->kfVelocity = (int32_t)kv;
+    for (uint8_t i = 0; i < 3; i++) {
+      s->accel[i] = (int16_t)a[i];
+      s->gyro[i] = (int16_t)g[i];
+    }
+    s->phase = (uint8_t)atoi(phase);
+    for (uint8_t i = 0; i < sizeof(phaseNames) / sizeof(phaseNames[0]); i++) {
+      if (!strcmp(phase, phaseNames[i]))
+        s->phase = i;
+    }
+    n++;
+  }
+  return n;
+}
+
+/**
+ * @brief Code every record once, as CompressSample() would
+ * @return Keys
+ */
+static size_t EncodeAll(RICE_Handle *rz, size_t n, uint8_t dump)
+{
+  uint8_t out[sizeof(SampleRecord)];
+  uint32_t used = 0, block = 0;
+  size_t keys = 0;
+
+  RICE_Init(rz, sampleChannels, sizeof(sampleChannels) / sizeof(sampleChannels[0]),
+            sizeof(SampleRecord));
+  for (size_t i = 0; i < n; i++) {
+    if (used / BENCH_PAYLOAD != block)
+      RICE_Reset(rz);
+    block = used / BENCH_PAYLOAD;
+
+    uint8_t len = RICE_Encode(rz, &records[i], out);
+    keys += !len;
+
+    // type, sequence, payload, CRC; COBS adds one byte here, plus the delimiter
+    used += 3 + (len ? len + 1U : (uint32_t)sizeof(SampleRecord)) + 2 + 2;
+
+    if (dump) {
+      for (uint8_t j = 0; j < sizeof(SampleRecord); j++)
+        printf("%02x", ((const uint8_t *)&records[i])[j]);
+      putchar(' ');
+      for (uint8_t j = 0; j < len; j++)
+        printf("%02x", out[j]);
+      putchar('\n');
+    }
+  }
+  return keys;
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t seconds = 0;
+  uint8_t dump = 0;
+  size_t n;
+
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-x")) {
+      dump = 1;
+    } else if (!strcmp(argv[i], "-s") && i + 1 < argc) {
+      seconds = (uint32_t)strtoul(argv[++i], NULL, 10);
+    } else {
+      fprintf(stderr, "usage: %s [-s seconds] [-x] < flight.csv\n", argv[0]);
+      return 2;
+    }
+  }
+
+  n = seconds ? Synthesize(seconds) : ReadCsv(stdin);
+  if (!n) {
+    fprintf(stderr, "no SAMPLE records\n");
+    return 1;
+  }
+
+  RICE_Handle rz;
+  size_t keys = EncodeAll(&rz, n, dump);
+  uint32_t raw = rz.rawBytes, coded = rz.codedBytes;
+
+  // Encode time: repeat the whole run until the clock has something to say
+  uint64_t runs = 0, start = NowNs(), elapsed;
+#ifdef BENCH_TSC
+  uint64_t tsc = __rdtsc();
+#endif
+  do {
+    EncodeAll(&rz, n, 0);
+    runs++;
+    elapsed = NowNs() - start;
+  } while (elapsed < BENCH_REPEAT_NS);
+
+  fprintf(stderr, "samples: %zu (%zu keys), bytes: %u coded / %u raw = %.1f%%\n",
+          n, keys, coded, raw, 100.0 * coded / raw);
+  fprintf(stderr, "host encode: %.1f ns/sample (%llu runs)\n",
+          (double)elapsed / ((double)runs * n), (unsigned long long)runs);
+#ifdef BENCH_TSC
+  fprintf(stderr, "host encode: %.0f TSC cycles/sample\n",
+          (double)(__rdtsc() - tsc) / ((double)runs * n));
+#endif
+  return 0;
+}
@@ -0,0 +1,34 @@
+#!/usr/bin/env python3
+"""Check lib/rice against the Python decoder with fdr_ricebench output.
+
+Reads the `record code` hex lines of `fdr_ricebench -x`, decodes every code
+with fdr_frames.RiceDecoder and compares it with the record; a line without
+a code is a key. Exits 1 on the first mismatch.
+
+    ./ricebench -s 30 -x | tools/fdr_ricecheck.py
+"""
+
+import sys
+
+import fdr_frames
+
+
+def main():
+    rice = fdr_frames.RiceDecoder(fdr_frames.SAMPLE_CHANNELS)
+    keys = deltas = 0
+    for n, line in enumerate(sys.stdin, 1):
+        record, _, code = line.strip().partition(" ")
+        record = bytes.fromhex(record)
+        if not code:
+            rice.key(record)
+            keys += 1
+            continue
+        if rice.decode(bytes.fromhex(code)) != record:
+            sys.stderr.write("line %d: decoded record differs\n" % n)
+            sys.exit(1)
+        deltas += 1
+    print("%d keys, %d deltas decoded exactly" % (keys, deltas))
+
+
+if __name__ == "__main__":
+    main()